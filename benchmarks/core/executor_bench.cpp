@@ -0,0 +1,111 @@
+#include <arpa/inet.h>
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "server.hpp"
+
+using namespace core;
+using namespace http;
+
+namespace {
+
+/**
+ * Sends one request over a fresh loopback connection and reads the response
+ * until the server closes the connection.
+ */
+void roundTrip(int port, const std::string &rawRequest) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<std::uint16_t>(port));
+  inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ==
+      0) {
+    send(fd, rawRequest.data(), rawRequest.size(), 0);
+    shutdown(fd, SHUT_WR);
+    char buffer[4096];
+    while (recv(fd, buffer, sizeof(buffer), 0) > 0) {
+    }
+  }
+  close(fd);
+}
+
+/**
+ * Measures the latency of a cheap route while background clients keep an
+ * expensive (5 ms) route saturated. With offload enabled the expensive route
+ * is registered as blocking and runs on the executor.
+ */
+void BM_FastRouteUnderSlowLoad(benchmark::State &state, bool offload) {
+  App app;
+  auto slowHandler = [](const Request &) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return Response(200, "OK", "slow", {{"Content-Type", "text/plain"}});
+  };
+  if (offload) {
+    app.registerBlockingRoute("GET", "/slow", slowHandler);
+  } else {
+    app.registerRoute("GET", "/slow", slowHandler);
+  }
+  app.registerRoute("GET", "/fast", [](const Request &) {
+    return Response(200, "OK", "fast", {{"Content-Type", "text/plain"}});
+  });
+
+  ServerOptions options;
+  options.workerThreads = 4;
+  Server server(app, options);
+  server.listen("127.0.0.1", 0);
+  std::thread serverThread([&server] { server.run(); });
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> load;
+  for (int i = 0; i < 4; ++i) {
+    load.emplace_back([&server, &done] {
+      while (!done.load()) {
+        roundTrip(server.getPort(), "GET /slow HTTP/1.1\r\n\r\n");
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  std::vector<double> latencies;
+  for (auto _ : state) {
+    auto started = std::chrono::steady_clock::now();
+    roundTrip(server.getPort(), "GET /fast HTTP/1.1\r\n\r\n");
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - started)
+                            .count());
+  }
+
+  done.store(true);
+  for (auto &thread : load) {
+    thread.join();
+  }
+  server.stop();
+  serverThread.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["p50_us"] = latencies[latencies.size() / 2];
+  state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_FastRouteUnderSlowLoad, inline, false)
+    ->Iterations(200)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_FastRouteUnderSlowLoad, executor, true)
+    ->Iterations(200)
+    ->UseRealTime();
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <string>
+
+#include "function.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "route.hpp"
+
+using namespace core;
+
+namespace {
+
+/**
+ * A handler capturing as much as typical route lambdas do: a couple of
+ * references into the application.
+ */
+auto makeHandler(const std::string &body, const int &status) {
+  return [&body, &status](const http::Request &) {
+    return http::Response(status, "OK", body, {});
+  };
+}
+
+template <typename Wrapper>
+void runCall(benchmark::State &state) {
+  std::string body = "Hello";
+  int status = 200;
+  Wrapper handler = makeHandler(body, status);
+  http::Request request("GET", "/", "HTTP/1.1", "", {});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handler(request));
+  }
+}
+
+void BM_StdFunctionCall(benchmark::State &state) {
+  runCall<std::function<http::Response(const http::Request &)>>(state);
+}
+BENCHMARK(BM_StdFunctionCall);
+
+void BM_FunctionCall(benchmark::State &state) {
+  runCall<Function<http::Response(const http::Request &)>>(state);
+}
+BENCHMARK(BM_FunctionCall);
+
+/**
+ * What fetching a route's handler used to cost: a copy of the std::function,
+ * with the closure copied along.
+ */
+void BM_StdFunctionCopy(benchmark::State &state) {
+  std::string body = "Hello";
+  int status = 200;
+  std::function<http::Response(const http::Request &)> handler =
+      [&body, &status, padding = std::string(32, 'x')](
+          const http::Request &) {
+        return http::Response(status, "OK", body, {});
+      };
+  for (auto _ : state) {
+    auto copy = handler;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_StdFunctionCopy);
+
+void BM_RouteGetHandler(benchmark::State &state) {
+  std::string body = "Hello";
+  int status = 200;
+  router::Route route("GET", "/", [&body, &status,
+                                   padding = std::string(32, 'x')](
+                                      const http::Request &) {
+    return http::Response(status, "OK", body, {});
+  });
+  for (auto _ : state) {
+    const router::Handler &handler = route.getHandler();
+    benchmark::DoNotOptimize(&handler);
+  }
+}
+BENCHMARK(BM_RouteGetHandler);
+
+}  // namespace
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "app.hpp"
+#include "kernel.hpp"
+#include "middleware.hpp"
+#include "request.hpp"
+#include "response.hpp"
+
+using namespace core;
+
+namespace {
+
+http::Response handler(const http::Request &) {
+  return http::Response(204, "No Content", "", {});
+}
+
+/**
+ * A layer doing no work of its own, so that the benchmarks measure the cost
+ * of the chain itself.
+ */
+http::Response passThrough(const http::Request &request, Next next) {
+  return next(request);
+}
+
+/**
+ * Composed at startup: each layer's Next points straight at the next layer.
+ */
+void BM_PipelineLayers(benchmark::State &state) {
+  auto layers = static_cast<std::size_t>(state.range(0));
+  std::vector<Middleware> middleware;
+  for (std::size_t i = 0; i < layers; ++i) {
+    middleware.emplace_back(passThrough);
+  }
+  Pipeline pipeline(std::move(middleware), handler);
+  http::Request request("GET", "/", "HTTP/1.1", "", {});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pipeline(request));
+  }
+  state.counters["layers"] = static_cast<double>(layers);
+}
+BENCHMARK(BM_PipelineLayers)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+/**
+ * A routed request through the kernel, with half the layers global and half
+ * the route's own, all composed into the route's chain.
+ */
+void BM_RouteLayers(benchmark::State &state) {
+  auto layers = static_cast<std::size_t>(state.range(0));
+  App app;
+  std::vector<Middleware> own;
+  for (std::size_t i = 0; i < layers; ++i) {
+    if (i % 2 == 0) {
+      app.use(passThrough);
+    } else {
+      own.emplace_back(passThrough);
+    }
+  }
+  app.registerRoute("GET", "/", std::move(own), handler);
+  Kernel kernel(app);
+  http::Request request("GET", "/", "HTTP/1.1", "", {});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernel.handleRequest(request));
+  }
+  state.counters["layers"] = static_cast<double>(layers);
+}
+BENCHMARK(BM_RouteLayers)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+/**
+ * Rebuilt per request: each layer is wrapped around the next in a fresh
+ * std::function, which is what walking a vector of middleware naively does.
+ */
+void BM_NaiveLayers(benchmark::State &state) {
+  auto layers = static_cast<std::size_t>(state.range(0));
+  using Stage = std::function<http::Response(const http::Request &)>;
+  using Layer = std::function<http::Response(const http::Request &, Next)>;
+  std::vector<Layer> middleware(layers, passThrough);
+  Stage end = handler;
+  http::Request request("GET", "/", "HTTP/1.1", "", {});
+  for (auto _ : state) {
+    Stage next = end;
+    for (auto it = middleware.rbegin(); it != middleware.rend(); ++it) {
+      next = [&layer = *it, next](const http::Request &request) {
+        return layer(request, next);
+      };
+    }
+    benchmark::DoNotOptimize(next(request));
+  }
+  state.counters["layers"] = static_cast<double>(layers);
+}
+BENCHMARK(BM_NaiveLayers)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+/**
+ * Composed at compile time from generic layers, which the compiler can
+ * inline into one another.
+ */
+template <std::size_t Layers>
+auto nested() {
+  if constexpr (Layers == 0) {
+    return chain(handler);
+  } else {
+    return chain(
+        [](const http::Request &request, const auto &next) {
+          return next(request);
+        },
+        nested<Layers - 1>());
+  }
+}
+
+template <std::size_t Layers>
+void BM_ChainLayers(benchmark::State &state) {
+  Handler composed = nested<Layers>();
+  http::Request request("GET", "/", "HTTP/1.1", "", {});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(composed(request));
+  }
+  state.counters["layers"] = static_cast<double>(Layers);
+}
+BENCHMARK_TEMPLATE(BM_ChainLayers, 0);
+BENCHMARK_TEMPLATE(BM_ChainLayers, 1);
+BENCHMARK_TEMPLATE(BM_ChainLayers, 4);
+BENCHMARK_TEMPLATE(BM_ChainLayers, 8);
+BENCHMARK_TEMPLATE(BM_ChainLayers, 16);
+
+}  // namespace
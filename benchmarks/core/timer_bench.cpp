@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "timer.hpp"
+
+using namespace core;
+
+namespace {
+
+using Clock = TimerWheel::Clock;
+
+/**
+ * Random deadlines within the next minute, as idle and header timeouts of
+ * many connections would be.
+ */
+std::vector<Clock::duration> deadlines(std::size_t count) {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> milliseconds(1, 60000);
+  std::vector<Clock::duration> result;
+  for (std::size_t i = 0; i < count; ++i) {
+    result.push_back(std::chrono::milliseconds(milliseconds(random)));
+  }
+  return result;
+}
+
+/**
+ * Pushes back the deadline of one connection among many armed ones, as the
+ * reactor does whenever a connection makes progress.
+ */
+void BM_WheelRearm(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  Clock::time_point origin = Clock::now();
+  TimerWheel wheel(origin);
+  std::vector<Clock::duration> offsets = deadlines(count);
+  std::vector<std::unique_ptr<Timer>> timers;
+  for (std::size_t i = 0; i < count; ++i) {
+    timers.push_back(std::make_unique<Timer>());
+    wheel.arm(*timers[i], origin + offsets[i]);
+  }
+
+  std::size_t next = 0;
+  for (auto _ : state) {
+    wheel.arm(*timers[next], origin + offsets[(next + 1) % count]);
+    next = next + 1 == count ? 0 : next + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * The same pattern with deadlines in an ordered multimap, which is what a
+ * per-connection deadline set would otherwise use.
+ */
+void BM_MultimapRearm(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  Clock::time_point origin = Clock::now();
+  std::multimap<Clock::time_point, std::size_t> timers;
+  std::vector<Clock::duration> offsets = deadlines(count);
+  std::vector<std::multimap<Clock::time_point, std::size_t>::iterator> handles;
+  for (std::size_t i = 0; i < count; ++i) {
+    handles.push_back(timers.emplace(origin + offsets[i], i));
+  }
+
+  std::size_t next = 0;
+  for (auto _ : state) {
+    timers.erase(handles[next]);
+    handles[next] = timers.emplace(origin + offsets[(next + 1) % count], next);
+    next = next + 1 == count ? 0 : next + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Arms a timer and cancels it again, as a request answered before its
+ * deadline does.
+ */
+void BM_WheelArmCancel(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  Clock::time_point origin = Clock::now();
+  TimerWheel wheel(origin);
+  std::vector<Clock::duration> offsets = deadlines(count);
+  std::vector<std::unique_ptr<Timer>> timers;
+  for (std::size_t i = 0; i < count; ++i) {
+    timers.push_back(std::make_unique<Timer>());
+    wheel.arm(*timers[i], origin + offsets[i]);
+  }
+
+  Timer timer;
+  std::size_t next = 0;
+  for (auto _ : state) {
+    wheel.arm(timer, origin + offsets[next]);
+    wheel.cancel(timer);
+    next = next + 1 == count ? 0 : next + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Advances the clock through a minute of deadlines in 1 ms steps, firing
+ * every timer. Items are timers fired.
+ */
+void BM_WheelExpireAll(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  std::vector<Clock::duration> offsets = deadlines(count);
+  std::uint64_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Clock::time_point origin = Clock::now();
+    auto wheel = std::make_unique<TimerWheel>(origin);
+    std::vector<std::unique_ptr<Timer>> timers;
+    for (std::size_t i = 0; i < count; ++i) {
+      timers.push_back(std::make_unique<Timer>([&fired] { ++fired; }));
+      wheel->arm(*timers[i], origin + offsets[i]);
+    }
+    state.ResumeTiming();
+
+    for (auto now = std::chrono::milliseconds(0);
+         now <= std::chrono::seconds(60); now += std::chrono::milliseconds(1)) {
+      wheel->advance(origin + now);
+    }
+
+    state.PauseTiming();
+    wheel.reset();
+    timers.clear();
+    state.ResumeTiming();
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(static_cast<std::int64_t>(fired));
+}
+
+}  // namespace
+
+BENCHMARK(BM_WheelRearm)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_MultimapRearm)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_WheelArmCancel)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_WheelExpireAll)->Arg(100000)->Unit(benchmark::kMillisecond);
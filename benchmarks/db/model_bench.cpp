@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "connection.hpp"
+#include "model.hpp"
+#include "temporary_directory.hpp"
+
+namespace {
+
+struct User {
+  std::int64_t id;
+  std::string name;
+  int age;
+};
+
+struct UserView {
+  std::int64_t id;
+  std::string_view name;
+  int age;
+};
+
+}  // namespace
+
+template <>
+struct db::Schema<User> {
+  static constexpr const char *table = "users";
+  static constexpr auto fields =
+      std::make_tuple(db::field("id", &User::id),
+                      db::field("name", &User::name),
+                      db::field("age", &User::age));
+};
+
+template <>
+struct db::Schema<UserView> {
+  static constexpr const char *table = "users";
+  static constexpr auto fields =
+      std::make_tuple(db::field("id", &UserView::id),
+                      db::field("name", &UserView::name),
+                      db::field("age", &UserView::age));
+};
+
+using namespace db;
+
+namespace {
+
+/**
+ * A fresh database file per benchmark, removed afterwards, so that commits
+ * pay for syncing to disk as they would in production.
+ */
+class Database {
+ public:
+  Database() {
+    connection =
+        std::make_unique<Connection>(directory.getPath() + "/bench.db");
+  }
+
+  Connection &get() { return *connection; }
+
+ private:
+  // Declared first, so the connection is closed before it is removed
+  TemporaryDirectory directory{"ember-model-bench"};
+  std::unique_ptr<Connection> connection;
+};
+
+std::vector<User> makeUsers(std::size_t count) {
+  std::vector<User> users;
+  for (std::size_t i = 0; i < count; ++i) {
+    users.push_back({0, "user" + std::to_string(i), static_cast<int>(i % 90)});
+  }
+  return users;
+}
+
+/**
+ * One statement and one commit per row.
+ */
+void BM_InsertEach(benchmark::State &state) {
+  Database database;
+  std::vector<User> users = makeUsers(state.range(0));
+  for (auto _ : state) {
+    for (User &user : users) {
+      Model<User>::insert(database.get(), user);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+BENCHMARK(BM_InsertEach)->Arg(100);
+
+/**
+ * One reused statement and one commit per batch.
+ */
+void BM_InsertMany(benchmark::State &state) {
+  Database database;
+  std::vector<User> users = makeUsers(state.range(0));
+  for (auto _ : state) {
+    Model<User>::insertMany(database.get(), users);
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+BENCHMARK(BM_InsertMany)->Arg(100)->Arg(1000)->Arg(10000);
+
+void BM_UpdateMany(benchmark::State &state) {
+  Database database;
+  std::vector<User> users = makeUsers(state.range(0));
+  Model<User>::insertMany(database.get(), users);
+  for (auto _ : state) {
+    for (User &user : users) {
+      ++user.age;
+    }
+    Model<User>::updateMany(database.get(), users);
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+BENCHMARK(BM_UpdateMany)->Arg(1000)->Arg(10000);
+
+/**
+ * Reads every row into owning structs.
+ */
+void BM_SelectAll(benchmark::State &state) {
+  Database database;
+  std::vector<User> users = makeUsers(state.range(0));
+  Model<User>::insertMany(database.get(), users);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Model<User>::all(database.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+BENCHMARK(BM_SelectAll)->Arg(10000);
+
+/**
+ * Streams every row through one struct viewing the statement's text.
+ */
+void BM_EachView(benchmark::State &state) {
+  Database database;
+  std::vector<User> users = makeUsers(state.range(0));
+  Model<User>::insertMany(database.get(), users);
+  static const Query everything = Model<UserView>::query();
+  for (auto _ : state) {
+    std::size_t length = 0;
+    Model<UserView>::each(database.get(), everything,
+                          [&length](const UserView &user) {
+                            length += user.name.size();
+                          });
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+BENCHMARK(BM_EachView)->Arg(10000);
+
+}  // namespace
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "connection.hpp"
+#include "pool.hpp"
+#include "temporary_directory.hpp"
+
+using namespace db;
+
+namespace {
+
+constexpr int kRows = 10000;
+
+/**
+ * A database file with one indexed table, created once for every benchmark
+ * in this file and removed when the process exits.
+ */
+const std::string &databasePath() {
+  static const TemporaryDirectory directory("ember-pool-bench");
+  static const std::string path = [] {
+    std::string file = directory.getPath() + "/bench.db";
+    Pool pool(file, 1);
+    pool.write()->execute(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT);"
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+        "WHERE i < 10000) INSERT INTO users SELECT i, 'user' || i FROM n;");
+    return file;
+  }();
+  return path;
+}
+
+/**
+ * Looks one user up by primary key, as a typical read handler would.
+ */
+void lookup(sqlite3 *db, int id) {
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(db, "SELECT name FROM users WHERE id = ?", -1, &statement,
+                     nullptr);
+  sqlite3_bind_int(statement, 1, id);
+  if (sqlite3_step(statement) == SQLITE_ROW) {
+    benchmark::DoNotOptimize(sqlite3_column_text(statement, 0));
+  }
+  sqlite3_finalize(statement);
+}
+
+/**
+ * Every thread leases a reader from the pool for each lookup.
+ */
+void BM_PoolRead(benchmark::State &state) {
+  static Pool pool(databasePath());
+  int id = state.thread_index() * 997;
+  for (auto _ : state) {
+    Pool::Lease lease = pool.read();
+    lookup(lease.get_db(), id % kRows + 1);
+    ++id;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PoolRead)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * Every thread shares one connection behind a mutex, which serializes the
+ * lookups.
+ */
+void BM_SharedConnectionRead(benchmark::State &state) {
+  static Connection connection(databasePath());
+  static std::mutex mutex;
+  int id = state.thread_index() * 997;
+  for (auto _ : state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    lookup(connection.get_db(), id % kRows + 1);
+    ++id;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedConnectionRead)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
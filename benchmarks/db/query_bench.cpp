@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "connection.hpp"
+#include "query.hpp"
+#include "statement.hpp"
+
+using namespace db;
+
+namespace {
+
+constexpr int kRows = 10000;
+
+void populate(Connection &connection) {
+  connection.execute(
+      "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, age INTEGER);"
+      "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+      "WHERE i < 10000) INSERT INTO users SELECT i, 'user' || i, i % 90 "
+      "FROM n;");
+}
+
+/**
+ * Formats the value into the SQL, so every request has new SQL text to
+ * compile and nothing can be cached.
+ */
+void BM_FormattedSql(benchmark::State &state) {
+  Connection connection(":memory:");
+  populate(connection);
+  int id = 0;
+  for (auto _ : state) {
+    std::string sql = "SELECT name, age FROM users WHERE id = " +
+                      std::to_string(id++ % kRows + 1);
+    Statement statement = connection.prepare(sql);
+    if (statement.step()) {
+      benchmark::DoNotOptimize(statement.getText(0));
+    }
+  }
+  state.counters["hit_rate"] = connection.getCacheStats().hitRate();
+}
+BENCHMARK(BM_FormattedSql);
+
+/**
+ * Rebuilds the query shape per request; the statement is cached, but the
+ * SQL text is assembled again every time.
+ */
+void BM_QueryPerRequest(benchmark::State &state) {
+  Connection connection(":memory:");
+  populate(connection);
+  int id = 0;
+  for (auto _ : state) {
+    Statement statement = Query::select("users", {"name", "age"})
+                              .where("id")
+                              .prepare(connection, id++ % kRows + 1);
+    if (statement.step()) {
+      benchmark::DoNotOptimize(statement.getText(0));
+    }
+  }
+}
+BENCHMARK(BM_QueryPerRequest);
+
+/**
+ * Builds the shape once per call site and only binds per request.
+ */
+void BM_QueryPerCallSite(benchmark::State &state) {
+  Connection connection(":memory:");
+  populate(connection);
+  static const Query byId = Query::select("users", {"name", "age"}).where("id");
+  int id = 0;
+  for (auto _ : state) {
+    Statement statement = byId.prepare(connection, id++ % kRows + 1);
+    if (statement.step()) {
+      benchmark::DoNotOptimize(statement.getText(0));
+    }
+  }
+}
+BENCHMARK(BM_QueryPerCallSite);
+
+}  // namespace
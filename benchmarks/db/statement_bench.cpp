@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+
+#include "connection.hpp"
+#include "statement.hpp"
+
+using namespace db;
+
+namespace {
+
+constexpr int kRows = 10000;
+
+/**
+ * An in-memory table of users, so that the benchmarks measure statement
+ * handling rather than I/O.
+ */
+void populate(Connection &connection) {
+  connection.execute(
+      "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, age INTEGER);"
+      "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+      "WHERE i < 10000) INSERT INTO users SELECT i, 'user' || i, i % 90 "
+      "FROM n;");
+}
+
+constexpr const char *kLookup = "SELECT name, age FROM users WHERE id = ?";
+
+/**
+ * Compiles the lookup on every call, as sqlite3_exec() does.
+ */
+void BM_PrepareEachTime(benchmark::State &state) {
+  Connection connection(":memory:");
+  populate(connection);
+  int id = 0;
+  for (auto _ : state) {
+    sqlite3_stmt *statement = nullptr;
+    sqlite3_prepare_v2(connection.get_db(), kLookup, -1, &statement, nullptr);
+    sqlite3_bind_int(statement, 1, id++ % kRows + 1);
+    if (sqlite3_step(statement) == SQLITE_ROW) {
+      benchmark::DoNotOptimize(sqlite3_column_text(statement, 0));
+      benchmark::DoNotOptimize(sqlite3_column_int64(statement, 1));
+    }
+    sqlite3_finalize(statement);
+  }
+}
+BENCHMARK(BM_PrepareEachTime);
+
+/**
+ * Takes the lookup from the connection's statement cache.
+ */
+void BM_CachedStatement(benchmark::State &state) {
+  Connection connection(":memory:");
+  populate(connection);
+  int id = 0;
+  for (auto _ : state) {
+    Statement statement = connection.prepare(kLookup);
+    statement.bind(1, id++ % kRows + 1);
+    if (statement.step()) {
+      benchmark::DoNotOptimize(statement.getText(0));
+      benchmark::DoNotOptimize(statement.getInt(1));
+    }
+  }
+  state.counters["hit_rate"] = connection.getCacheStats().hitRate();
+}
+BENCHMARK(BM_CachedStatement);
+
+}  // namespace
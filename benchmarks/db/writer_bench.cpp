@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "connection.hpp"
+#include "statement.hpp"
+#include "temporary_directory.hpp"
+#include "writer.hpp"
+
+using namespace db;
+
+namespace {
+
+/**
+ * A fresh database file per benchmark, synced on every commit as WAL mode
+ * does by default, and removed afterwards.
+ */
+class Database {
+ public:
+  Database() {
+    connection =
+        std::make_unique<Connection>(directory.getPath() + "/bench.db");
+  }
+
+  Connection &get() { return *connection; }
+
+ private:
+  // Declared first, so the connection is closed before it is removed
+  TemporaryDirectory directory{"ember-writer-bench"};
+  std::unique_ptr<Connection> connection;
+};
+
+std::int64_t insertEvent(Connection &connection) {
+  connection.prepare("INSERT INTO events (payload) VALUES (?)")
+      .bind(1, std::string_view("{\"type\":\"click\"}"))
+      .execute();
+  return sqlite3_last_insert_rowid(connection.get_db());
+}
+
+/**
+ * The latency of every write, from the moment a handler starts it until it
+ * is committed, recorded per thread and merged into percentiles.
+ */
+class Latencies {
+ public:
+  /**
+   * Sizes one list per thread; called by thread 0 before the others start.
+   */
+  void reset(std::size_t threads) { samples.assign(threads, {}); }
+
+  /**
+   * Times one write on the calling thread.
+   */
+  template <typename Write>
+  void record(benchmark::State &state, Write &&write) {
+    auto start = std::chrono::steady_clock::now();
+    write();
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    samples[state.thread_index()].push_back(elapsed.count());
+  }
+
+  /**
+   * Reports the median and 99th percentile in microseconds; called by
+   * thread 0 once every thread has left the loop.
+   */
+  void report(benchmark::State &state) {
+    std::vector<double> merged;
+    for (const std::vector<double> &thread : samples) {
+      merged.insert(merged.end(), thread.begin(), thread.end());
+    }
+    if (merged.empty()) {
+      return;
+    }
+    state.counters["p50_us"] = percentile(merged, 0.50);
+    state.counters["p99_us"] = percentile(merged, 0.99);
+  }
+
+ private:
+  std::vector<std::vector<double>> samples;  ///< Microseconds, per thread.
+
+  static double percentile(std::vector<double> &values, double rank) {
+    auto nth = values.begin() +
+               static_cast<std::ptrdiff_t>(rank * (values.size() - 1));
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+  }
+};
+
+Database *database = nullptr;
+Writer *writer = nullptr;
+std::mutex connectionMutex;
+Latencies latencies;
+
+/**
+ * Every handler thread commits its own write, sharing the connection behind
+ * a mutex. The percentiles include the wait for the mutex.
+ */
+void BM_AutocommitWrites(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    database = new Database();
+    latencies.reset(state.threads());
+  }
+  for (auto _ : state) {
+    latencies.record(state, [] {
+      std::lock_guard<std::mutex> lock(connectionMutex);
+      benchmark::DoNotOptimize(insertEvent(database->get()));
+    });
+  }
+  if (state.thread_index() == 0) {
+    latencies.report(state);
+    delete database;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AutocommitWrites)->ThreadRange(1, 32)->UseRealTime();
+
+/**
+ * Every handler thread submits its write to a Writer and waits for it to
+ * commit. The argument is the batching window in microseconds; the
+ * percentiles are the time from submit() until the future is ready, which
+ * is the latency the window adds to each write.
+ */
+void BM_GroupCommitWrites(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    database = new Database();
+    WriterOptions options;
+    options.maxDelay = std::chrono::microseconds(state.range(0));
+    writer = new Writer(database->get(), options);
+    latencies.reset(state.threads());
+  }
+  for (auto _ : state) {
+    latencies.record(state, [] {
+      benchmark::DoNotOptimize(writer->submit(insertEvent).get());
+    });
+  }
+  if (state.thread_index() == 0) {
+    latencies.report(state);
+    state.counters["writes_per_batch"] =
+        static_cast<double>(writer->getWriteCount()) /
+        static_cast<double>(writer->getBatchCount());
+    delete writer;
+    delete database;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GroupCommitWrites)
+    ->Arg(0)
+    ->Arg(500)
+    ->Arg(2000)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "headers.hpp"
+
+using namespace http;
+
+namespace {
+
+/**
+ * The header fields of a typical browser request.
+ */
+const std::vector<std::pair<std::string, std::string>> &browserFields() {
+  static const std::vector<std::pair<std::string, std::string>> fields = {
+      {"Host", "shop.example.com"},
+      {"User-Agent",
+       "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like "
+       "Gecko) Chrome/120.0.0.0 Safari/537.36"},
+      {"Accept",
+       "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+      {"Accept-Language", "en-US,en;q=0.9"},
+      {"Accept-Encoding", "gzip, deflate, br"},
+      {"Referer", "https://shop.example.com/cart"},
+      {"Connection", "keep-alive"},
+      {"Cookie", "session=8f14e45fceea167a5a36dedd4bea2543; theme=dark"},
+      {"Sec-Fetch-Dest", "document"},
+      {"Sec-Fetch-Mode", "navigate"},
+      {"Sec-Fetch-Site", "same-origin"},
+      {"traceparent",
+       "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"},
+      {"Content-Type", "application/x-www-form-urlencoded"},
+      {"Content-Length", "27"},
+  };
+  return fields;
+}
+
+void BM_MapBuildAndLookup(benchmark::State &state) {
+  const auto &fields = browserFields();
+  for (auto _ : state) {
+    std::map<std::string, std::string> headers;
+    for (const auto &field : fields) {
+      headers[field.first] = field.second;
+    }
+    benchmark::DoNotOptimize(headers.find("Host"));
+    benchmark::DoNotOptimize(headers.find("Content-Length"));
+    benchmark::DoNotOptimize(headers.find("Connection"));
+  }
+}
+BENCHMARK(BM_MapBuildAndLookup);
+
+void BM_HeadersBuildAndLookup(benchmark::State &state) {
+  const auto &fields = browserFields();
+  for (auto _ : state) {
+    Headers headers;
+    headers.reserve(1024);
+    for (const auto &field : fields) {
+      headers.set(field.first, field.second);
+    }
+    benchmark::DoNotOptimize(headers.get(Headers::Known::Host));
+    benchmark::DoNotOptimize(headers.get(Headers::Known::ContentLength));
+    benchmark::DoNotOptimize(headers.get("connection"));
+  }
+}
+BENCHMARK(BM_HeadersBuildAndLookup);
+
+void BM_HeadersKnownLookup(benchmark::State &state) {
+  Headers headers;
+  for (const auto &field : browserFields()) {
+    headers.set(field.first, field.second);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(headers.get(Headers::Known::ContentLength));
+  }
+}
+BENCHMARK(BM_HeadersKnownLookup);
+
+void BM_HeadersNameLookup(benchmark::State &state) {
+  Headers headers;
+  for (const auto &field : browserFields()) {
+    headers.set(field.first, field.second);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(headers.get("traceparent"));
+  }
+}
+BENCHMARK(BM_HeadersNameLookup);
+
+}  // namespace
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "request.hpp"
+
+using namespace http;
+
+namespace {
+
+const char *const kNames[] = {"q", "page", "sort", "lang", "per_page"};
+
+/**
+ * A search request with a handful of query parameters.
+ */
+Request searchRequest() {
+  return Request("GET",
+                 "/search?q=red+running+shoes&page=2&sort=price%3Aasc&lang=en"
+                 "&per_page=50&ref=homepage",
+                 "HTTP/1.1", "", {});
+}
+
+/**
+ * The previous lookup: split the query and build a map on every call.
+ */
+std::string splitEveryTime(const Request &request, const std::string &key) {
+  std::map<std::string, std::string> queryParams;
+  const std::string &uri = request.getUri();
+  auto pos = uri.find('?');
+  if (pos != std::string::npos) {
+    std::istringstream queryStream(uri.substr(pos + 1));
+    std::string pair;
+    while (std::getline(queryStream, pair, '&')) {
+      auto equalsPos = pair.find('=');
+      if (equalsPos != std::string::npos) {
+        queryParams[pair.substr(0, equalsPos)] = pair.substr(equalsPos + 1);
+      }
+    }
+  }
+  auto it = queryParams.find(key);
+  return it != queryParams.end() ? it->second : "";
+}
+
+/**
+ * A handler reading five query parameters, parsing the query each time.
+ */
+void BM_QueryLookupsSplitEveryTime(benchmark::State &state) {
+  Request request = searchRequest();
+  for (auto _ : state) {
+    for (const char *name : kNames) {
+      benchmark::DoNotOptimize(splitEveryTime(request, name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryLookupsSplitEveryTime);
+
+/**
+ * The same handler on the cached parameters. Each iteration starts from a
+ * fresh request, so the one parse is included.
+ */
+void BM_QueryLookupsCached(benchmark::State &state) {
+  Request request = searchRequest();
+  const std::string uri = request.getUri();
+  for (auto _ : state) {
+    request.setUri(uri);
+    for (const char *name : kNames) {
+      benchmark::DoNotOptimize(request.getQuery().get(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryLookupsCached);
+
+}  // namespace
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "parser.hpp"
+#include "request.hpp"
+
+using namespace http;
+
+namespace {
+
+/**
+ * A request shaped like one a browser sends: a dozen headers, a cookie and
+ * a small form body.
+ */
+const std::string &browserRequest() {
+  static const std::string raw =
+      "POST /api/v1/orders?page=2 HTTP/1.1\r\n"
+      "Host: shop.example.com\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 "
+      "(KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+      "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,"
+      "image/avif,image/webp,*/*;q=0.8\r\n"
+      "Accept-Language: en-US,en;q=0.9\r\n"
+      "Accept-Encoding: gzip, deflate, br\r\n"
+      "Referer: https://shop.example.com/cart\r\n"
+      "Origin: https://shop.example.com\r\n"
+      "Connection: keep-alive\r\n"
+      "Cookie: session=8f14e45fceea167a5a36dedd4bea2543; theme=dark; "
+      "consent=1\r\n"
+      "Sec-Fetch-Dest: empty\r\n"
+      "Sec-Fetch-Mode: cors\r\n"
+      "Sec-Fetch-Site: same-origin\r\n"
+      "Content-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 27\r\n"
+      "\r\n"
+      "item=42&quantity=3&gift=no\n";
+  return raw;
+}
+
+void BM_Parser(benchmark::State &state) {
+  const std::string &raw = browserRequest();
+  Parser parser;
+  for (auto _ : state) {
+    parser.reset();
+    benchmark::DoNotOptimize(parser.parse(raw));
+    benchmark::DoNotOptimize(parser.getBody().data());
+  }
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+BENCHMARK(BM_Parser);
+
+void BM_ParserToRequest(benchmark::State &state) {
+  const std::string &raw = browserRequest();
+  Parser parser;
+  for (auto _ : state) {
+    parser.reset();
+    parser.parse(raw);
+    Request request;
+    parser.toRequest(request);
+    benchmark::DoNotOptimize(request);
+  }
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+BENCHMARK(BM_ParserToRequest);
+
+void BM_ParseRequest(benchmark::State &state) {
+  const std::string &raw = browserRequest();
+  for (auto _ : state) {
+    Request request;
+    request.parseRequest(raw);
+    benchmark::DoNotOptimize(request);
+  }
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+BENCHMARK(BM_ParseRequest);
+
+}  // namespace
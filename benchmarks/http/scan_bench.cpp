@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "parser.hpp"
+#include "response.hpp"
+#include "scan.hpp"
+
+using namespace http;
+
+namespace {
+
+/**
+ * Builds a browser-sized header block: the usual request headers plus a
+ * cookie and tracing headers padded so the whole block is about `size` bytes.
+ */
+std::string browserHeaders(std::size_t size) {
+  std::string head =
+      "GET /dashboard/orders?page=2 HTTP/1.1\r\n"
+      "Host: shop.example.com\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 "
+      "(KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+      "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,"
+      "image/avif,image/webp,*/*;q=0.8\r\n"
+      "Accept-Language: en-US,en;q=0.9\r\n"
+      "Accept-Encoding: gzip, deflate, br\r\n"
+      "Referer: https://shop.example.com/cart\r\n"
+      "traceparent: 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01\r\n"
+      "tracestate: vendor=t61rcWkgMzE,other=00f067aa0ba902b7\r\n"
+      "Connection: keep-alive\r\n";
+  std::string cookie = "Cookie: session=8f14e45fceea167a5a36dedd4bea2543";
+  for (int i = 0; head.size() + cookie.size() + 4 < size; ++i) {
+    cookie += "; pref" + std::to_string(i) + "=a1b2c3d4e5f6";
+  }
+  return head + cookie + "\r\n\r\n";
+}
+
+/**
+ * Counts the lines of a header block.
+ */
+void BM_ScanLines(benchmark::State &state) {
+  std::string text = browserHeaders(state.range(0));
+  for (auto _ : state) {
+    std::size_t lines = 0;
+    std::size_t position = 0;
+    while ((position = scan::findLineEnd(text, position)) !=
+           std::string_view::npos) {
+      ++lines;
+      ++position;
+    }
+    benchmark::DoNotOptimize(lines);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ScanLines)->Arg(1024)->Arg(4096);
+
+void BM_ParseBrowserHeaders(benchmark::State &state) {
+  std::string text = browserHeaders(state.range(0));
+  Parser parser;
+  for (auto _ : state) {
+    parser.reset();
+    benchmark::DoNotOptimize(parser.parse(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParseBrowserHeaders)->Arg(1024)->Arg(4096);
+
+void BM_ParseResponse(benchmark::State &state) {
+  std::string text = browserHeaders(state.range(0));
+  // Reuse the header block behind a status line
+  text.replace(0, text.find("\r\n"), "HTTP/1.1 200 OK");
+  for (auto _ : state) {
+    Response response;
+    response.parseResponse(text);
+    benchmark::DoNotOptimize(response);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParseResponse)->Arg(1024)->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "response.hpp"
+
+using namespace http;
+
+namespace {
+
+/**
+ * Builds a response the way a handler would, with a body of the given size.
+ */
+Response makeResponse(std::size_t size) {
+  Response response(200, "OK", std::string(size, 'x'),
+                    {{"Content-Type", "application/octet-stream"},
+                     {"Cache-Control", "no-cache"},
+                     {"Server", "ember"}});
+  response.setHeader("Content-Length", std::to_string(size));
+  response.setHeader("Connection", "keep-alive");
+  return response;
+}
+
+/**
+ * The old write path: one string holding a copy of the body.
+ */
+void BM_ToStringWrite(benchmark::State &state) {
+  Response response = makeResponse(state.range(0));
+  int fd = open("/dev/null", O_WRONLY);
+  for (auto _ : state) {
+    std::string output = response.toString();
+    benchmark::DoNotOptimize(::write(fd, output.data(), output.size()));
+  }
+  close(fd);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ToStringWrite)->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024)
+    ->Arg(8 * 1024 * 1024);
+
+/**
+ * The reactor's write path: a reused head buffer plus the body in place.
+ */
+void BM_SerializeHeadWritev(benchmark::State &state) {
+  Response response = makeResponse(state.range(0));
+  int fd = open("/dev/null", O_WRONLY);
+  std::string head;
+  for (auto _ : state) {
+    response.serializeHead(head);
+    const std::string &body = response.getBody();
+    iovec parts[2] = {{const_cast<char *>(head.data()), head.size()},
+                      {const_cast<char *>(body.data()), body.size()}};
+    benchmark::DoNotOptimize(writev(fd, parts, 2));
+  }
+  close(fd);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeHeadWritev)->Arg(1024)->Arg(64 * 1024)
+    ->Arg(1024 * 1024)->Arg(8 * 1024 * 1024);
+
+}  // namespace
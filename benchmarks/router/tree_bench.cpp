@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "request.hpp"
+#include "response.hpp"
+#include "route.hpp"
+#include "tree.hpp"
+
+using namespace http;
+using namespace router;
+
+namespace {
+
+Response emptyHandler(const Request &) { return Response(); }
+
+/**
+ * Builds a route table of the given size shaped like a typical REST API:
+ * a collection, a member and a nested collection route per resource.
+ */
+std::vector<Route> makeRoutes(std::size_t count) {
+  std::vector<Route> routes;
+  routes.reserve(count);
+  for (std::size_t i = 0; routes.size() < count; ++i) {
+    std::string resource = "/api/v1/resource" + std::to_string(i);
+    routes.emplace_back("GET", resource, emptyHandler);
+    routes.emplace_back("GET", resource + "/:id", emptyHandler);
+    routes.emplace_back("GET", resource + "/:id/items", emptyHandler);
+  }
+  while (routes.size() > count) {
+    routes.pop_back();
+  }
+  return routes;
+}
+
+Request lastRouteRequest(std::size_t count) {
+  return Request("GET",
+                 "/api/v1/resource" + std::to_string((count - 1) / 3) + "/42",
+                 "HTTP/1.1", "", {});
+}
+
+Request missingRouteRequest() {
+  return Request("GET", "/api/v1/missing/42", "HTTP/1.1", "", {});
+}
+
+void runVectorScan(benchmark::State &state, const Request &request) {
+  std::vector<Route> routes = makeRoutes(state.range(0));
+  for (auto _ : state) {
+    const Route *found = nullptr;
+    for (const auto &route : routes) {
+      if (route.matches(request)) {
+        found = &route;
+        break;
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+}
+
+void runTree(benchmark::State &state, const Request &request) {
+  std::vector<Route> routes = makeRoutes(state.range(0));
+  Tree tree;
+  for (std::size_t i = 0; i < routes.size(); ++i) {
+    tree.insert(routes[i].getMethodId(), routes[i].getPath(), i);
+  }
+  std::vector<std::string_view> captures;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tree.find(request.getMethodId(),
+                                       request.getPathView(), &captures));
+  }
+}
+
+void BM_VectorScanHit(benchmark::State &state) {
+  runVectorScan(state, lastRouteRequest(state.range(0)));
+}
+
+void BM_VectorScanMiss(benchmark::State &state) {
+  runVectorScan(state, missingRouteRequest());
+}
+
+void BM_TreeHit(benchmark::State &state) {
+  runTree(state, lastRouteRequest(state.range(0)));
+}
+
+void BM_TreeMiss(benchmark::State &state) {
+  runTree(state, missingRouteRequest());
+}
+
+}  // namespace
+
+BENCHMARK(BM_VectorScanHit)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(BM_VectorScanMiss)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(BM_TreeHit)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(BM_TreeMiss)->RangeMultiplier(10)->Range(10, 1000);
@@ -1,9 +1,12 @@
 #ifndef APP_HPP
 #define APP_HPP
 
-#include <functional>
+#include <cstddef>
+#include <deque>
 #include <string>
+#include <vector>
 
+#include "middleware.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "router.hpp"
@@ -18,8 +21,13 @@ namespace core {
  * @class App
  * @brief Represents the application and its routes.
  *
- * This class manages the registration of routes and delegates request handling
- * to the router.
+ * This class manages the registration of routes and middleware and delegates
+ * request handling to the router.
+ *
+ * Every route registered through the App is composed with the global
+ * middleware and its own into one Pipeline, so dispatching a request is a
+ * single call into its route's chain. Routes keep pointing into the App,
+ * which therefore cannot be copied or moved.
  */
 class App {
  public:
@@ -29,6 +37,9 @@ class App {
    */
   App();
 
+  App(const App &) = delete;
+  App &operator=(const App &) = delete;
+
   /**
    * @brief Registers a route with a corresponding handler.
    *
@@ -36,9 +47,75 @@ class App {
    * @param path The path for the route (e.g., /home).
    * @param handler The handler function for the route.
    */
-  void registerRoute(
-      const std::string &method, const std::string &path,
-      const std::function<http::Response(const http::Request &)> &handler);
+  void registerRoute(const std::string &method, const std::string &path,
+                     router::Handler handler);
+
+  /**
+   * @brief Registers a route with middleware of its own.
+   *
+   * The middleware and the handler are composed into one Pipeline here,
+   * once, inside the application's global middleware.
+   *
+   * @param method The HTTP method (e.g., GET, POST).
+   * @param path The path for the route (e.g., /home).
+   * @param middleware The route's middleware, outermost first.
+   * @param handler The handler function for the route.
+   */
+  void registerRoute(const std::string &method, const std::string &path,
+                     std::vector<Middleware> middleware,
+                     router::Handler handler);
+
+  /**
+   * @brief Registers a route whose handler may block (e.g., on database I/O).
+   *
+   * When the application is served by a Server, these handlers run on the
+   * server's worker threads so the I/O threads never stall on them.
+   *
+   * @param method The HTTP method (e.g., GET, POST).
+   * @param path The path for the route (e.g., /home).
+   * @param handler The handler function for the route.
+   */
+  void registerBlockingRoute(const std::string &method,
+                             const std::string &path,
+                             router::Handler handler);
+
+  /**
+   * @brief Serves the files below a directory under a URL prefix.
+   *
+   * `GET <prefix>/<path>` serves `<directory>/<path>`, and HEAD answers with
+   * the same headers alone. Files are sent with sendfile(2) when the
+   * application is served by a Server, and conditional and range requests
+   * are answered from the file's validators.
+   *
+   * @param prefix The URL prefix (e.g., /assets).
+   * @param directory The directory holding the files.
+   * @param cacheCapacity The maximum number of files kept open.
+   */
+  void registerStatic(const std::string &prefix, const std::string &directory,
+                      std::size_t cacheCapacity = 256);
+
+  /**
+   * @brief Adds a middleware that every request runs through.
+   *
+   * Global middleware wraps all routes registered through the App, whenever
+   * they were registered, as well as the 404 and 405 responses for unrouted
+   * requests: each route's chain is recomposed to include it. Routes added to
+   * the router directly are not wrapped. Middleware runs in the order it was
+   * added, outermost first, and must all be added before the application is
+   * served.
+   *
+   * @param middleware The middleware.
+   */
+  void use(Middleware middleware);
+
+  /**
+   * @brief Answers a request no route matched, through the global
+   * middleware.
+   *
+   * @param request The unrouted request.
+   * @return The response, by default from router::Router::fallback().
+   */
+  http::Response fallback(const http::Request &request) const;
 
   /**
    * @brief Get the Router object
@@ -56,6 +133,25 @@ class App {
 
  private:
   router::Router router;  ///< The router managing the routes.
+  std::deque<Middleware>
+      middleware;  ///< The global middleware, outermost first. A deque, so
+                   ///< that the pipelines' pointers to it stay valid.
+  std::deque<Pipeline> pipelines;  ///< The fallback's chain, then each
+                                   ///< route's, at stable addresses.
+
+  /**
+   * @brief Composes a route's middleware and handler inside the global
+   * middleware.
+   *
+   * @return A handler running the composed chain.
+   */
+  router::Handler compose(std::vector<Middleware> middleware,
+                          router::Handler handler);
+
+  /**
+   * @brief Lists the global middleware for Pipeline::wrap().
+   */
+  std::vector<const Middleware *> global() const;
 };
 
 }  // namespace core
@@ -1,7 +1,6 @@
 #ifndef COLLECTION_HPP
 #define COLLECTION_HPP
 
-#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -9,6 +8,7 @@
 #include "request.hpp"
 #include "response.hpp"
 #include "route.hpp"
+#include "tree.hpp"
 
 namespace router {
 
@@ -24,10 +24,11 @@ class Collection {
    * @param method The HTTP method (e.g., GET, POST) for the route.
    * @param path The URL path for the route.
    * @param handler The function to be executed when the route is matched.
+   * @param blocking True if the handler may block and should run on a worker
+   * thread when served by a Server.
    */
-  void addRoute(
-      const std::string &method, const std::string &path,
-      const std::function<http::Response(const http::Request &)> &handler);
+  void addRoute(const std::string &method, const std::string &path,
+                Handler handler, bool blocking = false);
 
   /**
    * Retrieves a route from the collection.
@@ -44,7 +45,9 @@ class Collection {
    * routes and executing the corresponding handler.
    *
    * @param request The incoming HTTP request to be handled.
-   * @return The HTTP response generated by the matched route's handler.
+   * @return The HTTP response generated by the matched route's handler, a 405
+   * Method Not Allowed response with an Allow header if only routes for other
+   * methods match the path, or a 404 Not Found response.
    */
   http::Response handleRequest(const http::Request &request) const;
 
@@ -59,6 +62,7 @@ class Collection {
  private:
   std::vector<Route>
       routes;  ///< A collection of all routes registered in the collection.
+  Tree tree;   ///< The radix tree indexing routes by method and path.
 };
 
 }  // namespace router
@@ -3,7 +3,15 @@
 
 #include <sqlite3.h>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "statement.hpp"
 
 /**
  * @namespace db
@@ -17,25 +25,99 @@ namespace db {
  * This class provides an abstraction over the sqlite3* handle, managing
  * the lifetime of the connection to the database. It allows for opening
  * and closing the database connection in a RAII manner.
+ *
+ * Each connection keeps a least-recently-used cache of prepared statements
+ * keyed by their SQL text, so running the same SQL again skips parsing and
+ * planning it. Like the connection itself, the cache is not thread-safe.
  */
 class Connection {
  public:
+  /**
+   * @brief Counters describing the statement cache.
+   */
+  struct CacheStats {
+    std::uint64_t hits = 0;       ///< prepare() calls served from the cache.
+    std::uint64_t misses = 0;     ///< prepare() calls that compiled the SQL.
+    std::uint64_t evictions = 0;  ///< Statements dropped to make room.
+    std::chrono::nanoseconds prepareTime{0};  ///< Time spent compiling SQL.
+
+    /**
+     * @brief Gets the share of prepare() calls served from the cache.
+     *
+     * @return The hit rate between 0 and 1, or 0 before any call.
+     */
+    double hitRate() const;
+  };
+
   /**
    * @brief Constructs a new Connection object and opens a connection to the
    * specified database.
    *
    * @param db_path The path to the database file.
+   * @param flags The sqlite3_open_v2() flags; by default the database is
+   * opened for reading and writing and created if missing.
    *
    * @throw std::runtime_error if the database connection fails to open.
    */
-  Connection(const std::string &db_path);
+  Connection(const std::string &db_path,
+             int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+  Connection(const Connection &) = delete;
+  Connection &operator=(const Connection &) = delete;
 
   /**
    * @brief Destroys the Connection object, ensuring the database connection is
-   * closed properly.
+   * closed properly. Every Statement prepared on it must have been destroyed.
    */
   ~Connection();
 
+  /**
+   * @brief Prepares a statement, reusing a cached one for the same SQL.
+   *
+   * If the cached statement for @p sql is still in use (e.g., by an outer
+   * loop over its rows), a separate one is compiled for this call and
+   * finalized when it is destroyed.
+   *
+   * @param sql A single SQL statement.
+   * @return The statement, with no values bound.
+   *
+   * @throw std::runtime_error if the SQL does not compile.
+   */
+  Statement prepare(std::string_view sql);
+
+  /**
+   * @brief Sets the number of prepared statements kept in the cache.
+   *
+   * Least recently used statements beyond the capacity are finalized, unless
+   * they are in use.
+   *
+   * @param capacity The maximum number of cached statements.
+   */
+  void setCacheCapacity(std::size_t capacity);
+
+  /**
+   * @brief Gets the number of prepared statements in the cache.
+   *
+   * @return The number of cached statements.
+   */
+  std::size_t getCacheSize() const;
+
+  /**
+   * @brief Gets the statement cache counters.
+   *
+   * @return The counters since the connection was opened.
+   */
+  const CacheStats &getCacheStats() const;
+
+  /**
+   * @brief Runs one or more SQL statements that return no rows.
+   *
+   * @param sql The statements.
+   *
+   * @throw std::runtime_error if a statement fails.
+   */
+  void execute(const std::string &sql);
+
   /**
    * @brief Gets the underlying sqlite3* database handle.
    *
@@ -48,6 +130,23 @@ class Connection {
    * @brief The sqlite3 database handle.
    */
   sqlite3 *db;
+
+  std::list<Statement::Entry>
+      cache;  ///< Cached statements, most recently used first.
+  std::unordered_map<std::string_view, std::list<Statement::Entry>::iterator>
+      index;                 ///< Cached statements by SQL text.
+  std::size_t capacity = 64;  ///< The maximum number of cached statements.
+  CacheStats stats;          ///< The cache counters.
+
+  /**
+   * @brief Compiles SQL into a new statement, timing it.
+   */
+  sqlite3_stmt *compile(std::string_view sql);
+
+  /**
+   * @brief Finalizes least recently used statements beyond the capacity.
+   */
+  void evict();
 };
 
 }  // namespace db
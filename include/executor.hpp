@@ -0,0 +1,102 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "function.hpp"
+
+namespace core {
+
+/**
+ * @class Executor
+ * @brief A work-stealing thread pool for handlers that may block.
+ *
+ * Every worker owns a deque. Tasks submitted from outside the pool, such as
+ * the requests reactors hand over, are spread over the deques round robin,
+ * and tasks a worker submits itself go on its own deque to stay on one core.
+ * A worker takes the oldest task from its own deque and, once that is empty,
+ * steals the oldest task from another worker, so a worker stuck in a slow
+ * handler does not hold up the requests queued behind it. Each deque is
+ * served oldest first, so when every worker is busy no request starves
+ * behind newer ones.
+ */
+class Executor {
+ public:
+  /**
+   * @brief A unit of work. Tasks must not throw.
+   *
+   * Tasks are moved through the queues, never copied, and those capturing a
+   * few words are stored without allocating.
+   */
+  using Task = Function<void()>;
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param threads The number of workers, at least one.
+   */
+  explicit Executor(std::size_t threads);
+
+  /**
+   * @brief Runs every queued task, then stops and joins the workers.
+   */
+  ~Executor();
+
+  Executor(const Executor &) = delete;
+  Executor &operator=(const Executor &) = delete;
+
+  /**
+   * @brief Queues a task for execution on a worker. Safe to call from any
+   * thread.
+   *
+   * @param task The task to run.
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Gets the number of worker threads.
+   *
+   * @return The number of workers.
+   */
+  std::size_t size() const;
+
+ private:
+  /**
+   * @brief The task deque owned by one worker.
+   */
+  struct Worker {
+    std::mutex mutex;        ///< Guards the deque.
+    std::deque<Task> tasks;  ///< Queued tasks, oldest at the front.
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;  ///< One deque per worker.
+  std::vector<std::thread> threads;              ///< The worker threads.
+  std::atomic<std::size_t> next;     ///< Round robin over the deques.
+  std::atomic<std::size_t> pending;  ///< Tasks queued but not yet taken.
+  std::mutex idleMutex;              ///< Guards sleeping and stopping.
+  std::condition_variable idle;      ///< Wakes sleeping workers.
+  bool stopping;                     ///< Set when the executor is destroyed.
+
+  /**
+   * @brief The loop run by each worker thread.
+   */
+  void work(std::size_t index);
+
+  /**
+   * @brief Takes a task from the worker's own deque, or steals one.
+   *
+   * @return True if a task was taken.
+   */
+  bool take(std::size_t index, Task &task);
+};
+
+}  // namespace core
+
+#endif  // EXECUTOR_HPP
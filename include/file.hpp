@@ -0,0 +1,208 @@
+#ifndef HTTP_FILE_HPP
+#define HTTP_FILE_HPP
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @class File
+ * @brief An open, regular file together with its validators.
+ *
+ * The descriptor stays open for the life of the object, so a response can be
+ * streamed from it with sendfile(2) long after the file was looked up. Files
+ * are shared through std::shared_ptr, which keeps the descriptor valid while
+ * any response still refers to it, even if the cache has dropped it.
+ */
+class File {
+ public:
+  /**
+   * @brief Opens a regular file for reading.
+   *
+   * @param path The path of the file.
+   * @return The file, or nullptr if it does not exist, cannot be read or is
+   * not a regular file.
+   */
+  static std::shared_ptr<const File> open(const std::string &path);
+
+  /**
+   * @brief Closes the descriptor.
+   */
+  ~File();
+
+  File(const File &) = delete;
+  File &operator=(const File &) = delete;
+
+  /**
+   * @brief Gets the open descriptor.
+   *
+   * @return The descriptor, opened read-only.
+   */
+  int getFd() const;
+
+  /**
+   * @brief Gets the size of the file when it was opened.
+   *
+   * @return The size in bytes.
+   */
+  std::size_t getSize() const;
+
+  /**
+   * @brief Gets the modification time of the file when it was opened.
+   *
+   * @return The time, in seconds since the epoch.
+   */
+  std::time_t getModified() const;
+
+  /**
+   * @brief Gets the entity tag, derived from the inode, size and mtime.
+   *
+   * @return The quoted ETag value.
+   */
+  const std::string &getETag() const;
+
+  /**
+   * @brief Gets the modification time formatted as an HTTP date.
+   *
+   * @return The Last-Modified value.
+   */
+  const std::string &getLastModified() const;
+
+  /**
+   * @brief Checks whether stat results still describe this file.
+   *
+   * @param status The result of a fresh stat() of the same path.
+   * @return True if the path still refers to the same, unmodified file.
+   */
+  bool isCurrent(const struct stat &status) const;
+
+ private:
+  /**
+   * @brief Takes ownership of an open descriptor.
+   */
+  File(int fd, const struct stat &status);
+
+  int fd;                    ///< The open descriptor.
+  struct stat status;        ///< The stat results at open time.
+  std::string etag;          ///< The ETag value.
+  std::string lastModified;  ///< The Last-Modified value.
+};
+
+/**
+ * @class FileCache
+ * @brief A thread-safe LRU cache of open files and their stat results.
+ *
+ * Serving a cached file costs no open() or fstat() call. Entries older than
+ * the revalidation interval are checked with a single stat() before being
+ * reused, and reopened if the file changed on disk.
+ *
+ * Every reactor shares the cache, so it is split by path into shards with a
+ * lock and an LRU order each, and no lock is ever held across a system call:
+ * stat() and open() run unlocked, so a slow filesystem only stalls the
+ * lookups that touch it. Small caches have a single shard and an exact LRU
+ * order.
+ */
+class FileCache {
+ public:
+  /**
+   * @brief Constructs an empty cache.
+   *
+   * @param capacity The maximum number of open files kept.
+   * @param revalidateAfter How long an entry is trusted without a stat().
+   */
+  FileCache(std::size_t capacity = 256,
+            std::chrono::milliseconds revalidateAfter =
+                std::chrono::seconds(1));
+
+  /**
+   * @brief Gets an open file, opening and caching it if needed.
+   *
+   * @param path The path of the file.
+   * @return The file, or nullptr if it cannot be served.
+   */
+  std::shared_ptr<const File> get(const std::string &path);
+
+  /**
+   * @brief Gets the number of cached files.
+   *
+   * @return The number of entries.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Gets the number of lookups served from the cache.
+   *
+   * @return The hit count.
+   */
+  std::size_t getHits() const;
+
+  /**
+   * @brief Gets the number of lookups that had to open the file.
+   *
+   * @return The miss count.
+   */
+  std::size_t getMisses() const;
+
+ private:
+  /**
+   * @brief A cached file, in recency order.
+   */
+  struct Entry {
+    std::string path;                   ///< The key.
+    std::shared_ptr<const File> file;   ///< The open file.
+    std::chrono::steady_clock::time_point
+        checked;  ///< When the file was last known to be current.
+  };
+
+  /**
+   * @brief The entries whose paths hash to one shard.
+   */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;  ///< Guards the entries and index.
+    std::list<Entry> entries;  ///< Most recently used first.
+    std::unordered_map<std::string, std::list<Entry>::iterator>
+        index;  ///< The entries by path.
+  };
+
+  static constexpr std::size_t kMaxShards = 16;  ///< The most shards used.
+  static constexpr std::size_t kMinShardCapacity =
+      16;  ///< The fewest entries a shard is split down to.
+
+  std::size_t shardCapacity;                  ///< The entry count per shard.
+  std::chrono::milliseconds revalidateAfter;  ///< The trust interval.
+  std::vector<Shard> shards;        ///< A power-of-two number of shards.
+  std::atomic<std::size_t> hits;    ///< Lookups served from the cache.
+  std::atomic<std::size_t> misses;  ///< Lookups that opened the file.
+
+  /**
+   * @brief Picks the shard holding a path.
+   */
+  Shard &shardFor(const std::string &path);
+
+  /**
+   * @brief Replaces a path's entry with a freshly opened file, or drops it
+   * if the file could not be opened.
+   */
+  void store(Shard &shard, const std::string &path,
+             const std::shared_ptr<const File> &file,
+             std::chrono::steady_clock::time_point now);
+};
+
+}  // namespace http
+
+#endif  // HTTP_FILE_HPP
@@ -0,0 +1,194 @@
+#ifndef FUNCTION_HPP
+#define FUNCTION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+template <typename Signature, std::size_t Capacity = 48>
+class Function;
+
+/**
+ * @class Function
+ * @brief A move-only callable wrapper with an inline buffer.
+ *
+ * Like std::function, but never copies the callable: it is moved in once and
+ * moved along with the wrapper after that. Callables of up to Capacity bytes
+ * that are nothrow-movable, which covers lambdas capturing a few pointers or
+ * references, live inside the wrapper; larger ones are allocated once, when
+ * the wrapper is built. Calling the wrapper never allocates and costs one
+ * indirect call either way.
+ *
+ * @tparam R The return type.
+ * @tparam Args The argument types.
+ * @tparam Capacity The size of the inline buffer, in bytes.
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class Function<R(Args...), Capacity> {
+ public:
+  /**
+   * @brief Builds an empty wrapper.
+   */
+  Function() noexcept = default;
+
+  /**
+   * @brief Builds an empty wrapper.
+   */
+  Function(std::nullptr_t) noexcept {}
+
+  /**
+   * @brief Wraps a callable.
+   *
+   * @param callable The callable, moved into the wrapper. A null function
+   * pointer leaves the wrapper empty.
+   */
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, Function> &&
+                std::is_invocable_r_v<R, std::decay_t<Callable> &, Args...>>>
+  Function(Callable &&callable) {
+    using Stored = std::decay_t<Callable>;
+    // A function passed by reference decays to a pointer that is never null
+    if constexpr (std::is_pointer_v<std::remove_reference_t<Callable>> ||
+                  std::is_member_pointer_v<std::remove_reference_t<Callable>>) {
+      if (!callable) {
+        return;
+      }
+    }
+    if constexpr (storesInline<Stored>()) {
+      ::new (static_cast<void *>(storage)) Stored(
+          std::forward<Callable>(callable));
+      invoker = &invokeInline<Stored>;
+      manager = &manageInline<Stored>;
+    } else {
+      *reinterpret_cast<Stored **>(storage) =
+          new Stored(std::forward<Callable>(callable));
+      invoker = &invokeHeap<Stored>;
+      manager = &manageHeap<Stored>;
+    }
+  }
+
+  Function(const Function &) = delete;
+  Function &operator=(const Function &) = delete;
+
+  /**
+   * @brief Takes over the callable of another wrapper, leaving it empty.
+   */
+  Function(Function &&other) noexcept { take(other); }
+
+  /**
+   * @brief Replaces the callable with that of another wrapper, leaving it
+   * empty.
+   */
+  Function &operator=(Function &&other) noexcept {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  ~Function() { reset(); }
+
+  /**
+   * @brief Calls the wrapped callable.
+   *
+   * @throw std::bad_function_call if the wrapper is empty.
+   */
+  R operator()(Args... args) const {
+    if (!invoker) {
+      throw std::bad_function_call();
+    }
+    return invoker(const_cast<unsigned char *>(storage),
+                   std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Checks whether the wrapper holds a callable.
+   */
+  explicit operator bool() const noexcept { return invoker != nullptr; }
+
+  /**
+   * @brief Checks whether a callable type is stored in the inline buffer.
+   *
+   * @tparam Callable The callable type.
+   * @return True if wrapping it does not allocate.
+   */
+  template <typename Callable>
+  static constexpr bool storesInline() {
+    return sizeof(Callable) <= Capacity &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Callable>;
+  }
+
+ private:
+  /**
+   * @brief What a manager is asked to do.
+   */
+  enum class Operation { Move, Destroy };
+
+  using Invoker = R (*)(void *, Args &&...);
+  using Manager = void (*)(Operation, void *, void *) noexcept;
+
+  alignas(std::max_align_t) unsigned char storage[Capacity];  ///< The buffer.
+  Invoker invoker = nullptr;  ///< Calls the callable; null when empty.
+  Manager manager = nullptr;  ///< Moves and destroys the callable.
+
+  template <typename Stored>
+  static R invokeInline(void *storage, Args &&...args) {
+    return std::invoke(*static_cast<Stored *>(storage),
+                       std::forward<Args>(args)...);
+  }
+
+  template <typename Stored>
+  static R invokeHeap(void *storage, Args &&...args) {
+    return std::invoke(**static_cast<Stored **>(storage),
+                       std::forward<Args>(args)...);
+  }
+
+  template <typename Stored>
+  static void manageInline(Operation operation, void *from,
+                           void *to) noexcept {
+    Stored *callable = static_cast<Stored *>(from);
+    if (operation == Operation::Move) {
+      ::new (to) Stored(std::move(*callable));
+    }
+    callable->~Stored();
+  }
+
+  template <typename Stored>
+  static void manageHeap(Operation operation, void *from, void *to) noexcept {
+    Stored **callable = static_cast<Stored **>(from);
+    if (operation == Operation::Move) {
+      *static_cast<Stored **>(to) = *callable;
+    } else {
+      delete *callable;
+    }
+  }
+
+  void take(Function &other) noexcept {
+    if (other.manager) {
+      other.manager(Operation::Move, other.storage, storage);
+    }
+    invoker = other.invoker;
+    manager = other.manager;
+    other.invoker = nullptr;
+    other.manager = nullptr;
+  }
+
+  void reset() noexcept {
+    if (manager) {
+      manager(Operation::Destroy, storage, nullptr);
+    }
+    invoker = nullptr;
+    manager = nullptr;
+  }
+};
+
+}  // namespace core
+
+#endif  // FUNCTION_HPP
@@ -0,0 +1,295 @@
+#ifndef HTTP_HEADERS_HPP
+#define HTTP_HEADERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @class Headers
+ * @brief A compact, case-insensitive collection of HTTP header fields.
+ *
+ * All names and values are stored back to back in one arena string, and each
+ * field is a small record of offsets into it. The first records live inline in
+ * the object, so a typical request costs a single allocation for the arena
+ * rather than a tree node and two strings per header. Fields keep the order
+ * they were added in.
+ *
+ * Names are compared case-insensitively. Well-known headers are additionally
+ * indexed by their Known id, so looking them up does not scan the fields.
+ *
+ * The arena and any spilled records come from a std::pmr memory resource,
+ * usually a per-request arena. Copies always use the default resource, so a
+ * copy may safely outlive the arena; moves keep the source's resource.
+ */
+class Headers {
+ public:
+  /**
+   * @brief Header names with a dedicated O(1) lookup slot.
+   */
+  enum class Known : std::uint8_t {
+    Accept,
+    AcceptEncoding,
+    Allow,
+    CacheControl,
+    Connection,
+    ContentLength,
+    ContentType,
+    Cookie,
+    Date,
+    ETag,
+    Host,
+    IfModifiedSince,
+    IfNoneMatch,
+    KeepAlive,
+    LastModified,
+    Location,
+    Range,
+    Server,
+    TransferEncoding,
+    UserAgent,
+    Count  ///< The number of known headers; not a header.
+  };
+
+  /**
+   * @brief A header field as views into the collection.
+   *
+   * The views are invalidated by any change to the collection.
+   */
+  struct Field {
+    std::string_view name;   ///< The header name, as added.
+    std::string_view value;  ///< The header value.
+  };
+
+  /**
+   * @brief Forward iterator over the fields, in insertion order.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Field;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Field *;
+    using reference = Field;
+
+    Iterator(const Headers *headers, std::size_t index);
+    Field operator*() const;
+    Iterator &operator++();
+    bool operator==(const Iterator &other) const;
+    bool operator!=(const Iterator &other) const;
+
+   private:
+    const Headers *headers;  ///< The collection being iterated.
+    std::size_t index;       ///< The current field.
+  };
+
+  /**
+   * @brief Constructs an empty collection.
+   */
+  Headers();
+
+  /**
+   * @brief Constructs an empty collection allocating from a memory resource.
+   *
+   * @param resource The resource, which must outlive the collection.
+   */
+  explicit Headers(std::pmr::memory_resource *resource);
+
+  /**
+   * @brief Constructs a collection from a list of fields.
+   *
+   * Later fields replace earlier ones with the same name.
+   *
+   * @param fields The fields to add.
+   * @param resource The resource to allocate from.
+   */
+  Headers(std::initializer_list<Field> fields,
+          std::pmr::memory_resource *resource =
+              std::pmr::get_default_resource());
+
+  /**
+   * @brief Constructs a collection from a map of names to values.
+   *
+   * @param fields The fields to add.
+   */
+  Headers(const std::map<std::string, std::string> &fields);
+
+  /**
+   * @brief Gets the number of fields.
+   *
+   * @return The number of fields.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Checks whether the collection is empty.
+   *
+   * @return True if there are no fields.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Gets a field by position.
+   *
+   * @param index The position of the field, less than size().
+   * @return The field.
+   */
+  Field operator[](std::size_t index) const;
+
+  /**
+   * @brief Gets the value of a header, ignoring the case of its name.
+   *
+   * If the header was added more than once, the first value is returned.
+   *
+   * @param name The name of the header.
+   * @return The value, or an empty view if the header is not present.
+   */
+  std::string_view get(std::string_view name) const;
+
+  /**
+   * @brief Gets the value of a well-known header in constant time.
+   *
+   * @param name The header.
+   * @return The value, or an empty view if the header is not present.
+   */
+  std::string_view get(Known name) const;
+
+  /**
+   * @brief Checks whether a header is present, ignoring case.
+   *
+   * @param name The name of the header.
+   * @return True if the header is present.
+   */
+  bool has(std::string_view name) const;
+
+  /**
+   * @brief Checks whether a well-known header is present.
+   *
+   * @param name The header.
+   * @return True if the header is present.
+   */
+  bool has(Known name) const;
+
+  /**
+   * @brief Sets a header, replacing the value of an existing one.
+   *
+   * @param name The name of the header.
+   * @param value The value of the header.
+   */
+  void set(std::string_view name, std::string_view value);
+
+  /**
+   * @brief Appends a header, even if one with the same name exists.
+   *
+   * @param name The name of the header.
+   * @param value The value of the header.
+   */
+  void add(std::string_view name, std::string_view value);
+
+  /**
+   * @brief Removes every field with the given name.
+   *
+   * @param name The name of the header.
+   * @return True if a field was removed.
+   */
+  bool remove(std::string_view name);
+
+  /**
+   * @brief Removes all fields, keeping the allocated storage.
+   */
+  void clear();
+
+  /**
+   * @brief Reserves arena space for names and values.
+   *
+   * @param bytes The total size of the names and values expected.
+   */
+  void reserve(std::size_t bytes);
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  /**
+   * @brief Compares two collections field by field, in order.
+   */
+  bool operator==(const Headers &other) const;
+  bool operator!=(const Headers &other) const;
+
+  /**
+   * @brief Gets the memory resource the collection allocates from.
+   *
+   * @return The resource.
+   */
+  std::pmr::memory_resource *getResource() const;
+
+  /**
+   * @brief Maps a header name to its Known id.
+   *
+   * @param name The name of the header, in any case.
+   * @return The id, or Known::Count if the header is not well known.
+   */
+  static Known classify(std::string_view name);
+
+ private:
+  /**
+   * @brief A field as offsets into the arena.
+   */
+  struct Entry {
+    std::uint32_t nameOffset;   ///< The offset of the name.
+    std::uint32_t valueOffset;  ///< The offset of the value.
+    std::uint32_t valueLength;  ///< The length of the value.
+    std::uint32_t nameLength;   ///< The length of the name.
+    Known known;                ///< The Known id of the name.
+  };
+
+  static constexpr std::size_t kInlineCapacity = 16;  ///< Inline records.
+  static constexpr std::uint32_t kAbsent = 0;  ///< Empty known-index slot.
+
+  std::pmr::string arena;  ///< The names and values, back to back.
+  std::array<Entry, kInlineCapacity> inlineEntries;  ///< The first records.
+  std::pmr::vector<Entry> spilledEntries;  ///< Records past the inline ones.
+  std::size_t count;                       ///< The number of records.
+  std::array<std::uint32_t, static_cast<std::size_t>(Known::Count)>
+      knownIndex;  ///< Position + 1 of the first field of each known header.
+
+  Entry &entry(std::size_t index);
+  const Entry &entry(std::size_t index) const;
+
+  /**
+   * @brief Finds the first field with the given name.
+   *
+   * @return Its position, or size() if absent.
+   */
+  std::size_t find(std::string_view name, Known known) const;
+
+  /**
+   * @brief Appends bytes to the arena.
+   *
+   * @return The offset they were stored at.
+   */
+  std::uint32_t store(std::string_view text);
+
+  /**
+   * @brief Rebuilds the known-header index after fields moved.
+   */
+  void reindex();
+
+  std::string_view view(std::uint32_t offset, std::size_t length) const;
+};
+
+}  // namespace http
+
+#endif  // HTTP_HEADERS_HPP
@@ -4,6 +4,7 @@
 #include "app.hpp"
 #include "request.hpp"
 #include "response.hpp"
+#include "route.hpp"
 
 namespace core {
 
@@ -45,6 +46,35 @@ class Kernel {
    */
   http::Response handleRequest(const http::Request& request);
 
+  /**
+   * Finds the route that should handle an incoming HTTP request.
+   *
+   * Together with dispatch(), this splits handleRequest() in two so that a
+   * server can decide where to run the handler once the route is known.
+   *
+   * @param request The incoming HTTP request.
+   * @return The matching route, or nullptr if no route matches.
+   */
+  const router::Route* resolve(const http::Request& request) const;
+
+  /**
+   * Produces the HTTP response for a request routed by resolve().
+   *
+   * This method does not modify the Kernel and may be called concurrently
+   * from several threads.
+   *
+   * The request runs through the application's global middleware first,
+   * which may answer it without reaching the route.
+   *
+   * @param route The route returned by resolve(), or nullptr.
+   * @param request The incoming HTTP request.
+   * @return The handler's response, or if @p route is nullptr, a 405 Method
+   * Not Allowed response when the path has routes for other methods and a
+   * 404 Not Found response otherwise.
+   */
+  http::Response dispatch(const router::Route* route,
+                          const http::Request& request) const;
+
  private:
   const App& app;  ///< A constant reference to the App instance associated with
                    ///< this Kernel. This allows the Kernel to access
@@ -0,0 +1,76 @@
+#ifndef HTTP_METHOD_HPP
+#define HTTP_METHOD_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @brief The request methods routes can be registered for.
+ *
+ * Requests carry their method as one of these, interned once when the method
+ * is set, so that routing compares and filters methods as integers.
+ */
+enum class Method : std::uint8_t {
+  Get,
+  Head,
+  Post,
+  Put,
+  Delete,
+  Connect,
+  Options,
+  Trace,
+  Patch,
+  Count  ///< The number of methods; also stands for any other method.
+};
+
+/**
+ * @brief A set of methods, one bit per Method.
+ */
+using MethodSet = std::uint16_t;
+
+/**
+ * @brief Gets the bit standing for a method in a MethodSet.
+ *
+ * @param method The method.
+ * @return The bit, or 0 for Method::Count.
+ */
+constexpr MethodSet methodBit(Method method) {
+  return method == Method::Count
+             ? 0
+             : static_cast<MethodSet>(1u << static_cast<unsigned>(method));
+}
+
+/**
+ * @brief Interns a method name.
+ *
+ * @param name The name, matched case-insensitively.
+ * @return The method, or Method::Count if the name is not one of them.
+ */
+Method parseMethod(std::string_view name);
+
+/**
+ * @brief Gets the canonical, upper-case name of a method.
+ *
+ * @param method The method.
+ * @return The name, or an empty view for Method::Count.
+ */
+std::string_view methodName(Method method);
+
+/**
+ * @brief Formats a set of methods as the value of an Allow header.
+ *
+ * @param methods The set.
+ * @return The method names, comma-separated in Method order.
+ */
+std::string formatMethods(MethodSet methods);
+
+}  // namespace http
+
+#endif  // HTTP_METHOD_HPP
@@ -0,0 +1,246 @@
+#ifndef MIDDLEWARE_HPP
+#define MIDDLEWARE_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "function.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "route.hpp"
+
+namespace core {
+
+/**
+ * @class Next
+ * @brief The rest of a middleware chain, as passed to each middleware.
+ *
+ * A non-owning reference to whatever follows a middleware: the next one, or
+ * the handler at the end of the chain. It is two pointers wide and calling it
+ * is one indirect call, so passing it down a chain never allocates. A Next is
+ * only valid during the call it was passed to.
+ */
+class Next {
+ public:
+  /**
+   * @brief Refers to a callable taking a request and returning a response.
+   *
+   * @param callable The callable, which must outlive the Next.
+   */
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, Next> &&
+                !std::is_function_v<Callable>>>
+  Next(const Callable &callable) : call(&invoke<Callable>) {
+    target.object = &callable;
+  }
+
+  /**
+   * @brief Refers to a function taking a request and returning a response.
+   *
+   * @param function The function.
+   */
+  Next(http::Response (*function)(const http::Request &))
+      : call(&invokeFunction) {
+    target.function = function;
+  }
+
+  /**
+   * @brief Runs the rest of the chain.
+   *
+   * @param request The request to pass on.
+   * @return The response from further down the chain.
+   */
+  http::Response operator()(const http::Request &request) const {
+    return call(target, request);
+  }
+
+ private:
+  /**
+   * @brief What a Next refers to: an object, or a plain function, since
+   * function pointers do not convert to void pointers.
+   */
+  union Target {
+    const void *object;
+    http::Response (*function)(const http::Request &);
+  };
+
+  Target target;  ///< The referenced callable.
+  http::Response (*call)(Target,
+                         const http::Request &);  ///< Calls the target.
+
+  template <typename Callable>
+  static http::Response invoke(Target target, const http::Request &request) {
+    return (*static_cast<const Callable *>(target.object))(request);
+  }
+
+  static http::Response invokeFunction(Target target,
+                                       const http::Request &request) {
+    return target.function(request);
+  }
+};
+
+/**
+ * @brief A route handler.
+ */
+using Handler = router::Handler;
+
+/**
+ * @brief A middleware: runs around the rest of the chain, which it may call
+ * through its Next, or answer the request itself without calling it.
+ */
+using Middleware = Function<http::Response(const http::Request &, Next)>;
+
+/**
+ * @brief Collects middleware into a list, outermost first.
+ *
+ * Middleware is move-only, so a braced list cannot be copied into a vector;
+ * this moves each layer in instead.
+ *
+ * @param middleware The middleware.
+ * @return The list.
+ */
+template <typename... Layers>
+std::vector<Middleware> layers(Layers... middleware) {
+  std::vector<Middleware> list;
+  list.reserve(sizeof...(Layers));
+  (list.emplace_back(std::move(middleware)), ...);
+  return list;
+}
+
+/**
+ * @class Pipeline
+ * @brief A chain of middleware and a handler, composed once as it is built.
+ *
+ * Each layer is linked to the one after it when the pipeline is composed:
+ * the Next a middleware receives points straight at the next layer, or at
+ * the handler, so a request makes one call through a Next and one through a
+ * Function per layer and nothing is looked up, allocated or rebuilt on the
+ * way. Pipelines are built at startup and only run afterwards, which may
+ * happen from several threads at once.
+ */
+class Pipeline {
+ public:
+  /**
+   * @brief Builds a pipeline ending in a handler, usable as a route handler.
+   *
+   * @param middleware The middleware, outermost first.
+   * @param handler The handler at the end of the chain.
+   */
+  Pipeline(std::vector<Middleware> middleware, Handler handler);
+
+  Pipeline(const Pipeline &) = delete;
+  Pipeline &operator=(const Pipeline &) = delete;
+
+  /**
+   * @brief Takes over another pipeline's layers and handler.
+   */
+  Pipeline(Pipeline &&other) noexcept;
+
+  /**
+   * @brief Replaces the layers and handler with another pipeline's.
+   */
+  Pipeline &operator=(Pipeline &&other) noexcept;
+
+  /**
+   * @brief Appends a middleware, innermost so far, and recomposes the chain.
+   *
+   * @param middleware The middleware.
+   */
+  void use(Middleware middleware);
+
+  /**
+   * @brief Runs middleware owned elsewhere, such as an application's global
+   * middleware, in front of the pipeline's own, and recomposes the chain.
+   *
+   * @param outer The middleware, outermost first, replacing any set before.
+   * It must outlive the pipeline.
+   */
+  void wrap(std::vector<const Middleware *> outer);
+
+  /**
+   * @brief Runs a request through the middleware and the handler.
+   *
+   * @param request The request.
+   * @return The response.
+   */
+  http::Response operator()(const http::Request &request) const;
+
+  /**
+   * @brief Gets the number of middleware layers.
+   *
+   * @return The number of layers in front of the handler, outer ones
+   * included.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Checks whether the pipeline has no middleware.
+   *
+   * @return True if requests go straight to the handler.
+   */
+  bool empty() const;
+
+ private:
+  /**
+   * @brief One composed layer: a middleware and the Next it is passed.
+   */
+  struct Stage {
+    const Middleware *middleware;  ///< The middleware.
+    Next next;                     ///< The layer after it, or the handler.
+
+    http::Response operator()(const http::Request &request) const {
+      return (*middleware)(request, next);
+    }
+  };
+
+  std::vector<const Middleware *> outer;  ///< Layers owned elsewhere.
+  std::vector<Middleware> middleware;     ///< The pipeline's own layers.
+  Handler handler;                        ///< The handler at the end.
+  std::vector<Stage> stages;  ///< Every layer, innermost first; never grown
+                              ///< after composing, so Nexts stay valid.
+
+  /**
+   * @brief Rebuilds the stages, linking each layer to the next.
+   */
+  void compose();
+};
+
+/**
+ * @brief Composes a handler with no middleware; the end of chain().
+ *
+ * @param handler The handler.
+ * @return The handler itself.
+ */
+template <typename Callable>
+Callable chain(Callable handler) {
+  return handler;
+}
+
+/**
+ * @brief Composes middleware and a handler at compile time.
+ *
+ * Unlike a Pipeline, every layer is a distinct type, so the compiler sees the
+ * whole chain and can inline it. Middleware taking its next stage as a
+ * template parameter (e.g. a generic lambda with an `auto` parameter) calls
+ * straight into it; middleware taking a Next gets one indirect call.
+ *
+ * @param middleware The outermost middleware.
+ * @param rest The remaining middleware, outermost first, then the handler.
+ * @return A callable taking a request and returning a response, which can be
+ * registered as a route handler.
+ */
+template <typename First, typename Second, typename... Rest>
+auto chain(First middleware, Second second, Rest... rest) {
+  return [middleware = std::move(middleware),
+          next = chain(std::move(second), std::move(rest)...)](
+             const http::Request &request) -> http::Response {
+    return middleware(request, next);
+  };
+}
+
+}  // namespace core
+
+#endif  // MIDDLEWARE_HPP
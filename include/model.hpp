@@ -0,0 +1,430 @@
+#ifndef MODEL_HPP
+#define MODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "connection.hpp"
+#include "query.hpp"
+#include "statement.hpp"
+
+namespace db {
+
+/**
+ * @class Transaction
+ * @brief Runs statements as one transaction, rolled back unless committed.
+ *
+ * If the connection is already inside a transaction, this one joins it:
+ * nothing is begun, committed or rolled back, and the outer transaction
+ * decides.
+ */
+class Transaction {
+ public:
+  /**
+   * @brief Begins an immediate transaction, taking the write lock up front.
+   *
+   * @param connection The connection.
+   *
+   * @throw std::runtime_error if the transaction cannot begin.
+   */
+  explicit Transaction(Connection &connection);
+
+  /**
+   * @brief Rolls the transaction back if it was not committed.
+   */
+  ~Transaction();
+
+  Transaction(const Transaction &) = delete;
+  Transaction &operator=(const Transaction &) = delete;
+
+  /**
+   * @brief Commits the transaction.
+   *
+   * @throw std::runtime_error if the commit fails.
+   */
+  void commit();
+
+ private:
+  Connection &connection;  ///< The connection.
+  bool active;             ///< True while this transaction must finish.
+};
+
+/**
+ * @brief Describes one column of a model: its name and the member holding it.
+ */
+template <typename T, typename Member>
+struct Field {
+  using Type = Member;  ///< The member's type.
+
+  const char *name;     ///< The column name.
+  Member T::*member;    ///< The member holding the column's value.
+};
+
+/**
+ * @brief Describes a model field, for use in a Schema.
+ *
+ * @param name The column name.
+ * @param member The member holding the column's value.
+ * @return The field.
+ */
+template <typename T, typename Member>
+constexpr Field<T, Member> field(const char *name, Member T::*member) {
+  return Field<T, Member>{name, member};
+}
+
+/**
+ * @brief Maps a struct onto a table; specialize it for each model.
+ *
+ * A specialization names the table and lists the fields in column order,
+ * primary key first. The key must be an INTEGER PRIMARY KEY, which SQLite
+ * assigns on insert:
+ *
+ * @code
+ * struct User {
+ *   std::int64_t id;
+ *   std::string name;
+ *   int age;
+ * };
+ *
+ * template <>
+ * struct db::Schema<User> {
+ *   static constexpr const char *table = "users";
+ *   static constexpr auto fields =
+ *       std::make_tuple(db::field("id", &User::id),
+ *                       db::field("name", &User::name),
+ *                       db::field("age", &User::age));
+ * };
+ * @endcode
+ *
+ * Fields may be integers, bools, floating-point numbers, std::string, or
+ * std::string_view. A std::string_view field views the row it was read from,
+ * so it is only valid inside Model::each() callbacks, and models with one
+ * cannot be read with find(), select() or all().
+ */
+template <typename T>
+struct Schema;
+
+/**
+ * @class Model
+ * @brief Reads and writes structs described by a Schema.
+ *
+ * Everything about the mapping is resolved at compile time: columns are read
+ * and bound by index, in field order, straight into and out of members, with
+ * no names looked up per row. The SQL for each operation is built once and
+ * prepared from the connection's statement cache.
+ */
+template <typename T>
+class Model {
+ public:
+  /**
+   * @brief The number of fields, primary key included.
+   */
+  static constexpr std::size_t kFieldCount =
+      std::tuple_size_v<std::decay_t<decltype(Schema<T>::fields)>>;
+
+  static_assert(kFieldCount > 0, "a model needs at least its primary key");
+
+  /**
+   * @brief Starts a SELECT of every field, for narrowing with where(),
+   * orderBy() and limit() and passing to select() or each().
+   *
+   * @return The query.
+   */
+  static Query query() { return Query::select(Schema<T>::table, columns(0)); }
+
+  /**
+   * @brief Finds a row by primary key.
+   *
+   * @param connection The connection.
+   * @param key The primary key.
+   * @return The row, or nothing if there is none.
+   */
+  static std::optional<T> find(Connection &connection, std::int64_t key) {
+    static_assert(ownsFields(Indices()),
+                  "models with std::string_view fields can only be read with "
+                  "each(), since the views dangle once the statement moves on");
+    static const Query byKey = query().where(keyName());
+    Statement statement = byKey.prepare(connection, key);
+    if (!statement.step()) {
+      return std::nullopt;
+    }
+    T row{};
+    read(statement, row);
+    return row;
+  }
+
+  /**
+   * @brief Reads the rows a query selects.
+   *
+   * @param connection The connection.
+   * @param select A query from query(), narrowed as needed.
+   * @param values The query's values.
+   * @return The rows.
+   */
+  template <typename... Values>
+  static std::vector<T> select(Connection &connection, const Query &select,
+                               const Values &...values) {
+    static_assert(ownsFields(Indices()),
+                  "models with std::string_view fields can only be read with "
+                  "each(), since the views dangle once the statement moves on");
+    std::vector<T> rows;
+    Statement statement = select.prepare(connection, values...);
+    while (statement.step()) {
+      read(statement, rows.emplace_back());
+    }
+    return rows;
+  }
+
+  /**
+   * @brief Reads every row of the table.
+   *
+   * @param connection The connection.
+   * @return The rows.
+   */
+  static std::vector<T> all(Connection &connection) {
+    static_assert(ownsFields(Indices()),
+                  "models with std::string_view fields can only be read with "
+                  "each(), since the views dangle once the statement moves on");
+    static const Query everything = query();
+    return select(connection, everything);
+  }
+
+  /**
+   * @brief Streams the rows a query selects through a callback.
+   *
+   * One struct is reused for every row, and std::string_view fields view the
+   * statement's own copy of the text, so nothing is copied per row. The
+   * struct is only valid during the callback.
+   *
+   * @param connection The connection.
+   * @param select A query from query(), narrowed as needed.
+   * @param callback Called with each row as a `const T &`.
+   * @param values The query's values.
+   */
+  template <typename Callback, typename... Values>
+  static void each(Connection &connection, const Query &select,
+                   Callback &&callback, const Values &...values) {
+    Statement statement = select.prepare(connection, values...);
+    T row{};
+    while (statement.step()) {
+      read(statement, row);
+      callback(static_cast<const T &>(row));
+    }
+  }
+
+  /**
+   * @brief Inserts a row and sets its primary key to the one assigned.
+   *
+   * @param connection The connection.
+   * @param row The row; its primary key is ignored and overwritten.
+   */
+  static void insert(Connection &connection, T &row) {
+    Statement statement = connection.prepare(insertQuery().getSql());
+    insertOne(connection, statement, row);
+  }
+
+  /**
+   * @brief Inserts rows in one transaction through one statement, and sets
+   * their primary keys to the ones assigned.
+   *
+   * @param connection The connection.
+   * @param rows The rows; their primary keys are ignored and overwritten.
+   *
+   * @throw std::runtime_error if a row fails to insert, in which case none
+   * are inserted.
+   */
+  static void insertMany(Connection &connection, std::vector<T> &rows) {
+    Transaction transaction(connection);
+    Statement statement = connection.prepare(insertQuery().getSql());
+    for (T &row : rows) {
+      insertOne(connection, statement, row);
+    }
+    transaction.commit();
+  }
+
+  /**
+   * @brief Writes every field of a row but the primary key, by primary key.
+   *
+   * @param connection The connection.
+   * @param row The row.
+   * @return True if the row exists.
+   */
+  static bool update(Connection &connection, const T &row) {
+    Statement statement = connection.prepare(updateQuery().getSql());
+    return updateOne(connection, statement, row);
+  }
+
+  /**
+   * @brief Updates rows in one transaction through one statement.
+   *
+   * @param connection The connection.
+   * @param rows The rows.
+   * @return The number of rows that existed and were updated.
+   *
+   * @throw std::runtime_error if a row fails to update, in which case none
+   * are updated.
+   */
+  static std::size_t updateMany(Connection &connection,
+                                const std::vector<T> &rows) {
+    Transaction transaction(connection);
+    Statement statement = connection.prepare(updateQuery().getSql());
+    std::size_t updated = 0;
+    for (const T &row : rows) {
+      updated += updateOne(connection, statement, row);
+    }
+    transaction.commit();
+    return updated;
+  }
+
+  /**
+   * @brief Deletes a row by primary key.
+   *
+   * @param connection The connection.
+   * @param key The primary key.
+   * @return True if the row existed.
+   */
+  static bool remove(Connection &connection, std::int64_t key) {
+    static const Query byKey = Query::remove(Schema<T>::table).where(keyName());
+    return byKey.execute(connection, key) > 0;
+  }
+
+ private:
+  using Indices = std::make_index_sequence<kFieldCount>;
+
+  using Fields = std::decay_t<decltype(Schema<T>::fields)>;
+
+  static const char *keyName() { return std::get<0>(Schema<T>::fields).name; }
+
+  /**
+   * @brief Checks that no field views the row it was read from, so that
+   * rows stay valid after their statement moves on.
+   */
+  template <std::size_t... I>
+  static constexpr bool ownsFields(std::index_sequence<I...>) {
+    return (!std::is_same_v<typename std::tuple_element_t<I, Fields>::Type,
+                            std::string_view> &&
+            ...);
+  }
+
+  /**
+   * @brief Lists the column names from a field on.
+   */
+  static std::vector<std::string> columns(std::size_t first) {
+    std::vector<std::string> names;
+    std::apply(
+        [&names](const auto &...fields) {
+          (names.push_back(fields.name), ...);
+        },
+        Schema<T>::fields);
+    names.erase(names.begin(), names.begin() + first);
+    return names;
+  }
+
+  static const Query &insertQuery() {
+    static const Query insert = Query::insert(Schema<T>::table, columns(1));
+    return insert;
+  }
+
+  static const Query &updateQuery() {
+    static const Query update =
+        Query::update(Schema<T>::table, columns(1)).where(keyName());
+    return update;
+  }
+
+  /**
+   * @brief Reads one column into a member, in the member's type.
+   */
+  template <typename Member>
+  static void readColumn(const Statement &statement, int column,
+                         Member &value) {
+    if constexpr (std::is_same_v<Member, bool>) {
+      value = statement.getInt(column) != 0;
+    } else if constexpr (std::is_integral_v<Member>) {
+      value = static_cast<Member>(statement.getInt(column));
+    } else if constexpr (std::is_floating_point_v<Member>) {
+      value = static_cast<Member>(statement.getDouble(column));
+    } else if constexpr (std::is_same_v<Member, std::string_view>) {
+      value = statement.getText(column);
+    } else if constexpr (std::is_same_v<Member, std::string>) {
+      std::string_view text = statement.getText(column);
+      value.assign(text.data(), text.size());
+    } else {
+      static_assert(sizeof(Member) == 0, "unsupported model field type");
+    }
+  }
+
+  /**
+   * @brief Binds a member to a parameter, in the member's type.
+   */
+  template <typename Member>
+  static void bindColumn(Statement &statement, int index,
+                         const Member &value) {
+    if constexpr (std::is_integral_v<Member>) {
+      statement.bind(index, static_cast<std::int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<Member>) {
+      statement.bind(index, static_cast<double>(value));
+    } else if constexpr (std::is_same_v<Member, std::string_view> ||
+                         std::is_same_v<Member, std::string>) {
+      statement.bind(index, std::string_view(value));
+    } else {
+      static_assert(sizeof(Member) == 0, "unsupported model field type");
+    }
+  }
+
+  template <std::size_t... I>
+  static void readFields(const Statement &statement, T &row,
+                         std::index_sequence<I...>) {
+    (readColumn(statement, static_cast<int>(I),
+                row.*(std::get<I>(Schema<T>::fields).member)),
+     ...);
+  }
+
+  /**
+   * @brief Binds every field but the key, from parameter 1 on.
+   */
+  template <std::size_t... I>
+  static void bindFields(Statement &statement, const T &row,
+                         std::index_sequence<I...>) {
+    ((I > 0 ? bindColumn(statement, static_cast<int>(I),
+                         row.*(std::get<I>(Schema<T>::fields).member))
+            : void()),
+     ...);
+  }
+
+  static void read(const Statement &statement, T &row) {
+    readFields(statement, row, Indices());
+  }
+
+  static void insertOne(Connection &connection, Statement &statement,
+                        T &row) {
+    bindFields(statement, row, Indices());
+    statement.execute();
+    statement.reset();
+    row.*(std::get<0>(Schema<T>::fields).member) =
+        static_cast<std::decay_t<decltype(row.*(
+            std::get<0>(Schema<T>::fields).member))>>(
+            sqlite3_last_insert_rowid(connection.get_db()));
+  }
+
+  static bool updateOne(Connection &connection, Statement &statement,
+                        const T &row) {
+    bindFields(statement, row, Indices());
+    statement.bind(static_cast<int>(kFieldCount),
+                   static_cast<std::int64_t>(
+                       row.*(std::get<0>(Schema<T>::fields).member)));
+    statement.execute();
+    statement.reset();
+    return sqlite3_changes(connection.get_db()) > 0;
+  }
+};
+
+}  // namespace db
+
+#endif  // MODEL_HPP
@@ -0,0 +1,164 @@
+#ifndef HTTP_PARAMETERS_HPP
+#define HTTP_PARAMETERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @class Parameters
+ * @brief Decoded application/x-www-form-urlencoded name/value pairs, as found
+ * in a query string or a form body.
+ *
+ * Parsing decodes every name and value once, turning '+' into a space and
+ * %XX escapes into bytes, and stores them back to back in one string. Each
+ * pair is a record of offsets into it, so a parse costs at most two
+ * allocations however many pairs there are, and lookups return views without
+ * copying. Pairs keep the order they were sent in, and repeated names are all
+ * kept.
+ *
+ * Both buffers come from a std::pmr memory resource. Copies use the default
+ * resource; moves keep the source's.
+ */
+class Parameters {
+ public:
+  /**
+   * @brief A name/value pair, as views into the collection.
+   */
+  struct Field {
+    std::string_view name;   ///< The decoded name.
+    std::string_view value;  ///< The decoded value.
+  };
+
+  /**
+   * @brief Iterates over the pairs in the order they were sent.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Field;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Field *;
+    using reference = Field;
+
+    Iterator(const Parameters *parameters, std::size_t index);
+    Field operator*() const;
+    Iterator &operator++();
+    bool operator==(const Iterator &other) const;
+    bool operator!=(const Iterator &other) const;
+
+   private:
+    const Parameters *parameters;  ///< The collection being iterated.
+    std::size_t index;             ///< The current pair.
+  };
+
+  /**
+   * @brief Constructs an empty collection.
+   */
+  Parameters();
+
+  /**
+   * @brief Constructs an empty collection allocating from a memory resource.
+   *
+   * @param resource The resource, which must outlive the collection.
+   */
+  explicit Parameters(std::pmr::memory_resource *resource);
+
+  /**
+   * @brief Replaces the pairs with those of an encoded string.
+   *
+   * Pairs are separated by '&'. A pair without '=' has an empty value, and
+   * empty pairs are skipped. Malformed escapes are kept as they are.
+   *
+   * @param encoded The encoded string, without a leading '?'.
+   */
+  void parse(std::string_view encoded);
+
+  /**
+   * @brief Gets the number of pairs.
+   *
+   * @return The number of pairs, counting repeated names.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Checks whether the collection is empty.
+   *
+   * @return True if there are no pairs.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Gets a pair by position.
+   *
+   * @param index The position, less than size().
+   * @return The pair, valid until the collection is changed.
+   */
+  Field operator[](std::size_t index) const;
+
+  /**
+   * @brief Gets the value of a parameter.
+   *
+   * @param name The decoded name, matched exactly.
+   * @return The value of the last pair with the name, or an empty view if
+   * there is none.
+   */
+  std::string_view get(std::string_view name) const;
+
+  /**
+   * @brief Gets every value of a repeated parameter.
+   *
+   * @param name The decoded name, matched exactly.
+   * @return The values in the order they were sent.
+   */
+  std::vector<std::string_view> getAll(std::string_view name) const;
+
+  /**
+   * @brief Checks whether a parameter is present.
+   *
+   * @param name The decoded name, matched exactly.
+   * @return True if at least one pair has the name.
+   */
+  bool has(std::string_view name) const;
+
+  /**
+   * @brief Removes every pair.
+   */
+  void clear();
+
+  Iterator begin() const;
+  Iterator end() const;
+
+ private:
+  /**
+   * @brief The location of one pair in the data string.
+   */
+  struct Entry {
+    std::uint32_t nameOffset;   ///< The offset of the name.
+    std::uint32_t nameLength;   ///< The length of the name.
+    std::uint32_t valueOffset;  ///< The offset of the value.
+    std::uint32_t valueLength;  ///< The length of the value.
+  };
+
+  std::pmr::string data;            ///< The names and values.
+  std::pmr::vector<Entry> entries;  ///< The pairs, in order.
+
+  /**
+   * @brief Gets a view of part of the data string.
+   */
+  std::string_view view(std::uint32_t offset, std::uint32_t length) const;
+};
+
+}  // namespace http
+
+#endif  // HTTP_PARAMETERS_HPP
@@ -0,0 +1,248 @@
+#ifndef HTTP_PARSER_HPP
+#define HTTP_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "request.hpp"
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @class Parser
+ * @brief A resumable HTTP/1.1 request parser working on a byte buffer.
+ *
+ * The parser is fed the connection's receive buffer each time more bytes
+ * arrive and picks up where it left off, so partial reads never cause bytes
+ * to be scanned twice. It copies nothing: the method, URI, version, headers
+ * and Content-Length bodies are returned as views into the buffer passed to
+ * the last parse() call. Only chunked bodies, which are not contiguous on the
+ * wire, are decoded into a buffer owned by the parser.
+ */
+class Parser {
+ public:
+  /**
+   * @brief The outcome of a parse() call.
+   */
+  enum class Status {
+    Incomplete,  ///< More bytes are needed.
+    Complete,    ///< A whole request has been parsed.
+    Error        ///< The request is malformed; see getErrorStatus().
+  };
+
+  /**
+   * @brief A header as a pair of views into the buffer.
+   */
+  struct Header {
+    std::string_view name;   ///< The header name, as sent.
+    std::string_view value;  ///< The header value, without surrounding spaces.
+  };
+
+  /**
+   * @brief Constructs a parser with the given limits.
+   *
+   * @param maxHeaderSize The maximum size of the request line and headers.
+   * @param maxBodySize The maximum size of the (decoded) body.
+   */
+  Parser(std::size_t maxHeaderSize = 64 * 1024,
+         std::size_t maxBodySize = 8 * 1024 * 1024);
+
+  /**
+   * @brief Parses the buffered bytes of a request.
+   *
+   * @param data The receive buffer. It must start with the same bytes that
+   * were passed to earlier calls since the last reset(), and may have grown
+   * or moved in memory since.
+   * @return Whether the request is complete, needs more data, or is invalid.
+   */
+  Status parse(std::string_view data);
+
+  /**
+   * @brief Prepares the parser for the next request.
+   */
+  void reset();
+
+  /**
+   * @brief Gets the number of buffer bytes making up the complete request.
+   *
+   * Bytes past this offset belong to the next (pipelined) request.
+   *
+   * @return The size of the request on the wire.
+   */
+  std::size_t getConsumed() const;
+
+  /**
+   * @brief Gets the HTTP status code describing a parse error.
+   *
+   * @return 400, 413, 431 or 501 after an error, otherwise 0.
+   */
+  int getErrorStatus() const;
+
+  /**
+   * @brief Gets the request method.
+   *
+   * @return A view into the buffer.
+   */
+  std::string_view getMethod() const;
+
+  /**
+   * @brief Gets the request URI.
+   *
+   * @return A view into the buffer.
+   */
+  std::string_view getUri() const;
+
+  /**
+   * @brief Gets the HTTP version.
+   *
+   * @return A view into the buffer.
+   */
+  std::string_view getVersion() const;
+
+  /**
+   * @brief Gets the number of headers parsed so far.
+   *
+   * @return The number of headers.
+   */
+  std::size_t getHeaderCount() const;
+
+  /**
+   * @brief Checks whether the request line and headers have been parsed.
+   *
+   * @return True once the parser has moved on to the body, or finished.
+   */
+  bool hasHead() const;
+
+  /**
+   * @brief Gets a parsed header.
+   *
+   * @param index The position of the header, in the order received.
+   * @return The header name and value, as views into the buffer.
+   */
+  Header getHeader(std::size_t index) const;
+
+  /**
+   * @brief Gets the request body.
+   *
+   * @return A view into the buffer, or into the parser for chunked bodies.
+   */
+  std::string_view getBody() const;
+
+  /**
+   * @brief Checks whether the request declared a body length or encoding.
+   *
+   * @return True if a Content-Length or Transfer-Encoding header was seen.
+   */
+  bool hasFraming() const;
+
+  /**
+   * @brief Copies the parsed request into an http::Request, reusing the
+   * capacity of its strings.
+   *
+   * @param request The request to populate.
+   */
+  void toRequest(Request &request) const;
+
+ private:
+  /**
+   * @brief The parser states, in wire order.
+   */
+  enum class State {
+    RequestLine,
+    Headers,
+    Body,
+    ChunkSize,
+    ChunkData,
+    ChunkDataEnd,
+    Trailers,
+    Done,
+    Failed
+  };
+
+  /**
+   * @brief A range of the buffer, kept as offsets so it survives the buffer
+   * moving between calls.
+   */
+  struct Span {
+    std::size_t offset;  ///< The offset of the first byte.
+    std::size_t length;  ///< The number of bytes.
+  };
+
+  /**
+   * @brief A header as a pair of buffer ranges.
+   */
+  struct HeaderSpan {
+    Span name;   ///< The header name.
+    Span value;  ///< The header value.
+  };
+
+  std::size_t maxHeaderSize;  ///< The limit for the request head.
+  std::size_t maxBodySize;    ///< The limit for the body.
+  std::string_view buffer;    ///< The buffer passed to the last parse().
+  State state;                ///< The current state.
+  std::size_t position;       ///< The offset of the next byte to parse.
+  std::size_t scanned;        ///< The offset up to which no line end exists.
+  int errorStatus;            ///< The status code describing an error.
+  Span method;                ///< The request method.
+  Span uri;                   ///< The request URI.
+  Span version;               ///< The HTTP version.
+  std::vector<HeaderSpan> headers;  ///< The headers.
+  bool framed;                ///< True if the body length was declared.
+  bool lengthSeen;            ///< True once Content-Length was seen.
+  bool chunked;               ///< True for chunked transfer-encoding.
+  std::size_t contentLength;  ///< The declared Content-Length.
+  std::size_t remaining;      ///< Bytes left in the current chunk.
+  Span body;                  ///< The Content-Length body.
+  std::string chunkedBody;    ///< The decoded chunked body.
+
+  /**
+   * @brief Finds the next line starting at the current position.
+   *
+   * @param line Receives the line without its CRLF (or bare LF).
+   * @return False if the line is not complete yet.
+   */
+  bool nextLine(Span &line);
+
+  /**
+   * @brief Parses the request line. Fails the parser on error.
+   */
+  bool parseRequestLine(Span line);
+
+  /**
+   * @brief Parses one header line. Fails the parser on error.
+   */
+  bool parseHeader(Span line);
+
+  /**
+   * @brief Chooses the body state once the head is complete. Fails the
+   * parser on conflicting framing headers.
+   */
+  bool finishHeaders();
+
+  /**
+   * @brief Parses a chunk-size line. Fails the parser on error.
+   */
+  bool parseChunkSize(Span line);
+
+  /**
+   * @brief Enters the error state.
+   *
+   * @return Status::Error, for convenience.
+   */
+  Status fail(int status);
+
+  /**
+   * @brief Resolves a span against the current buffer.
+   */
+  std::string_view view(Span span) const;
+};
+
+}  // namespace http
+
+#endif  // HTTP_PARSER_HPP
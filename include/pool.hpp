@@ -0,0 +1,173 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "connection.hpp"
+
+namespace db {
+
+/**
+ * @class Pool
+ * @brief A pool of SQLite connections for handlers running on many threads.
+ *
+ * The pool opens one writer connection and a number of read-only reader
+ * connections to the same database file, all with SQLITE_OPEN_NOMUTEX, and
+ * switches the database to WAL mode so that readers never wait for the
+ * writer or for each other. Connections are checked out through a Lease,
+ * which hands the connection back when it goes out of scope.
+ *
+ * Every thread has a home reader, picked round-robin the first time it
+ * reads. Checking a connection out is a single compare-and-swap on that
+ * reader's flag; only when it is taken does the thread try the others, and
+ * only when all of them are taken does it sleep until one is returned. With
+ * as many readers as threads, each thread effectively owns one connection.
+ */
+class Pool {
+ private:
+  struct Slot;
+
+ public:
+  /**
+   * @class Lease
+   * @brief Exclusive use of one pooled connection until destroyed.
+   */
+  class Lease {
+   public:
+    Lease(Lease &&other) noexcept;
+    Lease &operator=(Lease &&other) noexcept;
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    /**
+     * @brief Returns the connection to the pool.
+     */
+    ~Lease();
+
+    /**
+     * @brief Gets the leased connection.
+     */
+    Connection &operator*() const;
+
+    /**
+     * @brief Accesses the leased connection.
+     */
+    Connection *operator->() const;
+
+    /**
+     * @brief Gets the sqlite3* handle of the leased connection.
+     *
+     * @return The handle, valid until the lease is destroyed.
+     */
+    sqlite3 *get_db() const;
+
+   private:
+    friend class Pool;
+
+    Pool *pool;  ///< The pool the connection returns to.
+    Slot *slot;  ///< The leased slot; null once moved from.
+
+    Lease(Pool *pool, Slot *slot);
+  };
+
+  /**
+   * @brief Opens the connections.
+   *
+   * @param path The path to the database file, created if missing. In-memory
+   * databases cannot be shared between connections and are not supported.
+   * @param readers The number of reader connections, at least one; by
+   * default one per hardware thread.
+   * @param busyTimeout How long a connection retries, in milliseconds, while
+   * the database is locked (e.g., during a checkpoint).
+   *
+   * @throw std::runtime_error if a connection fails to open or the database
+   * cannot be switched to WAL mode.
+   */
+  explicit Pool(const std::string &path, std::size_t readers = 0,
+                int busyTimeout = 5000);
+
+  /**
+   * @brief Closes the connections. Every lease must have been destroyed.
+   */
+  ~Pool();
+
+  Pool(const Pool &) = delete;
+  Pool &operator=(const Pool &) = delete;
+
+  /**
+   * @brief Checks out a reader connection, waiting if all are in use.
+   *
+   * Reader connections are opened read-only, so statements that modify the
+   * database fail on them.
+   *
+   * @return The lease.
+   */
+  Lease read();
+
+  /**
+   * @brief Checks out the writer connection, waiting if it is in use.
+   *
+   * @return The lease.
+   */
+  Lease write();
+
+  /**
+   * @brief Gets the number of reader connections.
+   *
+   * @return The number of readers.
+   */
+  std::size_t readers() const;
+
+ private:
+  /**
+   * @brief One pooled connection and whether it is checked out. Slots sit on
+   * cache lines of their own, so that threads leasing neighbouring readers
+   * do not contend.
+   */
+  struct alignas(64) Slot {
+    std::unique_ptr<Connection> connection;  ///< The connection.
+    std::atomic<bool> busy{false};           ///< Set while leased.
+  };
+
+  std::unique_ptr<Slot[]> slots;  ///< The writer, then the readers.
+  std::size_t readerCount;        ///< The number of readers.
+  std::atomic<std::size_t> waiting;  ///< Threads sleeping on returned.
+  std::mutex mutex;                  ///< Guards sleeping.
+  std::condition_variable returned;  ///< Wakes threads waiting for a slot.
+
+  /**
+   * @brief Claims a slot if it is free.
+   *
+   * @return True if the slot was claimed.
+   */
+  static bool claim(Slot &slot);
+
+  /**
+   * @brief Claims one of the slots, trying first from first on.
+   *
+   * @param begin The index of the first slot of the range.
+   * @param count The number of slots in the range.
+   * @param first The offset into the range to start from.
+   * @return The slot, or nullptr if all are in use.
+   */
+  Slot *claimAny(std::size_t begin, std::size_t count, std::size_t first);
+
+  /**
+   * @brief Claims a slot from a range, sleeping until one is returned.
+   */
+  Lease acquire(std::size_t begin, std::size_t count, std::size_t first);
+
+  /**
+   * @brief Returns a slot, waking a thread waiting for one.
+   */
+  void release(Slot &slot);
+};
+
+}  // namespace db
+
+#endif  // POOL_HPP
@@ -0,0 +1,226 @@
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "connection.hpp"
+#include "statement.hpp"
+
+namespace db {
+
+/**
+ * @class Query
+ * @brief Builds parameterized SQL for select, insert, update and delete.
+ *
+ * A query describes a shape: every value is a `?` placeholder and is only
+ * supplied when the query is run, where it is bound onto the statement in its
+ * SQLite type. The SQL text depends on the shape alone, so each shape maps to
+ * one statement in the connection's cache. Build a query once per call site,
+ * e.g. in a function-local static, and run it per request:
+ *
+ * @code
+ * static const db::Query byEmail =
+ *     db::Query::select("users", {"id", "name"}).where("email").limit();
+ * db::Statement statement = byEmail.prepare(connection, email, 1);
+ * @endcode
+ *
+ * Table and column names are quoted as identifiers; they are not values and
+ * must come from the program, not from requests.
+ */
+class Query {
+ public:
+  /**
+   * @brief Starts a SELECT.
+   *
+   * @param table The table.
+   * @param columns The columns to read, or none for all of them.
+   * @return The query.
+   */
+  static Query select(std::string_view table,
+                      const std::vector<std::string> &columns = {});
+
+  /**
+   * @brief Starts an INSERT of one row.
+   *
+   * @param table The table.
+   * @param columns The columns to set, each taking one value.
+   * @return The query.
+   *
+   * @throw std::runtime_error if no columns are given.
+   */
+  static Query insert(std::string_view table,
+                      const std::vector<std::string> &columns);
+
+  /**
+   * @brief Starts an UPDATE.
+   *
+   * @param table The table.
+   * @param columns The columns to set, each taking one value before those of
+   * the conditions.
+   * @return The query.
+   *
+   * @throw std::runtime_error if no columns are given.
+   */
+  static Query update(std::string_view table,
+                      const std::vector<std::string> &columns);
+
+  /**
+   * @brief Starts a DELETE.
+   *
+   * @param table The table.
+   * @return The query.
+   */
+  static Query remove(std::string_view table);
+
+  /**
+   * @brief Adds a condition comparing a column with a value, joined to any
+   * previous ones with AND.
+   *
+   * @param column The column.
+   * @param comparison One of =, !=, <>, <, <=, >, >=, LIKE, IS and IS NOT.
+   * @return This query.
+   *
+   * @throw std::runtime_error on an INSERT or an unknown comparison.
+   */
+  Query &where(std::string_view column, std::string_view comparison = "=");
+
+  /**
+   * @brief Adds a condition matching a column against a list of values.
+   *
+   * @param column The column.
+   * @param count The number of values, at least one.
+   * @return This query.
+   *
+   * @throw std::runtime_error on an INSERT or if count is 0.
+   */
+  Query &whereIn(std::string_view column, std::size_t count);
+
+  /**
+   * @brief Orders the rows of a SELECT by a column, after any previous order.
+   *
+   * @param column The column.
+   * @param descending True to sort in descending order.
+   * @return This query.
+   *
+   * @throw std::runtime_error if the query is not a SELECT.
+   */
+  Query &orderBy(std::string_view column, bool descending = false);
+
+  /**
+   * @brief Limits the number of rows of a SELECT, taking the limit as the
+   * next value.
+   *
+   * @param withOffset True to take the number of rows to skip as the value
+   * after the limit.
+   * @return This query.
+   *
+   * @throw std::runtime_error if the query is not a SELECT.
+   */
+  Query &limit(bool withOffset = false);
+
+  /**
+   * @brief Gets the SQL text.
+   *
+   * @return The SQL, with a `?` for each value.
+   */
+  const std::string &getSql() const;
+
+  /**
+   * @brief Gets the number of values the query takes.
+   *
+   * @return The number of `?` placeholders.
+   */
+  int getParameterCount() const;
+
+  /**
+   * @brief Prepares the query on a connection and binds its values.
+   *
+   * The statement outlives the call, so text values are copied into it and
+   * temporaries may be passed.
+   *
+   * @param connection The connection, whose statement cache is used.
+   * @param values The values, in placeholder order: the columns set by an
+   * INSERT or UPDATE, then the conditions, then the limit and offset.
+   * @return The statement, ready to step.
+   *
+   * @throw std::runtime_error if the number of values does not match.
+   */
+  template <typename... Values>
+  Statement prepare(Connection &connection, const Values &...values) const {
+    Statement statement = start(connection, sizeof...(Values));
+    int index = 0;
+    (bindCopy(statement, ++index, values), ...);
+    return statement;
+  }
+
+  /**
+   * @brief Runs a query that returns no rows.
+   *
+   * The values outlive the statement here, so text is bound without being
+   * copied.
+   *
+   * @param connection The connection.
+   * @param values The values, as for prepare().
+   * @return The number of rows inserted, updated or deleted.
+   *
+   * @throw std::runtime_error if the number of values does not match.
+   */
+  template <typename... Values>
+  int execute(Connection &connection, const Values &...values) const {
+    Statement statement = start(connection, sizeof...(Values));
+    int index = 0;
+    (statement.bind(++index, values), ...);
+    statement.execute();
+    return sqlite3_changes(connection.get_db());
+  }
+
+ private:
+  /**
+   * @brief The kind of statement a query builds.
+   */
+  enum class Kind { Select, Insert, Update, Delete };
+
+  Kind kind;                    ///< The kind of statement.
+  std::string table;            ///< The quoted table name.
+  std::string columns;          ///< The column list or SET clause.
+  int columnParameters = 0;     ///< Values taken by the columns.
+  std::string conditions;       ///< The WHERE clause, without the keyword.
+  int conditionParameters = 0;  ///< Values taken by the conditions.
+  std::string order;            ///< The ORDER BY clause, without the keyword.
+  int limitParameters = 0;      ///< Values taken by LIMIT and OFFSET.
+  std::string sql;              ///< The SQL, rebuilt after every change.
+  int parameters = 0;           ///< The number of placeholders in the SQL.
+
+  Query(Kind kind, std::string_view table);
+
+  /**
+   * @brief Checks the number of values and prepares the statement.
+   */
+  Statement start(Connection &connection, std::size_t values) const;
+
+  /**
+   * @brief Binds a value, copying it if it is text.
+   */
+  template <typename Value>
+  static void bindCopy(Statement &statement, int index, const Value &value) {
+    if constexpr (!std::is_same_v<Value, std::nullptr_t> &&
+                  std::is_convertible_v<const Value &, std::string_view>) {
+      statement.bindCopy(index, value);
+    } else {
+      statement.bind(index, value);
+    }
+  }
+
+  /**
+   * @brief Rebuilds the SQL from the clauses.
+   */
+  void build();
+};
+
+}  // namespace db
+
+#endif  // QUERY_HPP
@@ -0,0 +1,231 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "app.hpp"
+#include "executor.hpp"
+#include "kernel.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "server.hpp"
+#include "timer.hpp"
+
+namespace core {
+
+/**
+ * @class Reactor
+ * @brief A single-threaded, edge-triggered epoll event loop.
+ *
+ * The reactor accepts connections from a listening socket, reads and parses
+ * requests incrementally as bytes arrive, dispatches each complete request
+ * through a Kernel, and writes the response back without ever blocking. All
+ * sockets are non-blocking, so one reactor can serve thousands of concurrent
+ * connections from a single thread. A reactor touches no state shared with
+ * other reactors besides the read-only App.
+ *
+ * Requests for blocking routes are handed to an Executor instead of running
+ * on the event loop; the worker posts the finished response back to the
+ * reactor, which writes it from its own thread.
+ *
+ * Connections are kept alive between requests as HTTP/1.1 allows. Pipelined
+ * requests are buffered and dispatched one at a time, each as soon as the
+ * previous response has been written, so responses always leave in request
+ * order.
+ *
+ * Each connection has its own monotonic arena for the request being served.
+ * The request's headers and route parameters, and the headers of responses
+ * built from request.getResource(), are bump-allocated from it, and the
+ * whole exchange is freed in one release() once the response is written.
+ * Arena chunks come from a per-reactor pool, so a steady stream of requests
+ * reaches the global allocator only for the strings a handler allocates
+ * itself.
+ *
+ * Each connection also keeps one http::Request, cleared and refilled for
+ * every request it reads, so the method, URI, version and body are copied
+ * into strings that have already grown to fit and do not allocate either.
+ *
+ * Closed connections are kept on a per-reactor free list and reused, with
+ * their input, head and parser buffers, their request and their arena, for
+ * the next accepted socket. Connections are indexed by socket in a flat
+ * table, so once the pool is warm a reactor serves new and kept-alive
+ * connections alike without touching the global allocator. The list belongs
+ * to the reactor's thread, so taking from it and returning to it needs no
+ * locks.
+ *
+ * Every connection carries one timer on the reactor's TimerWheel, armed for
+ * whichever deadline applies to its state: idle between requests, reading
+ * the headers, reading the body or writing the response. Moving the timer
+ * costs O(1), and epoll_wait sleeps until the wheel's next deadline.
+ */
+class Reactor {
+ public:
+  /**
+   * @brief Constructs a reactor serving the given application.
+   *
+   * @param app The application whose routes handle incoming requests.
+   * @param listenFd A bound, listening, non-blocking socket. The reactor takes
+   * ownership of it and closes it on destruction.
+   * @param options The server tunables.
+   * @param executor The pool running blocking handlers, or nullptr to run
+   * them on the event loop. It must outlive every task the reactor submits.
+   *
+   * @throw std::runtime_error if the epoll instance cannot be created.
+   */
+  Reactor(const App &app, int listenFd, const ServerOptions &options,
+          Executor *executor = nullptr);
+
+  /**
+   * @brief Closes the listening socket, every open connection and the epoll
+   * instance.
+   */
+  ~Reactor();
+
+  Reactor(const Reactor &) = delete;
+  Reactor &operator=(const Reactor &) = delete;
+
+  /**
+   * @brief Runs the event loop until stop() is called and in-flight requests
+   * have drained.
+   */
+  void run();
+
+  /**
+   * @brief Asks the event loop to drain and exit. Safe to call from any
+   * thread.
+   */
+  void stop();
+
+ private:
+  struct Connection;
+
+  /**
+   * @brief A response produced on a worker thread, waiting to be written.
+   */
+  struct Completion {
+    int fd;                   ///< The socket of the connection.
+    std::uint64_t id;         ///< The connection id, guarding fd reuse.
+    http::Response response;  ///< The response to write.
+  };
+
+  Kernel kernel;          ///< The kernel dispatching parsed requests.
+  ServerOptions options;  ///< The server tunables.
+  Executor *executor;     ///< The pool running blocking handlers, if any.
+  int listenFd;           ///< The listening socket, or -1 once closed.
+  int epollFd;            ///< The epoll instance.
+  int wakeFd;             ///< The eventfd used to interrupt epoll_wait.
+  std::atomic<bool> stopping;  ///< Set once stop() has been called.
+  bool draining;               ///< True once the loop has begun draining.
+  std::chrono::steady_clock::time_point
+      drainDeadline;  ///< When draining gives up on in-flight requests.
+  std::pmr::unsynchronized_pool_resource
+      pool;  ///< The chunks behind every connection's arena.
+  std::vector<std::unique_ptr<Connection>>
+      connections;  ///< The open connections, indexed by socket.
+  std::vector<std::unique_ptr<Connection>>
+      spare;             ///< Closed connections kept for reuse.
+  std::size_t open;      ///< The number of open connections.
+  std::uint64_t nextId;  ///< The id given to the next accepted connection.
+  std::mutex completionMutex;  ///< Guards completions.
+  std::vector<Completion>
+      completions;  ///< Responses posted by workers, not yet written.
+  TimerWheel timers;         ///< The connection deadlines.
+  std::vector<int> expired;  ///< Connections whose deadline just passed.
+
+  /**
+   * @brief Stops accepting and closes every idle connection.
+   */
+  void drain();
+
+  /**
+   * @brief Accepts every pending connection on the listening socket.
+   */
+  void accept();
+
+  /**
+   * @brief Reads everything available on a connection and handles any
+   * complete request.
+   */
+  void read(Connection &connection);
+
+  /**
+   * @brief Dispatches buffered requests until one is incomplete or has to
+   * wait for its response to be written.
+   *
+   * @return False if the connection was closed.
+   */
+  bool process(Connection &connection);
+
+  /**
+   * @brief Writes as much pending output as the socket accepts.
+   */
+  void write(Connection &connection);
+
+  /**
+   * @brief Closes a connection whose response has been written, or readies it
+   * for the next request.
+   */
+  void finish(Connection &connection);
+
+  /**
+   * @brief Arms the connection's timer for the deadline its state calls for.
+   */
+  void schedule(Connection &connection);
+
+  /**
+   * @brief Handles a connection whose deadline has passed.
+   */
+  void expire(Connection &connection);
+
+  /**
+   * @brief Routes a request and runs its handler, either inline or on the
+   * executor for blocking routes.
+   */
+  void dispatch(Connection &connection, const http::Request &request);
+
+  /**
+   * @brief Posts a response produced on a worker thread back to the event
+   * loop. Safe to call from any thread.
+   */
+  void complete(int fd, std::uint64_t id, http::Response response);
+
+  /**
+   * @brief Writes the responses posted by workers since the last wake-up.
+   */
+  void collect();
+
+  /**
+   * @brief Queues a response for writing.
+   */
+  void respond(Connection &connection, http::Response response);
+
+  /**
+   * @brief Queues an error response and marks the connection for closing.
+   */
+  void fail(Connection &connection, int statusCode,
+            const std::string &statusMessage);
+
+  /**
+   * @brief Closes a connection and forgets about it. While the connection is
+   * processing requests, closing is deferred until process() returns.
+   */
+  void close(Connection &connection);
+
+  /**
+   * @brief Looks up the open connection on a socket.
+   *
+   * @return The connection, or nullptr if the socket has none.
+   */
+  Connection *find(int fd);
+};
+
+}  // namespace core
+
+#endif  // REACTOR_HPP
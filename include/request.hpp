@@ -1,8 +1,16 @@
 #ifndef HTTP_REQUEST_HPP
 #define HTTP_REQUEST_HPP
 
+#include <cstddef>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "headers.hpp"
+#include "method.hpp"
+#include "parameters.hpp"
 
 /**
  * @namespace http
@@ -16,6 +24,11 @@ namespace http {
  *
  * This class encapsulates the details of an HTTP request, including
  * the request method, URI, version, headers, and body.
+ *
+ * Query and form parameters are parsed on first access and cached, so reading
+ * several of them costs one parse. Like route parameters, the cache is filled
+ * in on a const request, so a request must not be read from two threads at
+ * once.
  */
 class Request {
  public:
@@ -25,6 +38,17 @@ class Request {
    */
   Request();
 
+  /**
+   * @brief Constructs an empty request whose headers and route parameters
+   * allocate from a memory resource, typically a per-request arena.
+   *
+   * Copies of the request allocate from the default resource instead, so
+   * they may outlive the arena.
+   *
+   * @param resource The resource, which must outlive the request.
+   */
+  explicit Request(std::pmr::memory_resource *resource);
+
   /**
    * @brief Parameterized constructor.
    * Initializes a new instance of the Request class with specified method, URI,
@@ -36,74 +60,91 @@ class Request {
    * @param body The body of the request.
    * @param headers The headers of the request.
    */
-  Request(const std::string &method, const std::string &uri,
-          const std::string &version, const std::string &body,
-          const std::map<std::string, std::string> &headers);
+  Request(std::string method, std::string uri, std::string version,
+          std::string body, Headers headers);
 
   /**
    * @brief Gets the HTTP method of the request.
    *
-   * @return The HTTP method as a string.
+   * @return A reference to the HTTP method, valid until it is changed.
    */
-  std::string getMethod() const;
+  const std::string &getMethod() const;
+
+  /**
+   * @brief Gets the HTTP method of the request, interned.
+   *
+   * @return The method, or Method::Count if it is not one routes can be
+   * registered for.
+   */
+  Method getMethodId() const;
 
   /**
    * @brief Gets the URI of the request.
    *
-   * @return The URI as a string.
+   * @return A reference to the URI, valid until the URI is changed.
    */
-  std::string getUri() const;
+  const std::string &getUri() const;
 
   /**
    * @brief Gets the HTTP version of the request.
    *
-   * @return The HTTP version as a string.
+   * @return A reference to the HTTP version, valid until it is changed.
    */
-  std::string getVersion() const;
+  const std::string &getVersion() const;
 
   /**
    * @brief Gets the value of a specific header from the request.
    *
    * @param key The name of the header.
    * @return The value of the header as a string. Returns an empty string if the
-   * header is not found.
+   * header is not found. The name is matched case-insensitively.
    */
-  std::string getHeader(const std::string &key) const;
+  std::string getHeader(std::string_view key) const;
 
   /**
    * @brief Gets all headers from the request.
    *
-   * @return A map containing all headers.
+   * @return A reference to the headers, valid for the life of the request.
+   */
+  const Headers &getHeaders() const;
+
+  /**
+   * @brief Gets the memory resource the request allocates from.
+   *
+   * Handlers can pass it on to the Response they build, so that the whole
+   * exchange is released at once when the response has been written.
+   *
+   * @return The resource.
    */
-  std::map<std::string, std::string> getHeaders() const;
+  std::pmr::memory_resource *getResource() const;
 
   /**
    * @brief Gets the body of the request.
    *
-   * @return The body as a string.
+   * @return A reference to the body, valid until it is changed.
    */
-  std::string getBody() const;
+  const std::string &getBody() const;
 
   /**
    * @brief Sets the HTTP method of the request.
    *
    * @param method The HTTP method to set.
    */
-  void setMethod(const std::string &method);
+  void setMethod(std::string method);
 
   /**
    * @brief Sets the URI of the request.
    *
    * @param uri The URI to set.
    */
-  void setUri(const std::string &uri);
+  void setUri(std::string uri);
 
   /**
    * @brief Sets the HTTP version of the request.
    *
    * @param version The HTTP version to set.
    */
-  void setVersion(const std::string &version);
+  void setVersion(std::string version);
 
   /**
    * @brief Sets a header in the request.
@@ -111,19 +152,63 @@ class Request {
    * @param key The name of the header.
    * @param value The value of the header.
    */
-  void setHeader(const std::string &key, const std::string &value);
+  void setHeader(std::string_view key, std::string_view value);
+
+  /**
+   * @brief Adds a header to the request, keeping any with the same name.
+   *
+   * @param key The name of the header.
+   * @param value The value of the header.
+   */
+  void addHeader(std::string_view key, std::string_view value);
 
   /**
    * @brief Sets the body of the request.
    *
    * @param body The body to set.
    */
-  void setBody(const std::string &body);
+  void setBody(std::string body);
+
+  /**
+   * @brief Copies a request line and body into the request.
+   *
+   * Unlike the setters, this reuses the capacity the strings already have,
+   * so a request that is cleared and refilled for each request on a
+   * connection stops allocating for them once it has seen the longest.
+   *
+   * @param method The HTTP method.
+   * @param uri The URI.
+   * @param version The HTTP version.
+   * @param body The body.
+   */
+  void assign(std::string_view method, std::string_view uri,
+              std::string_view version, std::string_view body);
+
+  /**
+   * @brief Empties the request so that it can be reused for another.
+   *
+   * The method, URI, version and body keep their capacity. Headers, route
+   * parameters and parsed query and form parameters give their memory back
+   * to the request's resource, so that an arena behind it can be released
+   * afterwards.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the decoded query parameters of the URI.
+   *
+   * The query string is parsed on first access and the result cached until
+   * the URI changes.
+   *
+   * @return The parameters, valid until the URI is changed.
+   */
+  const Parameters &getQuery() const;
 
   /**
    * @brief Get all query parameters from the URI.
    *
-   * @return A map containing all query parameters.
+   * @return A map containing all query parameters. Of repeated names, the last
+   * value is kept.
    */
   std::map<std::string, std::string> getQueryParameters() const;
 
@@ -131,8 +216,8 @@ class Request {
    * @brief Get a specific query parameter from the URI.
    *
    * @param key The name of the query parameter.
-   * @return The value of the query parameter as a string. Returns an empty
-   * string if the query parameter is not found.
+   * @return The last value of the query parameter as a string. Returns an
+   * empty string if the query parameter is not found.
    */
   std::string getQueryParameter(const std::string &key) const;
 
@@ -143,10 +228,39 @@ class Request {
    */
   std::string getPath() const;
 
+  /**
+   * @brief Get the URI path without the query parameters, without copying.
+   *
+   * @return A view into the URI, valid until the URI is changed.
+   */
+  std::string_view getPathView() const;
+
+  /**
+   * @brief Checks whether the client wants the connection kept open.
+   *
+   * HTTP/1.1 connections persist unless the request carries
+   * `Connection: close`; HTTP/1.0 connections persist only with an explicit
+   * `Connection: keep-alive`.
+   *
+   * @return True if the connection may be reused after the response.
+   */
+  bool isKeepAlive() const;
+
+  /**
+   * @brief Gets the decoded form parameters of the body.
+   *
+   * The body is parsed on first access and the result cached until the body
+   * changes.
+   *
+   * @return The parameters, valid until the body is changed.
+   */
+  const Parameters &getInput() const;
+
   /**
    * @brief Get all input parameters from the body.
    *
-   * @return A map containing all input parameters.
+   * @return A map containing all input parameters. Of repeated names, the last
+   * value is kept.
    */
   std::map<std::string, std::string> getInputParameters() const;
 
@@ -154,11 +268,41 @@ class Request {
    * @brief Get a specific input parameter from the body.
    *
    * @param key The name of the input parameter.
-   * @return The value of the input parameter as a string. Returns an empty
-   * string if the input parameter is not found.
+   * @return The last value of the input parameter as a string. Returns an
+   * empty string if the input parameter is not found.
    */
   std::string getInputParameter(const std::string &key) const;
 
+  /**
+   * @brief Gets the value of a route parameter captured during routing.
+   *
+   * @param name The name of the parameter, without the leading ':'.
+   * @return The value as a view into the URI. Returns an empty view if the
+   * parameter was not captured.
+   */
+  std::string_view getParameter(std::string_view name) const;
+
+  /**
+   * @brief Checks whether a route parameter was captured during routing.
+   *
+   * @param name The name of the parameter, without the leading ':'.
+   * @return True if the parameter was captured, false otherwise.
+   */
+  bool hasParameter(std::string_view name) const;
+
+  /**
+   * @brief Records the route parameters captured while matching the request.
+   *
+   * This is called by the router during dispatch, which is why it is usable
+   * on a const request. The values are kept as offsets into the URI, so no
+   * strings are copied and copies of the request stay valid.
+   *
+   * @param names The parameter names. They must outlive the dispatch.
+   * @param values The captured values, as views into getUri().
+   */
+  void setParameters(const std::vector<std::string> &names,
+                     const std::vector<std::string_view> &values) const;
+
   /**
    * @brief Parses a raw HTTP request string and populates the Request object.
    *
@@ -175,10 +319,27 @@ class Request {
 
  private:
   std::string method;   ///< The HTTP method of the request.
+  Method methodId;      ///< The interned method.
   std::string uri;      ///< The URI of the request.
   std::string version;  ///< The HTTP version of the request.
   std::string body;     ///< The body of the request.
-  std::map<std::string, std::string> headers;  ///< The headers of the request.
+  Headers headers;      ///< The headers of the request.
+
+  /**
+   * @brief A route parameter captured during routing.
+   */
+  struct Parameter {
+    std::string_view name;  ///< The parameter name, owned by the route.
+    std::size_t offset;     ///< The offset of the value in the URI.
+    std::size_t length;     ///< The length of the value.
+  };
+
+  mutable std::pmr::vector<Parameter>
+      parameters;  ///< The route parameters captured during routing.
+  mutable Parameters query;  ///< The query parameters, once parsed.
+  mutable Parameters input;  ///< The form parameters, once parsed.
+  mutable bool queryParsed;  ///< True if query reflects the URI.
+  mutable bool inputParsed;  ///< True if input reflects the body.
 };
 
 }  // namespace http
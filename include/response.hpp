@@ -1,8 +1,14 @@
 #ifndef HTTP_RESPONSE_HPP
 #define HTTP_RESPONSE_HPP
 
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+
+#include "headers.hpp"
 
 /**
  * @namespace http
@@ -10,6 +16,8 @@
  */
 namespace http {
 
+class File;
+
 /**
  * @class Response
  * @brief Represents an HTTP response.
@@ -25,6 +33,14 @@ class Response {
    */
   Response();
 
+  /**
+   * @brief Constructs an empty 200 response whose headers allocate from a
+   * memory resource, typically the arena of the request being answered.
+   *
+   * @param resource The resource, which must outlive the response.
+   */
+  explicit Response(std::pmr::memory_resource *resource);
+
   /**
    * @brief Parameterized constructor.
    * Initializes a new instance of the Response class with specified status
@@ -33,11 +49,11 @@ class Response {
    * @param statusCode The HTTP status code of the response.
    * @param statusMessage The HTTP status message of the response.
    * @param body The body of the response.
-   * @param headers The headers of the response.
+   * @param headers The headers of the response. The response allocates from
+   * their memory resource.
    */
-  Response(int statusCode, const std::string &statusMessage,
-           const std::string &body,
-           const std::map<std::string, std::string> &headers);
+  Response(int statusCode, std::string statusMessage, std::string body,
+           Headers headers);
 
   /**
    * @brief Gets the HTTP status code of the response.
@@ -49,32 +65,39 @@ class Response {
   /**
    * @brief Gets the HTTP status message of the response.
    *
-   * @return The HTTP status message as a string.
+   * @return A reference to the status message, valid until it is changed.
    */
-  std::string getStatusMessage() const;
+  const std::string &getStatusMessage() const;
 
   /**
    * @brief Gets the value of a specific header from the response.
    *
    * @param key The name of the header.
    * @return The value of the header as a string. Returns an empty string if the
-   * header is not found.
+   * header is not found. The name is matched case-insensitively.
    */
-  std::string getHeader(const std::string &key) const;
+  std::string getHeader(std::string_view key) const;
 
   /**
    * @brief Gets all headers from the response.
    *
-   * @return A map containing all headers.
+   * @return A reference to the headers, valid for the life of the response.
+   */
+  const Headers &getHeaders() const;
+
+  /**
+   * @brief Gets the memory resource the response's headers allocate from.
+   *
+   * @return The resource.
    */
-  std::map<std::string, std::string> getHeaders() const;
+  std::pmr::memory_resource *getResource() const;
 
   /**
    * @brief Gets the body of the response.
    *
-   * @return The body as a string.
+   * @return A reference to the body, valid until it is changed.
    */
-  std::string getBody() const;
+  const std::string &getBody() const;
 
   /**
    * @brief Sets the HTTP status code of the response.
@@ -88,7 +111,7 @@ class Response {
    *
    * @param statusMessage The HTTP status message to set.
    */
-  void setStatusMessage(const std::string &statusMessage);
+  void setStatusMessage(std::string statusMessage);
 
   /**
    * @brief Sets a header in the response.
@@ -96,22 +119,81 @@ class Response {
    * @param key The name of the header.
    * @param value The value of the header.
    */
-  void setHeader(const std::string &key, const std::string &value);
+  void setHeader(std::string_view key, std::string_view value);
 
   /**
    * @brief Sets the body of the response.
    *
+   * Replaces any file body.
+   *
    * @param body The body to set.
    */
-  void setBody(const std::string &body);
+  void setBody(std::string body);
+
+  /**
+   * @brief Uses a range of an open file as the body.
+   *
+   * The server streams the range with sendfile(2), so the bytes never pass
+   * through user space. Replaces any string body.
+   *
+   * @param file The file to send.
+   * @param offset The offset of the first byte to send.
+   * @param length The number of bytes to send.
+   */
+  void setFile(std::shared_ptr<const File> file, std::size_t offset,
+               std::size_t length);
+
+  /**
+   * @brief Gets the file body, if any.
+   *
+   * @return The file, or nullptr for a string body.
+   */
+  const std::shared_ptr<const File> &getFile() const;
+
+  /**
+   * @brief Gets the offset of the file range sent as the body.
+   *
+   * @return The offset in bytes.
+   */
+  std::size_t getFileOffset() const;
+
+  /**
+   * @brief Gets the length of the file range sent as the body.
+   *
+   * @return The length in bytes.
+   */
+  std::size_t getFileLength() const;
+
+  /**
+   * @brief Gets the size of the body, whether a string or a file range.
+   *
+   * @return The value for the Content-Length header.
+   */
+  std::size_t getContentLength() const;
 
   /**
    * @brief Converts the Response object to a raw HTTP response string.
    *
+   * Headers are sorted by name so the output is stable. This copies the body;
+   * servers should write serializeHead() and the body separately instead.
+   *
    * @return The raw HTTP response string.
    */
   std::string toString() const;
 
+  /**
+   * @brief Serializes the status line and headers, without the body.
+   *
+   * The buffer is cleared first but keeps its capacity, so a connection can
+   * reuse one buffer for every response it sends. The body is meant to be
+   * written after it as a separate iovec, which avoids copying it.
+   *
+   * @param buffer Receives the head, ending with the blank line.
+   * @param sortHeaders True to sort headers by name; the wire does not need
+   * it, so by default they are written in insertion order.
+   */
+  void serializeHead(std::string &buffer, bool sortHeaders = false) const;
+
   /**
    * @brief Parses a raw HTTP response string and populates the Response object.
    *
@@ -122,8 +204,12 @@ class Response {
  private:
   int statusCode;             ///< The HTTP status code of the response.
   std::string statusMessage;  ///< The HTTP status message of the response.
-  std::map<std::string, std::string> headers;  ///< The headers of the response.
-  std::string body;                            ///< The body of the response.
+  Headers headers;            ///< The headers of the response.
+  std::string body;           ///< The body of the response.
+
+  std::shared_ptr<const File> file;  ///< The file body, if any.
+  std::size_t fileOffset;            ///< The first byte of the file body.
+  std::size_t fileLength;            ///< The length of the file body.
 };
 
 }  // namespace http
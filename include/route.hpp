@@ -1,21 +1,34 @@
 #ifndef ROUTE_HPP
 #define ROUTE_HPP
 
-#include <functional>
-#include <regex>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "function.hpp"
+#include "method.hpp"
 #include "request.hpp"
 #include "response.hpp"
 
 namespace router {
 
+/**
+ * @brief A route handler: takes the request and returns the response.
+ *
+ * Handlers are moved into their route once and never copied, and small ones
+ * are stored inline, so calling one never allocates.
+ */
+using Handler = core::Function<http::Response(const http::Request &)>;
+
 /**
  * @class Route
  * @brief Represents an individual route in the router.
  *
  * This class encapsulates the details of a route, including
- * the HTTP method, path, and handler function.
+ * the HTTP method, path, and handler function. The path pattern is compiled
+ * into a list of segments once, when the route is constructed, so matching a
+ * request is a plain segment-by-segment comparison. The method is interned as
+ * an http::Method, so comparing it is an integer test.
  */
 class Route {
  public:
@@ -25,59 +38,118 @@ class Route {
    * @param method The HTTP method (e.g., GET, POST).
    * @param path The path for the route (e.g., /home).
    * @param handler The handler function for the route.
+   * @param blocking True if the handler may block (e.g., on database I/O) and
+   * should run off the I/O thread.
+   *
+   * @throw std::runtime_error if a `*name` wildcard is not the last segment,
+   * or if the method is not an http::Method.
    */
-  Route(const std::string &method, const std::string &path,
-        const std::function<http::Response(const http::Request &)> &handler);
+  Route(const std::string &method, const std::string &path, Handler handler,
+        bool blocking = false);
 
   /**
    * @brief Checks if the route matches the given request.
    *
+   * Only the path of the request is matched against the pattern; the query
+   * string is ignored.
+   *
    * @param request The HTTP request to check.
    * @return True if the route matches the request, false otherwise.
    */
   bool matches(const http::Request &request) const;
 
   /**
-   * @brief Handles the request if it matches the route.
+   * @brief Checks if the compiled path pattern matches the given path.
+   *
+   * A single trailing slash on the path is ignored, each `:param` segment
+   * matches one non-empty path segment, and a trailing `*name` segment
+   * matches the non-empty rest of the path, slashes included.
+   *
+   * @param path The request path to match.
+   * @param captures Optional output receiving the value of each `:param` and
+   * `*name` segment, in pattern order. The values are views into @p path.
+   * @return True if the path matches the pattern, false otherwise.
+   */
+  bool matchPath(std::string_view path,
+                 std::vector<std::string_view> *captures = nullptr) const;
+
+  /**
+   * @brief Handles the request if its method matches the route.
    *
    * @param request The HTTP request to handle.
-   * @return The HTTP response generated by the handler.
+   * @return The HTTP response generated by the handler, or a 405 Method Not
+   * Allowed response naming the route's method if the request's differs.
    */
   http::Response handle(const http::Request &request) const;
 
   /**
    * @brief Gets the HTTP method of the route.
    *
-   * @return The HTTP method as a string.
+   * @return A reference to the HTTP method.
+   */
+  const std::string &getMethod() const;
+
+  /**
+   * @brief Gets the HTTP method of the route, interned.
+   *
+   * @return The method.
    */
-  std::string getMethod() const;
+  http::Method getMethodId() const;
 
   /**
    * @brief Gets the path of the route.
    *
-   * @return The path as a string.
+   * @return A reference to the path.
    */
-  std::string getPath() const;
+  const std::string &getPath() const;
+
+  /**
+   * @brief Gets the names of the `:param` and `*name` segments of the route.
+   *
+   * @return The parameter names, in pattern order and without the leading ':'
+   * or '*'.
+   */
+  const std::vector<std::string> &getParameterNames() const;
+
+  /**
+   * @brief Checks whether the handler may block.
+   *
+   * @return True if the handler should run on a worker thread.
+   */
+  bool isBlocking() const;
 
   /**
    * @brief Gets the handler function of the route.
    *
-   * @return The handler function.
+   * @return A reference to the handler function.
    */
-  std::function<http::Response(const http::Request &)> getHandler() const;
+  const Handler &getHandler() const;
 
  private:
-  std::string method;  ///< The HTTP method of the route.
-  std::string path;    ///< The path of the route.
-  std::function<http::Response(const http::Request &)>
-      handler;  ///< The handler function for this route.
+  /**
+   * @brief A single compiled segment of the path pattern.
+   */
+  struct Segment {
+    bool parameter;     ///< True if the segment is a `:param` capture.
+    bool wildcard;      ///< True if the segment is a trailing `*name` capture.
+    std::string value;  ///< The literal text, or the parameter name.
+  };
+
+  std::string method;     ///< The HTTP method of the route.
+  http::Method methodId;  ///< The interned method.
+  std::string path;       ///< The path of the route.
+  Handler handler;                ///< The handler function for this route.
+  bool blocking;                  ///< True if the handler may block.
+  std::vector<Segment> segments;  ///< The compiled path pattern.
+  std::vector<std::string>
+      parameterNames;  ///< The names of the `:param` and `*name` segments.
 
   /**
-   * @brief Helper function to convert path parameters to a regex pattern.
+   * @brief Helper function to split the path pattern into segments.
    *
-   * @return The regex pattern as a string.
+   * @param path The path pattern to compile.
    */
-  std::string pathToRegex(const std::string &path) const;
+  void compile(const std::string &path);
 };
 
 }  // namespace router
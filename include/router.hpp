@@ -1,14 +1,16 @@
 #ifndef ROUTER_HPP
 #define ROUTER_HPP
 
-#include <functional>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
+#include "method.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "route.hpp"
+#include "tree.hpp"
 
 namespace router {
 
@@ -32,18 +34,76 @@ class Router {
    * @param path The path pattern (e.g., "/users/:userId") associated with the
    * route.
    * @param handler A function that handles the request and produces a response.
+   * @param blocking True if the handler may block and should run on a worker
+   * thread when served by a Server.
    */
-  void addRoute(
-      const std::string &method, const std::string &path,
-      const std::function<http::Response(const http::Request &)> &handler);
+  void addRoute(const std::string &method, const std::string &path,
+                Handler handler, bool blocking = false);
+
+  /**
+   * Finds the route matching an incoming HTTP request.
+   *
+   * Only the path of the request is matched, without its query string, and
+   * the method is compared as an interned http::Method. On a match, the route
+   * parameters captured from the path are recorded on the request.
+   *
+   * @param request The incoming HTTP request to be routed.
+   * @return The matching route, or nullptr if no route matches.
+   */
+  const Route *resolve(const http::Request &request) const;
+
+  /**
+   * Builds the default response for requests that match no route.
+   *
+   * @param resource The memory resource the response allocates from, usually
+   * that of the request.
+   * @return A 404 Not Found response.
+   */
+  static http::Response notFound(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Builds the response for requests whose path matches routes registered
+   * for other methods only.
+   *
+   * @param allowed The methods the path has routes for.
+   * @param resource The memory resource the response allocates from, usually
+   * that of the request.
+   * @return A 405 Method Not Allowed response with an Allow header.
+   */
+  static http::Response methodNotAllowed(
+      http::MethodSet allowed,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Builds the response for a request no route matched, given the methods
+   * its path has routes for.
+   *
+   * @param allowed The methods the path has routes for, possibly none.
+   * @param resource The memory resource the response allocates from, usually
+   * that of the request.
+   * @return A 405 Method Not Allowed response if any methods are allowed, or
+   * a 404 Not Found response otherwise.
+   */
+  static http::Response unmatched(
+      http::MethodSet allowed,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Builds the response for a request that resolve() found no route for.
+   *
+   * @param request The unrouted request.
+   * @return A 405 Method Not Allowed response if routes for other methods
+   * match the request's path, or a 404 Not Found response otherwise.
+   */
+  http::Response fallback(const http::Request &request) const;
 
   /**
    * Handles an incoming HTTP request by routing it to the appropriate handler.
    *
-   * This method iterates through all registered routes and attempts to find a
-   * match based on the request's method and path. If a match is found, the
-   * corresponding handler is invoked, and its response is returned. If no match
-   * is found, a default 404 Not Found response is returned.
+   * This method looks the request's method and path up in the route tree. If a
+   * match is found, the corresponding handler is invoked, and its response is
+   * returned. Otherwise the response comes from fallback().
    *
    * @param request The incoming HTTP request to be handled.
    * @return An http::Response object representing the response to the request.
@@ -53,6 +113,7 @@ class Router {
  private:
   std::vector<router::Route>
       routes;  ///< A vector of all routes registered with the router.
+  Tree tree;   ///< The radix tree indexing routes by method and path.
 };
 
 }  // namespace router
@@ -0,0 +1,47 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @namespace http::scan
+ * @brief Byte search used to find delimiters in HTTP messages.
+ *
+ * Searches go through memchr(3), which the C library already implements with
+ * the widest vector instructions the CPU supports.
+ */
+namespace scan {
+
+/**
+ * @brief Finds the first occurrence of a byte.
+ *
+ * @param text The text to search.
+ * @param byte The byte to look for.
+ * @param from The offset to start searching at.
+ * @return The offset of the byte, or std::string_view::npos.
+ */
+std::size_t find(std::string_view text, char byte, std::size_t from = 0);
+
+/**
+ * @brief Finds the next line feed, which ends both CRLF and bare LF lines.
+ *
+ * @param text The text to search.
+ * @param from The offset to start searching at.
+ * @return The offset of the '\n', or std::string_view::npos.
+ */
+inline std::size_t findLineEnd(std::string_view text, std::size_t from = 0) {
+  return find(text, '\n', from);
+}
+
+}  // namespace scan
+
+}  // namespace http
+
+#endif  // SCAN_HPP
@@ -0,0 +1,158 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app.hpp"
+#include "executor.hpp"
+
+namespace core {
+
+class Reactor;
+
+/**
+ * @brief Tunables for a Server and its reactors.
+ */
+struct ServerOptions {
+  /**
+   * @brief The number of reactor threads, each with its own event loop and
+   * listening socket. 0 means one per available core.
+   */
+  std::size_t threads = 1;
+
+  /**
+   * @brief Pins each reactor thread to its own core when running more than one
+   * reactor.
+   */
+  bool pinThreads = true;
+
+  /**
+   * @brief The number of worker threads running handlers registered through
+   * App::registerBlockingRoute. 0 runs them on the reactor threads.
+   */
+  std::size_t workerThreads = 4;
+
+  /**
+   * @brief How long stop() waits for in-flight requests before closing their
+   * connections.
+   */
+  std::chrono::milliseconds drainTimeout = std::chrono::seconds(5);
+
+  /**
+   * @brief How long a connection may sit between requests before it is
+   * closed. 0 keeps idle connections open indefinitely.
+   */
+  std::chrono::milliseconds idleTimeout = std::chrono::seconds(5);
+
+  /**
+   * @brief How long a client has to send the request line and headers once it
+   * has started a request, however steadily the bytes trickle in. Expiry is
+   * answered with 408. 0 disables the limit.
+   */
+  std::chrono::milliseconds headerTimeout = std::chrono::seconds(10);
+
+  /**
+   * @brief How long the request body may stall between reads. Expiry is
+   * answered with 408. 0 disables the limit.
+   */
+  std::chrono::milliseconds bodyTimeout = std::chrono::seconds(30);
+
+  /**
+   * @brief How long writing a response may stall because the client is not
+   * reading it. Expiry closes the connection. 0 disables the limit.
+   */
+  std::chrono::milliseconds writeTimeout = std::chrono::seconds(30);
+
+  /**
+   * @brief The number of requests served on one connection before it is
+   * closed. 0 means no limit.
+   */
+  std::size_t maxRequestsPerConnection = 1000;
+};
+
+/**
+ * @class Server
+ * @brief Serves an application over HTTP/1.1.
+ *
+ * The server owns the listening sockets and the reactors that accept and
+ * serve connections on them. With more than one thread, every reactor binds
+ * its own socket to the same port through SO_REUSEPORT, so the kernel spreads
+ * connections across them and reactors share nothing but the read-only App.
+ * A typical program registers its routes on an App, then calls listen() and
+ * run().
+ */
+class Server {
+ public:
+  /**
+   * @brief Constructs a server for the given application.
+   *
+   * @param app The application whose routes handle incoming requests. It must
+   * outlive the server and must not be modified while the server runs.
+   * @param options The server tunables.
+   */
+  Server(const App &app, const ServerOptions &options = ServerOptions());
+
+  /**
+   * @brief Stops serving and releases the listening sockets.
+   */
+  ~Server();
+
+  Server(const Server &) = delete;
+  Server &operator=(const Server &) = delete;
+
+  /**
+   * @brief Binds the listening sockets to the given address.
+   *
+   * @param host The IPv4 address to bind to (e.g., 127.0.0.1, 0.0.0.0).
+   * @param port The port to bind to, or 0 to pick an ephemeral port.
+   *
+   * @throw std::runtime_error if a socket cannot be created or bound.
+   */
+  void listen(const std::string &host, int port);
+
+  /**
+   * @brief Gets the port the server is listening on.
+   *
+   * @return The bound port, useful after listening on port 0.
+   */
+  int getPort() const;
+
+  /**
+   * @brief Serves connections until stop() is called and every reactor has
+   * drained.
+   *
+   * A single reactor runs on the calling thread; several reactors each run on
+   * a thread of their own while the calling thread waits for them.
+   *
+   * @throw std::runtime_error if listen() has not been called.
+   */
+  void run();
+
+  /**
+   * @brief Gracefully stops the server. Safe to call from any thread.
+   *
+   * Reactors stop accepting connections and close idle ones immediately, then
+   * finish the requests already in flight before run() returns, waiting at
+   * most ServerOptions::drainTimeout.
+   */
+  void stop();
+
+ private:
+  const App &app;         ///< The application being served.
+  ServerOptions options;  ///< The server tunables.
+  int port;               ///< The bound port.
+  std::vector<std::unique_ptr<Reactor>>
+      reactors;  ///< The event loops, one per thread.
+  std::unique_ptr<Executor>
+      executor;  ///< The pool running blocking handlers. Declared after the
+                 ///< reactors so that it is joined before they are destroyed.
+};
+
+}  // namespace core
+
+#endif  // SERVER_HPP
@@ -0,0 +1,199 @@
+#ifndef STATEMENT_HPP
+#define STATEMENT_HPP
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace db {
+
+class Connection;
+
+/**
+ * @class Statement
+ * @brief A prepared statement checked out of a Connection's cache.
+ *
+ * Statements come from Connection::prepare(). Values are bound and columns
+ * read in their SQLite types, so nothing is converted to or from strings
+ * along the way. When the Statement is destroyed, the underlying
+ * sqlite3_stmt is reset, its bindings are cleared, and it goes back to the
+ * cache for the next prepare() of the same SQL. A Statement must not outlive
+ * its connection.
+ */
+class Statement {
+ public:
+  Statement(Statement &&other) noexcept;
+  Statement &operator=(Statement &&other) noexcept;
+  Statement(const Statement &) = delete;
+  Statement &operator=(const Statement &) = delete;
+
+  /**
+   * @brief Returns the statement to its connection's cache.
+   */
+  ~Statement();
+
+  /**
+   * @brief Binds an integer to a parameter.
+   *
+   * @param index The 1-based parameter index.
+   * @param value The value.
+   * @return This statement, for chaining.
+   *
+   * @throw std::runtime_error if the index is out of range.
+   */
+  Statement &bind(int index, int value);
+
+  /**
+   * @brief Binds a 64-bit integer to a parameter.
+   */
+  Statement &bind(int index, std::int64_t value);
+
+  /**
+   * @brief Binds an unsigned integer to a parameter.
+   *
+   * SQLite integers are signed 64-bit, so unsigned values are bound as such
+   * rather than converted implicitly to whichever overload is closest.
+   *
+   * @throw std::runtime_error if the value does not fit in 64 signed bits,
+   * or the index is out of range.
+   */
+  Statement &bind(int index, unsigned int value);
+  Statement &bind(int index, unsigned long value);
+  Statement &bind(int index, unsigned long long value);
+
+  /**
+   * @brief Binds a floating-point number to a parameter.
+   */
+  Statement &bind(int index, double value);
+
+  /**
+   * @brief Binds text to a parameter, without copying it.
+   *
+   * @param index The 1-based parameter index.
+   * @param value The text, which must stay valid until the statement is
+   * reset or destroyed.
+   * @return This statement, for chaining.
+   */
+  Statement &bind(int index, std::string_view value);
+
+  /**
+   * @brief Refuses temporary strings, which would be gone before the
+   * statement runs; use bindCopy() for them.
+   */
+  template <typename Text,
+            typename = std::enable_if_t<std::is_same_v<Text, std::string>>>
+  Statement &bind(int index, Text &&value) = delete;
+
+  /**
+   * @brief Binds text to a parameter, copying it into the statement.
+   *
+   * @param index The 1-based parameter index.
+   * @param value The text, which need not outlive the call.
+   * @return This statement, for chaining.
+   */
+  Statement &bindCopy(int index, std::string_view value);
+
+  /**
+   * @brief Binds NULL to a parameter.
+   */
+  Statement &bind(int index, std::nullptr_t);
+
+  /**
+   * @brief Advances to the next row.
+   *
+   * @return True if a row is available, false once the statement is done.
+   *
+   * @throw std::runtime_error if the statement fails.
+   */
+  bool step();
+
+  /**
+   * @brief Runs the statement to completion, discarding any rows.
+   *
+   * @throw std::runtime_error if the statement fails.
+   */
+  void execute();
+
+  /**
+   * @brief Rewinds the statement and clears its bindings, so that it can be
+   * bound and run again.
+   */
+  void reset();
+
+  /**
+   * @brief Gets the number of columns in the result.
+   */
+  int getColumnCount() const;
+
+  /**
+   * @brief Checks whether a column of the current row is NULL.
+   *
+   * @param column The 0-based column index.
+   */
+  bool isNull(int column) const;
+
+  /**
+   * @brief Reads a column of the current row as a 64-bit integer.
+   *
+   * @param column The 0-based column index.
+   */
+  std::int64_t getInt(int column) const;
+
+  /**
+   * @brief Reads a column of the current row as a floating-point number.
+   *
+   * @param column The 0-based column index.
+   */
+  double getDouble(int column) const;
+
+  /**
+   * @brief Reads a column of the current row as text.
+   *
+   * @param column The 0-based column index.
+   * @return A view of the text, valid until the next step() or reset(); empty
+   * for NULL.
+   */
+  std::string_view getText(int column) const;
+
+  /**
+   * @brief Gets the underlying sqlite3_stmt* handle.
+   *
+   * @return The handle, owned by the statement or its connection.
+   */
+  sqlite3_stmt *get_stmt() const;
+
+ private:
+  friend class Connection;
+
+  /**
+   * @brief A prepared statement kept in a connection's cache.
+   */
+  struct Entry {
+    std::string sql;          ///< The SQL text the statement was prepared from.
+    sqlite3_stmt *statement;  ///< The prepared statement.
+    bool leased;              ///< Set while a Statement is using it.
+  };
+
+  sqlite3_stmt *statement;  ///< The prepared statement.
+  Entry *entry;  ///< The cache entry, or nullptr for a one-off statement.
+
+  Statement(sqlite3_stmt *statement, Entry *entry);
+
+  /**
+   * @brief Checks the result of a bind call.
+   */
+  Statement &check(int result);
+
+  /**
+   * @brief Resets the statement and returns it, or finalizes a one-off.
+   */
+  void release();
+};
+
+}  // namespace db
+
+#endif  // STATEMENT_HPP
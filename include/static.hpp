@@ -0,0 +1,87 @@
+#ifndef HTTP_STATIC_HPP
+#define HTTP_STATIC_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "file.hpp"
+#include "request.hpp"
+#include "response.hpp"
+
+/**
+ * @namespace http
+ * Namespace for HTTP related classes and functions.
+ */
+namespace http {
+
+/**
+ * @class StaticFiles
+ * @brief Serves the files below a directory.
+ *
+ * Responses carry the file as a sendfile(2) body rather than a string, so the
+ * server copies nothing through user space. ETag and Last-Modified
+ * validators answer conditional requests with 304, and single byte ranges are
+ * answered with 206 (or 416 when unsatisfiable). Open descriptors and stat
+ * results are kept in a sharded LRU FileCache shared by every copy of the
+ * handler.
+ */
+class StaticFiles {
+ public:
+  /**
+   * @brief Constructs a handler for a directory.
+   *
+   * @param root The directory to serve.
+   * @param cacheCapacity The maximum number of files kept open.
+   * @param revalidateAfter How long cached stat results are trusted.
+   */
+  StaticFiles(std::string root, std::size_t cacheCapacity = 256,
+              std::chrono::milliseconds revalidateAfter =
+                  std::chrono::seconds(1));
+
+  /**
+   * @brief Serves a file named by a path relative to the root.
+   *
+   * A HEAD request gets the same status and headers as a GET, including
+   * Content-Length, but no body.
+   *
+   * @param request The request, consulted for its method and for conditional
+   * and range headers.
+   * @param path The percent-encoded path of the file, relative to the root.
+   * @return The file response, or a 304, 404 or 416 response.
+   */
+  Response serve(const Request &request, std::string_view path) const;
+
+  /**
+   * @brief Serves the file captured by a `*path` route segment.
+   *
+   * @param request The routed request.
+   * @return The response, as for serve().
+   */
+  Response operator()(const Request &request) const;
+
+  /**
+   * @brief Gets the cache of open files.
+   *
+   * @return The cache shared by every copy of the handler.
+   */
+  const FileCache &getCache() const;
+
+  /**
+   * @brief Guesses the Content-Type of a file from its extension.
+   *
+   * @param path The file name or path.
+   * @return The media type, or application/octet-stream.
+   */
+  static std::string_view contentType(std::string_view path);
+
+ private:
+  std::string root;                  ///< The directory being served.
+  std::shared_ptr<FileCache> cache;  ///< The open files.
+};
+
+}  // namespace http
+
+#endif  // HTTP_STATIC_HPP
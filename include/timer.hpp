@@ -0,0 +1,196 @@
+#ifndef TIMER_HPP
+#define TIMER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "function.hpp"
+
+namespace core {
+
+class TimerWheel;
+
+/**
+ * @class Timer
+ * @brief A deadline that can be armed on a TimerWheel.
+ *
+ * Timers are intrusive: the links that place a timer in its wheel slot live in
+ * the timer itself, so arming and cancelling never allocate. A timer is
+ * usually embedded in the object it times out, such as a connection, and is
+ * cancelled automatically when destroyed.
+ */
+class Timer {
+ public:
+  using Callback = Function<void()>;
+
+  /**
+   * @brief Constructs a disarmed timer without a callback.
+   */
+  Timer();
+
+  /**
+   * @brief Constructs a disarmed timer.
+   *
+   * @param callback Run by TimerWheel::advance() when the timer expires.
+   */
+  explicit Timer(Callback callback);
+
+  /**
+   * @brief Cancels the timer if it is armed.
+   */
+  ~Timer();
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+  /**
+   * @brief Sets the function run when the timer expires.
+   *
+   * @param callback The callback.
+   */
+  void setCallback(Callback callback);
+
+  /**
+   * @brief Checks whether the timer is armed.
+   *
+   * @return True from arming until the timer fires or is cancelled.
+   */
+  bool isArmed() const;
+
+ private:
+  friend class TimerWheel;
+
+  Timer *previous;     ///< The previous timer in the slot.
+  Timer *next;         ///< The next timer in the slot.
+  TimerWheel *wheel;   ///< The wheel the timer is armed on, if any.
+  std::uint64_t tick;  ///< The tick at which the timer expires.
+  std::uint16_t slot;  ///< The wheel slot holding the timer.
+  Callback callback;   ///< Run on expiry.
+};
+
+/**
+ * @class TimerWheel
+ * @brief A hierarchical timing wheel with O(1) arm and cancel.
+ *
+ * Time is divided into ticks of a fixed resolution. The wheel has four levels
+ * of 64 slots; level n covers deadlines up to 64^(n+1) ticks away, so with
+ * millisecond ticks it spans about 4.6 hours, and later deadlines are parked
+ * in the last level until they come into range. Arming hashes the deadline
+ * straight to a slot and cancelling unlinks the timer, both in constant time
+ * however many timers are armed. Timers in higher levels are cascaded down a
+ * level each time the level below wraps around, and fire from the lowest one.
+ *
+ * A bitmap of occupied slots per level lets advance() skip straight to the
+ * next tick with work to do, and nextDeadline() tell an event loop how long
+ * it may sleep. Timers never fire early; they fire at most one tick late.
+ *
+ * The wheel is not thread-safe. Callbacks run inside advance() and may arm,
+ * cancel or destroy any timer, including their own.
+ */
+class TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructs an empty wheel.
+   *
+   * @param start The time of tick 0.
+   * @param resolution The length of a tick.
+   */
+  explicit TimerWheel(
+      Clock::time_point start = Clock::now(),
+      std::chrono::milliseconds resolution = std::chrono::milliseconds(1));
+
+  /**
+   * @brief Disarms every timer still on the wheel, without running it.
+   */
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel &) = delete;
+  TimerWheel &operator=(const TimerWheel &) = delete;
+
+  /**
+   * @brief Arms a timer, moving it if it is already armed.
+   *
+   * @param timer The timer, which must outlive its time on the wheel or
+   * cancel itself by being destroyed.
+   * @param deadline When the timer should fire. Deadlines that have already
+   * passed fire on the next advance().
+   */
+  void arm(Timer &timer, Clock::time_point deadline);
+
+  /**
+   * @brief Disarms a timer. Does nothing if it is not armed.
+   *
+   * @param timer The timer.
+   */
+  void cancel(Timer &timer);
+
+  /**
+   * @brief Moves the wheel forward, firing every timer that has expired.
+   *
+   * @param now The current time. Times earlier than the last advance() are
+   * ignored.
+   * @return The number of timers fired.
+   */
+  std::size_t advance(Clock::time_point now);
+
+  /**
+   * @brief Gets the next time at which advance() has work to do.
+   *
+   * This is the earliest deadline, or earlier if timers have to be cascaded
+   * down a level first, so an event loop can sleep until then.
+   *
+   * @return The time, or Clock::time_point::max() if no timer is armed.
+   */
+  Clock::time_point nextDeadline() const;
+
+  /**
+   * @brief Gets the number of armed timers.
+   *
+   * @return The number of timers on the wheel.
+   */
+  std::size_t size() const;
+
+ private:
+  static constexpr unsigned kLevels = 4;     ///< The number of levels.
+  static constexpr unsigned kSlotBits = 6;   ///< log2 of slots per level.
+  static constexpr unsigned kSlots = 1u << kSlotBits;  ///< Slots per level.
+  static constexpr std::uint64_t kSlotMask = kSlots - 1;
+  static constexpr std::uint64_t kNever = ~std::uint64_t(0);  ///< No tick.
+
+  Clock::time_point start;               ///< The time of tick 0.
+  Clock::duration resolution;            ///< The length of a tick.
+  std::uint64_t current;                 ///< The last tick processed.
+  std::size_t count;                     ///< The number of armed timers.
+  std::array<Timer *, kLevels * kSlots> slots;  ///< The slot lists.
+  std::array<std::uint64_t, kLevels> occupied;  ///< Non-empty slot bits.
+
+  /**
+   * @brief Links a timer into the slot for its tick, relative to current.
+   */
+  void insert(Timer &timer);
+
+  /**
+   * @brief Unlinks a timer from its slot.
+   */
+  void unlink(Timer &timer);
+
+  /**
+   * @brief Re-inserts every timer of a higher-level slot.
+   */
+  void cascade(unsigned level, std::uint64_t index);
+
+  /**
+   * @brief Gets the next tick with a timer to fire or cascade.
+   *
+   * @return The tick, or kNever if the wheel is empty.
+   */
+  std::uint64_t nextTick() const;
+};
+
+}  // namespace core
+
+#endif  // TIMER_HPP
@@ -0,0 +1,135 @@
+#ifndef TREE_HPP
+#define TREE_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "method.hpp"
+
+namespace router {
+
+/**
+ * @class Tree
+ * @brief A compressed radix tree mapping method and path to a route index.
+ *
+ * Each edge of the tree is labelled with one or more static path segments
+ * (chains of single-child static nodes are merged into one edge), and each
+ * node may additionally have a single `:param` child. Lookup walks the request
+ * path once, so its cost depends on the path length rather than on the number
+ * of registered routes. Static segments take precedence over parameters, with
+ * backtracking when a static branch dead-ends.
+ *
+ * The routes ending at a node are kept per method, with a bitmask of the
+ * methods present, so checking a request's method is a single bit test.
+ * Lookups can also report the methods registered for a path whose method did
+ * not match, for answering 405 Method Not Allowed.
+ */
+class Tree {
+ public:
+  /**
+   * @brief Value returned by find() when no route matches.
+   */
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Inserts a route into the tree.
+   *
+   * If a route with the same method and path pattern already exists, the
+   * earlier one is kept, mirroring first-match registration order.
+   *
+   * @param method The HTTP method (e.g., GET, POST) of the route.
+   * @param path The path pattern (e.g., "/users/:userId") of the route.
+   * @param index The index of the route in the owner's route table.
+   *
+   * @throw std::runtime_error if the method is not an http::Method.
+   */
+  void insert(const std::string &method, const std::string &path,
+              std::size_t index);
+
+  /**
+   * @brief Inserts a route into the tree.
+   *
+   * @param method The HTTP method of the route.
+   * @param path The path pattern (e.g., "/users/:userId") of the route.
+   * @param index The index of the route in the owner's route table.
+   *
+   * @throw std::runtime_error if the method is http::Method::Count.
+   */
+  void insert(http::Method method, const std::string &path, std::size_t index);
+
+  /**
+   * @brief Finds the route matching the given method and path.
+   *
+   * The method is compared case-insensitively and a single trailing slash on
+   * the path is ignored.
+   *
+   * @param method The HTTP method of the request.
+   * @param path The request path.
+   * @param captures Optional output receiving the value of each `:param` and
+   * `*name` segment, in pattern order. The values are views into @p path.
+   * @return The index of the matching route, or npos if none matches.
+   */
+  std::size_t find(std::string_view method, std::string_view path,
+                   std::vector<std::string_view> *captures = nullptr) const;
+
+  /**
+   * @brief Finds the route matching the given method and path.
+   *
+   * @param method The interned HTTP method of the request.
+   * @param path The request path, without the query string.
+   * @param captures Optional output receiving the value of each `:param` and
+   * `*name` segment, in pattern order. The values are views into @p path.
+   * @param allowed Optional output to which the methods of every route whose
+   * pattern matched the path are added, whatever their method. Left as it
+   * was if no pattern matched.
+   * @return The index of the matching route, or npos if none matches.
+   */
+  std::size_t find(http::Method method, std::string_view path,
+                   std::vector<std::string_view> *captures,
+                   http::MethodSet *allowed = nullptr) const;
+
+  /**
+   * @brief Removes every route from the tree.
+   */
+  void clear();
+
+ private:
+  /**
+   * @brief A node of the tree.
+   */
+  struct Node {
+    std::string label;  ///< Static segments of the incoming edge, '/'-joined.
+    std::vector<std::unique_ptr<Node>>
+        children;                     ///< Static children, sorted by label.
+    std::unique_ptr<Node> parameter;  ///< The `:param` child, if any.
+    std::unique_ptr<Node> wildcard;   ///< The trailing `*name` child, if any.
+    http::MethodSet methods = 0;  ///< The methods of routes ending here.
+    std::array<std::size_t, static_cast<std::size_t>(http::Method::Count)>
+        routes{};  ///< The route index per method present in methods.
+  };
+
+  Node root;  ///< The root node, matching the path "/".
+
+  /**
+   * @brief Recursively inserts the remaining pattern segments below a node.
+   */
+  static void insert(Node &node, const std::vector<std::string_view> &segments,
+                     std::size_t position, http::Method method,
+                     std::size_t index);
+
+  /**
+   * @brief Recursively matches the remaining path below a node.
+   */
+  static std::size_t find(const Node &node, http::Method method,
+                          std::string_view rest,
+                          std::vector<std::string_view> *captures,
+                          http::MethodSet *allowed);
+};
+
+}  // namespace router
+
+#endif  // TREE_HPP
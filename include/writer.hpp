@@ -0,0 +1,203 @@
+#ifndef WRITER_HPP
+#define WRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "connection.hpp"
+
+namespace db {
+
+/**
+ * @brief Configuration for a Writer.
+ */
+struct WriterOptions {
+  /**
+   * @brief The most writes committed together in one transaction.
+   */
+  std::size_t maxBatch = 256;
+
+  /**
+   * @brief How long the first write of a batch waits for others to join it
+   * before the batch is committed anyway. 0 commits whatever is queued as
+   * soon as the previous commit is done.
+   */
+  std::chrono::microseconds maxDelay = std::chrono::microseconds(500);
+};
+
+/**
+ * @class Writer
+ * @brief Commits writes from many threads together, one transaction at a
+ * time.
+ *
+ * Each autocommit write to SQLite waits for its own sync to disk, so
+ * concurrent writers are capped at the disk's sync rate. A Writer owns the
+ * writer connection on a thread of its own and runs submitted writes in
+ * batches: writes queued within maxDelay of the first one, up to maxBatch of
+ * them, share one transaction and so one sync. Every write runs inside its
+ * own savepoint, so one that throws is rolled back alone and the rest of its
+ * batch still commits.
+ *
+ * Callers get a future that completes once their write is committed, with
+ * the write's own result or exception, or with the commit's exception if the
+ * batch as a whole fails.
+ */
+class Writer {
+ public:
+  /**
+   * @brief Starts the writer thread.
+   *
+   * @param connection The writer connection, used only by the writer thread
+   * from now on, e.g. one leased with Pool::write() for the Writer's lifetime.
+   * @param options The batching limits.
+   */
+  explicit Writer(Connection &connection, WriterOptions options = {});
+
+  /**
+   * @brief Commits every queued write, then stops the writer thread.
+   */
+  ~Writer();
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  /**
+   * @brief Queues a write. Safe to call from any thread.
+   *
+   * @param write A callable taking the `Connection &` and returning the
+   * write's result (e.g., the row id it inserted), or void. It runs on the
+   * writer thread inside the batch's transaction, and must not begin, commit
+   * or roll back transactions itself.
+   * @return A future for the result, ready once the write is committed.
+   */
+  template <typename Callable>
+  auto submit(Callable &&write)
+      -> std::future<std::invoke_result_t<std::decay_t<Callable> &,
+                                          Connection &>> {
+    using Result =
+        std::invoke_result_t<std::decay_t<Callable> &, Connection &>;
+    auto job = std::make_unique<TypedJob<std::decay_t<Callable>, Result>>(
+        std::forward<Callable>(write));
+    std::future<Result> future = job->promise.get_future();
+    enqueue(std::move(job));
+    return future;
+  }
+
+  /**
+   * @brief Gets the number of transactions committed so far.
+   *
+   * @return The number of batches.
+   */
+  std::uint64_t getBatchCount() const;
+
+  /**
+   * @brief Gets the number of writes run so far.
+   *
+   * @return The number of writes, including those that failed.
+   */
+  std::uint64_t getWriteCount() const;
+
+ private:
+  /**
+   * @brief A queued write, run in one step and completed in another once the
+   * batch has committed.
+   */
+  struct Job {
+    virtual ~Job() = default;
+
+    /**
+     * @brief Runs the write, keeping its result or exception.
+     *
+     * @return False if the write threw.
+     */
+    virtual bool run(Connection &connection) = 0;
+
+    /**
+     * @brief Completes the caller's future with the kept result, or with
+     * error if the batch failed to commit.
+     */
+    virtual void complete(std::exception_ptr error) = 0;
+  };
+
+  template <typename Callable, typename Result>
+  struct TypedJob : Job {
+    Callable write;                ///< The write.
+    std::promise<Result> promise;  ///< The caller's future's promise.
+    std::conditional_t<std::is_void_v<Result>, bool,
+                       std::optional<Result>>
+        result{};                  ///< The result, until completion.
+    std::exception_ptr failure;    ///< What the write threw, if anything.
+
+    explicit TypedJob(Callable &&write) : write(std::move(write)) {}
+    explicit TypedJob(const Callable &write) : write(write) {}
+
+    bool run(Connection &connection) override {
+      try {
+        if constexpr (std::is_void_v<Result>) {
+          write(connection);
+          result = true;
+        } else {
+          result.emplace(write(connection));
+        }
+        return true;
+      } catch (...) {
+        failure = std::current_exception();
+        return false;
+      }
+    }
+
+    void complete(std::exception_ptr error) override {
+      if (failure) {
+        promise.set_exception(failure);
+      } else if (error) {
+        promise.set_exception(error);
+      } else if constexpr (std::is_void_v<Result>) {
+        promise.set_value();
+      } else {
+        promise.set_value(std::move(*result));
+      }
+    }
+  };
+
+  Connection &connection;  ///< The writer connection.
+  WriterOptions options;   ///< The batching limits.
+  std::mutex mutex;        ///< Guards queue and stopping.
+  std::condition_variable queued;       ///< Wakes the writer thread.
+  std::deque<std::unique_ptr<Job>> queue;  ///< Writes not yet taken.
+  bool stopping;                        ///< Set when the Writer is destroyed.
+  std::atomic<std::uint64_t> batches;   ///< Transactions committed.
+  std::atomic<std::uint64_t> writes;    ///< Writes run.
+  std::thread thread;                   ///< The writer thread.
+
+  /**
+   * @brief Queues a job and wakes the writer thread.
+   */
+  void enqueue(std::unique_ptr<Job> job);
+
+  /**
+   * @brief The loop run by the writer thread.
+   */
+  void work();
+
+  /**
+   * @brief Runs and commits one batch, then completes its futures.
+   */
+  void commit(std::vector<std::unique_ptr<Job>> &batch);
+};
+
+}  // namespace db
+
+#endif  // WRITER_HPP
@@ -1,27 +1,86 @@
 #include "app.hpp"
 
-#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "middleware.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "route.hpp"
 #include "router.hpp"
+#include "static.hpp"
 
 namespace core {
 
 App::App() {
-  // Initialize the App if necessary
+  pipelines.emplace_back(std::vector<Middleware>(),
+                         [this](const http::Request &request) {
+                           return router.fallback(request);
+                         });
 }
 
-void App::registerRoute(
-    const std::string &method, const std::string &path,
-    const std::function<http::Response(const http::Request &)> &handler) {
-  router.addRoute(method, path, handler);
+void App::registerRoute(const std::string &method, const std::string &path,
+                        router::Handler handler) {
+  router.addRoute(method, path, compose({}, std::move(handler)));
+}
+
+void App::registerRoute(const std::string &method, const std::string &path,
+                        std::vector<Middleware> middleware,
+                        router::Handler handler) {
+  router.addRoute(method, path,
+                  compose(std::move(middleware), std::move(handler)));
+}
+
+void App::registerBlockingRoute(const std::string &method,
+                                const std::string &path,
+                                router::Handler handler) {
+  router.addRoute(method, path, compose({}, std::move(handler)), true);
+}
+
+void App::registerStatic(const std::string &prefix,
+                         const std::string &directory,
+                         std::size_t cacheCapacity) {
+  std::string path = prefix;
+  while (!path.empty() && path.back() == '/') {
+    path.pop_back();
+  }
+  http::StaticFiles files(directory, cacheCapacity);
+  router.addRoute("GET", path + "/*path", compose({}, files));
+  router.addRoute("HEAD", path + "/*path", compose({}, std::move(files)));
+}
+
+void App::use(Middleware middleware) {
+  this->middleware.push_back(std::move(middleware));
+  for (Pipeline &pipeline : pipelines) {
+    pipeline.wrap(global());
+  }
+}
+
+http::Response App::fallback(const http::Request &request) const {
+  return pipelines.front()(request);
 }
 
 router::Router &App::getRouter() { return router; }
 
 const router::Router &App::getRouter() const { return router; }
 
+router::Handler App::compose(std::vector<Middleware> middleware,
+                             router::Handler handler) {
+  Pipeline &pipeline =
+      pipelines.emplace_back(std::move(middleware), std::move(handler));
+  pipeline.wrap(global());
+  return [&pipeline](const http::Request &request) {
+    return pipeline(request);
+  };
+}
+
+std::vector<const Middleware *> App::global() const {
+  std::vector<const Middleware *> layers;
+  for (const Middleware &layer : middleware) {
+    layers.push_back(&layer);
+  }
+  return layers;
+}
+
 }  // namespace core
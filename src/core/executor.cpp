@@ -0,0 +1,95 @@
+#include "executor.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+namespace {
+
+/**
+ * The executor and worker index of the calling thread, if it is a worker.
+ */
+thread_local const Executor *currentExecutor = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+}  // namespace
+
+Executor::Executor(std::size_t threads)
+    : next(0), pending(0), stopping(false) {
+  threads = std::max<std::size_t>(1, threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    this->threads.emplace_back([this, i] { work(i); });
+  }
+}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(idleMutex);
+    stopping = true;
+  }
+  idle.notify_all();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void Executor::submit(Task task) {
+  pending.fetch_add(1, std::memory_order_release);
+  std::size_t index =
+      currentExecutor == this
+          ? currentWorker
+          : next.fetch_add(1, std::memory_order_relaxed) % workers.size();
+  {
+    Worker &worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+
+  // Taking the lock orders the increment before a worker's predicate check
+  { std::lock_guard<std::mutex> lock(idleMutex); }
+  idle.notify_one();
+}
+
+std::size_t Executor::size() const { return workers.size(); }
+
+void Executor::work(std::size_t index) {
+  currentExecutor = this;
+  currentWorker = index;
+
+  Task task;
+  while (true) {
+    if (take(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(idleMutex);
+    idle.wait(lock, [this] {
+      return stopping || pending.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping && pending.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+bool Executor::take(std::size_t index, Task &task) {
+  // Own deque first, then steal from the other workers, oldest task first
+  for (std::size_t offset = 0; offset < workers.size(); ++offset) {
+    Worker &worker = *workers[(index + offset) % workers.size()];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+      pending.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace core
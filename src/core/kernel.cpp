@@ -13,7 +13,17 @@ Kernel::Kernel(const App &app) : app(app) {
 }
 
 http::Response Kernel::handleRequest(const http::Request &request) {
-  return app.getRouter().handle(request);
+  return dispatch(resolve(request), request);
+}
+
+const router::Route *Kernel::resolve(const http::Request &request) const {
+  return app.getRouter().resolve(request);
+}
+
+http::Response Kernel::dispatch(const router::Route *route,
+                                const http::Request &request) const {
+  // Routes carry the global middleware in their own composed chain
+  return route ? route->handle(request) : app.fallback(request);
 }
 
 }  // namespace core
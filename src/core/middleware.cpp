@@ -0,0 +1,70 @@
+#include "middleware.hpp"
+
+#include <utility>
+
+namespace core {
+
+Pipeline::Pipeline(std::vector<Middleware> middleware, Handler handler)
+    : middleware(std::move(middleware)), handler(std::move(handler)) {
+  compose();
+}
+
+Pipeline::Pipeline(Pipeline &&other) noexcept
+    : outer(std::move(other.outer)),
+      middleware(std::move(other.middleware)),
+      handler(std::move(other.handler)),
+      stages(std::move(other.stages)) {
+  // The stages moved with their buffer; only the innermost one points into
+  // the pipeline itself
+  if (!stages.empty()) {
+    stages.front().next = Next(handler);
+  }
+}
+
+Pipeline &Pipeline::operator=(Pipeline &&other) noexcept {
+  if (this != &other) {
+    outer = std::move(other.outer);
+    middleware = std::move(other.middleware);
+    handler = std::move(other.handler);
+    stages = std::move(other.stages);
+    if (!stages.empty()) {
+      stages.front().next = Next(handler);
+    }
+  }
+  return *this;
+}
+
+void Pipeline::use(Middleware middleware) {
+  this->middleware.push_back(std::move(middleware));
+  compose();
+}
+
+void Pipeline::wrap(std::vector<const Middleware *> outer) {
+  this->outer = std::move(outer);
+  compose();
+}
+
+http::Response Pipeline::operator()(const http::Request &request) const {
+  return stages.empty() ? handler(request) : stages.back()(request);
+}
+
+std::size_t Pipeline::size() const { return stages.size(); }
+
+bool Pipeline::empty() const { return stages.empty(); }
+
+void Pipeline::compose() {
+  // Built from the handler outwards, so that each stage links to one that
+  // already exists; the reserve keeps them all in place
+  stages.clear();
+  stages.reserve(outer.size() + middleware.size());
+  for (auto layer = middleware.rbegin(); layer != middleware.rend(); ++layer) {
+    stages.push_back(Stage{&*layer, stages.empty() ? Next(handler)
+                                                   : Next(stages.back())});
+  }
+  for (auto layer = outer.rbegin(); layer != outer.rend(); ++layer) {
+    stages.push_back(Stage{*layer, stages.empty() ? Next(handler)
+                                                  : Next(stages.back())});
+  }
+}
+
+}  // namespace core
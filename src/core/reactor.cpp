@@ -0,0 +1,683 @@
+#include "reactor.hpp"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "file.hpp"
+#include "parser.hpp"
+
+namespace core {
+
+namespace {
+
+constexpr int kMaxEvents = 256;  ///< Events handled per epoll_wait call.
+constexpr std::size_t kReadChunk = 16 * 1024;  ///< Bytes read per recv call.
+constexpr std::size_t kArenaChunk = 2 * 1024;  ///< First arena chunk size.
+constexpr std::size_t kMaxSpare = 1024;  ///< Closed connections kept for reuse.
+
+/**
+ * The input or request body capacity above which a closed connection is freed
+ * rather than reused, so that the pool never pins the buffers of one large
+ * upload.
+ */
+constexpr std::size_t kMaxRetainedInput = 4 * kReadChunk;
+
+/**
+ * Bytes buffered per connection before reading pauses. Room for the largest
+ * request the parser accepts plus a read's worth of whatever follows it.
+ */
+constexpr std::size_t kMaxBuffered = 64 * 1024 + 8 * 1024 * 1024 + kReadChunk;
+
+/**
+ * Returns the reason phrase for the error statuses the reactor sends itself.
+ */
+std::string reasonPhrase(int statusCode) {
+  switch (statusCode) {
+    case 408:
+      return "Request Timeout";
+    case 413:
+      return "Payload Too Large";
+    case 431:
+      return "Request Header Fields Too Large";
+    case 501:
+      return "Not Implemented";
+    default:
+      return "Bad Request";
+  }
+}
+
+/**
+ * Runs a routed request through the kernel, turning handler failures into a
+ * 500 response.
+ */
+http::Response handle(const Kernel &kernel, const router::Route *route,
+                      const http::Request &request) {
+  try {
+    return kernel.dispatch(route, request);
+  } catch (const std::exception &) {
+    return http::Response(500, "Internal Server Error",
+                          "The server encountered an internal error.",
+                          {{"Content-Type", "text/plain"}});
+  }
+}
+
+}  // namespace
+
+/**
+ * The state of one client connection.
+ */
+struct Reactor::Connection {
+  /**
+   * The deadlines a connection's timer can be armed for.
+   */
+  enum class Deadline { None, Idle, Head, Body, Write };
+
+  explicit Connection(std::pmr::memory_resource *upstream)
+      : fd(-1), id(0), arena(kArenaChunk, upstream), request(&arena) {
+    reset(-1, 0);
+  }
+
+  /**
+   * Readies the connection for a newly accepted socket. Buffers keep their
+   * capacity, so a reused connection serves its first requests without
+   * allocating.
+   */
+  void reset(int fd, std::uint64_t id) {
+    this->fd = fd;
+    this->id = id;
+    response.reset();
+    release();
+    input.clear();
+    parser.reset();
+    head.clear();
+    written = 0;
+    requests = 0;
+    deadline = Deadline::None;
+    busy = false;
+    responded = false;
+    keepAlive = false;
+    peerClosed = false;
+    processing = false;
+    closing = false;
+  }
+
+  /**
+   * Frees the arena, clearing the request first since its headers and
+   * parameters live there. The request's strings keep their capacity.
+   */
+  void release() {
+    request.clear();
+    arena.release();
+  }
+
+  int fd;                   ///< The client socket.
+  std::uint64_t id;         ///< Unique per reactor, unlike the socket.
+  std::pmr::monotonic_buffer_resource
+      arena;                ///< Backs the request being served.
+  http::Request request;    ///< The request being served, reused.
+  std::string input;        ///< Bytes received and not yet dispatched.
+  http::Parser parser;      ///< The parser resuming over input.
+  std::string head;         ///< The serialized status line and headers.
+  std::optional<http::Response>
+      response;             ///< The response being written; owns the body.
+  std::size_t written;      ///< Bytes of head and body already written.
+  std::size_t requests;     ///< Requests dispatched on this connection.
+  Timer timer;              ///< Fires when the current deadline passes.
+  Deadline deadline;        ///< What the timer is armed for.
+  bool busy;                ///< True while a worker runs the handler.
+  bool responded;           ///< True once a response has been queued.
+  bool keepAlive;           ///< True if the connection outlives the response.
+  bool peerClosed;          ///< True once the client has stopped sending.
+  bool processing;          ///< True while process() runs on the connection.
+  bool closing;             ///< True if close() was deferred by process().
+};
+
+Reactor::Reactor(const App &app, int listenFd, const ServerOptions &options,
+                 Executor *executor)
+    : kernel(app),
+      options(options),
+      executor(executor),
+      listenFd(listenFd),
+      epollFd(-1),
+      wakeFd(-1),
+      stopping(false),
+      draining(false),
+      open(0),
+      nextId(0) {
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epollFd < 0 || wakeFd < 0) {
+    if (epollFd >= 0) {
+      ::close(epollFd);
+    }
+    if (wakeFd >= 0) {
+      ::close(wakeFd);
+    }
+    ::close(listenFd);
+    throw std::runtime_error("Failed to create event loop");
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLET;
+  event.data.fd = listenFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+  event.events = EPOLLIN;
+  event.data.fd = wakeFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+Reactor::~Reactor() {
+  for (const auto &connection : connections) {
+    if (connection) {
+      ::close(connection->fd);
+    }
+  }
+  if (listenFd >= 0) {
+    ::close(listenFd);
+  }
+  ::close(wakeFd);
+  ::close(epollFd);
+}
+
+void Reactor::run() {
+  epoll_event events[kMaxEvents];
+  while (true) {
+    int timeout = -1;
+    if (stopping.load(std::memory_order_acquire) && !draining) {
+      drain();
+    }
+    auto now = std::chrono::steady_clock::now();
+    timers.advance(now);
+    // Handled outside the wheel so that closing never destroys a timer from
+    // within its own callback
+    for (int fd : expired) {
+      if (Connection *connection = find(fd)) {
+        expire(*connection);
+      }
+    }
+    expired.clear();
+
+    auto deadline = timers.nextDeadline();
+    if (draining) {
+      auto remaining = drainDeadline - now;
+      if (open == 0 || remaining <= remaining.zero()) {
+        break;
+      }
+      deadline = std::min(deadline, drainDeadline);
+    }
+    if (deadline != TimerWheel::Clock::time_point::max()) {
+      timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(
+          std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count(),
+          0));
+    }
+
+    int count = epoll_wait(epollFd, events, kMaxEvents, timeout);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("epoll_wait failed");
+    }
+
+    for (int i = 0; i < count; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == listenFd) {
+        accept();
+        continue;
+      }
+      if (fd == wakeFd) {
+        std::uint64_t value;
+        ssize_t result = ::read(wakeFd, &value, sizeof(value));
+        (void)result;
+        collect();
+        continue;
+      }
+
+      Connection *connection = find(fd);
+      if (!connection) {
+        continue;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        close(*connection);
+        continue;
+      }
+      if (events[i].events & EPOLLIN) {
+        read(*connection);
+        // The connection may have been closed while reading
+        if (!find(fd)) {
+          continue;
+        }
+      }
+      if (events[i].events & EPOLLOUT) {
+        write(*connection);
+      }
+    }
+  }
+
+  // Whatever is still open missed the drain deadline
+  for (const auto &connection : connections) {
+    if (connection) {
+      close(*connection);
+    }
+  }
+}
+
+void Reactor::stop() {
+  stopping.store(true, std::memory_order_release);
+  std::uint64_t one = 1;
+  ssize_t result = ::write(wakeFd, &one, sizeof(one));
+  (void)result;
+}
+
+void Reactor::drain() {
+  draining = true;
+  drainDeadline = std::chrono::steady_clock::now() + options.drainTimeout;
+
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, listenFd, nullptr);
+  ::close(listenFd);
+  listenFd = -1;
+
+  // Connections that have not sent any part of a request are idle, including
+  // kept-alive ones waiting for their next request
+  for (const auto &connection : connections) {
+    if (connection && connection->input.empty() && !connection->busy &&
+        !connection->responded) {
+      close(*connection);
+    }
+  }
+}
+
+void Reactor::accept() {
+  while (true) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      // EAGAIN means the backlog is drained; anything else (e.g. EMFILE) is
+      // retried on the next readiness notification.
+      return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+      ::close(fd);
+      continue;
+    }
+    // Reuse a closed connection, buffers and all, when there is one
+    std::unique_ptr<Connection> connection;
+    if (spare.empty()) {
+      connection = std::make_unique<Connection>(&pool);
+    } else {
+      connection = std::move(spare.back());
+      spare.pop_back();
+    }
+    connection->reset(fd, nextId++);
+    connection->timer.setCallback([this, fd] { expired.push_back(fd); });
+    schedule(*connection);
+    if (static_cast<std::size_t>(fd) >= connections.size()) {
+      connections.resize(static_cast<std::size_t>(fd) + 1);
+    }
+    connections[fd] = std::move(connection);
+    ++open;
+  }
+}
+
+void Reactor::read(Connection &connection) {
+  char buffer[kReadChunk];
+
+  while (true) {
+    // Edge-triggered: drain the socket until it would block, or until enough
+    // is buffered that the rest is better left in the kernel for now
+    bool full = false;
+    while (true) {
+      ssize_t count = recv(connection.fd, buffer, sizeof(buffer), 0);
+      if (count > 0) {
+        connection.input.append(buffer, static_cast<std::size_t>(count));
+        if (connection.input.size() >= kMaxBuffered) {
+          full = true;
+          break;
+        }
+        continue;
+      }
+      if (count == 0) {
+        connection.peerClosed = true;
+        break;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      close(connection);
+      return;
+    }
+    if (!process(connection)) {
+      return;
+    }
+    // A full buffer is read further once the parser has made room in it;
+    // while a response is outstanding, finish() resumes reading instead
+    if (!full || connection.busy || connection.responded) {
+      schedule(connection);
+      return;
+    }
+    if (connection.input.size() >= kMaxBuffered) {
+      fail(connection, 413, reasonPhrase(413));
+      return;
+    }
+  }
+}
+
+bool Reactor::process(Connection &connection) {
+  connection.processing = true;
+  while (!connection.closing && !connection.busy && !connection.responded) {
+    http::Parser::Status status = connection.parser.parse(connection.input);
+    if (status == http::Parser::Status::Incomplete) {
+      break;
+    }
+    if (status == http::Parser::Status::Error) {
+      int statusCode = connection.parser.getErrorStatus();
+      fail(connection, statusCode, reasonPhrase(statusCode));
+      continue;
+    }
+
+    // The previous request and its response are gone, so their memory is
+    // reclaimed in one step
+    connection.release();
+    http::Request &request = connection.request;
+    connection.parser.toRequest(request);
+    connection.input.erase(0, connection.parser.getConsumed());
+    connection.parser.reset();
+    ++connection.requests;
+    connection.keepAlive =
+        request.isKeepAlive() && (options.maxRequestsPerConnection == 0 ||
+                                  connection.requests <
+                                      options.maxRequestsPerConnection);
+    // Usually answered inline, in which case the loop moves straight on to
+    // the next pipelined request
+    dispatch(connection, request);
+  }
+  connection.processing = false;
+
+  if (!connection.busy && !connection.responded) {
+    // Idle connections hold no arena chunks
+    connection.release();
+  }
+  if (connection.closing || (connection.peerClosed && !connection.busy &&
+                             !connection.responded)) {
+    close(connection);
+    return false;
+  }
+  return true;
+}
+
+void Reactor::write(Connection &connection) {
+  if (!connection.responded) {
+    // Writable with nothing queued, e.g. between kept-alive requests
+    return;
+  }
+  const http::Response &response = *connection.response;
+  const std::string &head = connection.head;
+  const std::string &body = response.getBody();
+  const std::shared_ptr<const http::File> &file = response.getFile();
+  std::size_t buffered = head.size() + body.size();
+  std::size_t total = buffered + (file ? response.getFileLength() : 0);
+
+  while (connection.written < total) {
+    ssize_t sent;
+    if (connection.written < buffered) {
+      // Gather the rest of the head and the body straight from the response
+      iovec parts[2];
+      int count = 0;
+      std::size_t bodyWritten = 0;
+      if (connection.written < head.size()) {
+        parts[count].iov_base =
+            const_cast<char *>(head.data() + connection.written);
+        parts[count].iov_len = head.size() - connection.written;
+        ++count;
+      } else {
+        bodyWritten = connection.written - head.size();
+      }
+      if (bodyWritten < body.size()) {
+        parts[count].iov_base = const_cast<char *>(body.data() + bodyWritten);
+        parts[count].iov_len = body.size() - bodyWritten;
+        ++count;
+      }
+
+      msghdr message{};
+      message.msg_iov = parts;
+      message.msg_iovlen = static_cast<std::size_t>(count);
+      // Hold the head back briefly so it shares a segment with the file
+      sent = sendmsg(connection.fd, &message,
+                     MSG_NOSIGNAL | (file ? MSG_MORE : 0));
+    } else {
+      // Stream the file range from the page cache without copying it
+      auto offset = static_cast<off_t>(response.getFileOffset() +
+                                       connection.written - buffered);
+      sent = sendfile(connection.fd, file->getFd(), &offset,
+                      total - connection.written);
+      if (sent == 0) {
+        // The file shrank since it was opened; the response cannot finish
+        close(connection);
+        return;
+      }
+    }
+
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Resumed when epoll reports the socket writable again
+        schedule(connection);
+        return;
+      }
+      close(connection);
+      return;
+    }
+    connection.written += static_cast<std::size_t>(sent);
+  }
+
+  finish(connection);
+}
+
+void Reactor::finish(Connection &connection) {
+  if (!connection.keepAlive) {
+    close(connection);
+    return;
+  }
+
+  connection.head.clear();
+  connection.response.reset();
+  connection.written = 0;
+  connection.responded = false;
+  // The idle deadline runs from the end of the response
+  connection.deadline = Connection::Deadline::None;
+  // Inside process() the loop picks up the next request itself; otherwise
+  // the response was finished from the event loop, and anything pipelined
+  // behind it (or left unread in the socket) is handled now
+  if (!connection.processing) {
+    read(connection);
+  }
+}
+
+void Reactor::schedule(Connection &connection) {
+  using Deadline = Connection::Deadline;
+  Deadline deadline;
+  std::chrono::milliseconds timeout;
+  if (connection.busy) {
+    deadline = Deadline::None;
+    timeout = std::chrono::milliseconds(0);
+  } else if (connection.responded) {
+    deadline = Deadline::Write;
+    timeout = options.writeTimeout;
+  } else if (connection.input.empty()) {
+    deadline = Deadline::Idle;
+    timeout = options.idleTimeout;
+  } else if (!connection.parser.hasHead()) {
+    deadline = Deadline::Head;
+    timeout = options.headerTimeout;
+  } else {
+    deadline = Deadline::Body;
+    timeout = options.bodyTimeout;
+  }
+
+  // Idle and header deadlines run from when the state was entered; the body
+  // and write deadlines restart whenever bytes move
+  bool restart = deadline == Deadline::Body || deadline == Deadline::Write;
+  if (deadline == connection.deadline && !restart) {
+    return;
+  }
+  connection.deadline = deadline;
+  if (timeout.count() <= 0) {
+    timers.cancel(connection.timer);
+    return;
+  }
+  timers.arm(connection.timer, std::chrono::steady_clock::now() + timeout);
+}
+
+void Reactor::expire(Connection &connection) {
+  switch (connection.deadline) {
+    case Connection::Deadline::Head:
+    case Connection::Deadline::Body:
+      fail(connection, 408, reasonPhrase(408));
+      return;
+    case Connection::Deadline::Write: {
+      // Reset rather than leave the kernel retrying the unread response
+      linger reset{1, 0};
+      setsockopt(connection.fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+      close(connection);
+      return;
+    }
+    case Connection::Deadline::Idle:
+      close(connection);
+      return;
+    case Connection::Deadline::None:
+      return;
+  }
+}
+
+void Reactor::dispatch(Connection &connection,
+                       const http::Request &request) {
+  const router::Route *route = kernel.resolve(request);
+  if (!route || !route->isBlocking() || !executor) {
+    respond(connection, handle(kernel, route, request));
+    return;
+  }
+
+  // The worker owns a copy of the request outside the arena, which goes away
+  // with the connection; only ids cross back to this thread
+  connection.busy = true;
+  auto shared = std::make_shared<http::Request>(request);
+  int fd = connection.fd;
+  std::uint64_t id = connection.id;
+  executor->submit([this, route, shared, fd, id] {
+    complete(fd, id, handle(kernel, route, *shared));
+  });
+}
+
+void Reactor::complete(int fd, std::uint64_t id, http::Response response) {
+  {
+    std::lock_guard<std::mutex> lock(completionMutex);
+    completions.push_back(Completion{fd, id, std::move(response)});
+  }
+  std::uint64_t one = 1;
+  ssize_t result = ::write(wakeFd, &one, sizeof(one));
+  (void)result;
+}
+
+void Reactor::collect() {
+  std::vector<Completion> ready;
+  {
+    std::lock_guard<std::mutex> lock(completionMutex);
+    ready.swap(completions);
+  }
+  for (auto &completion : ready) {
+    Connection *connection = find(completion.fd);
+    // The client may have gone away while the handler ran
+    if (!connection || connection->id != completion.id) {
+      continue;
+    }
+    connection->busy = false;
+    respond(*connection, std::move(completion.response));
+  }
+}
+
+void Reactor::respond(Connection &connection, http::Response response) {
+  int statusCode = response.getStatusCode();
+  // A Content-Length without a body is kept, as it answers a HEAD request
+  bool announced =
+      response.getContentLength() == 0 &&
+      response.getHeaders().has(http::Headers::Known::ContentLength);
+  if (statusCode >= 200 && statusCode != 204 && statusCode != 304 &&
+      !announced) {
+    response.setHeader("Content-Length",
+                       std::to_string(response.getContentLength()));
+  }
+  if (draining) {
+    connection.keepAlive = false;
+  }
+  response.setHeader("Connection",
+                     connection.keepAlive ? "keep-alive" : "close");
+  response.serializeHead(connection.head);
+  // Emplaced rather than assigned: assignment would copy headers out of the
+  // request arena instead of taking them over
+  connection.response.emplace(std::move(response));
+  connection.written = 0;
+  connection.responded = true;
+  write(connection);
+}
+
+void Reactor::fail(Connection &connection, int statusCode,
+                   const std::string &statusMessage) {
+  // The rest of the input cannot be framed, so nothing after it is served
+  connection.input.clear();
+  connection.keepAlive = false;
+  respond(connection, http::Response(statusCode, statusMessage, statusMessage,
+                                     {{"Content-Type", "text/plain"}}));
+}
+
+void Reactor::close(Connection &connection) {
+  if (connection.processing) {
+    connection.closing = true;
+    return;
+  }
+  int fd = connection.fd;
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  timers.cancel(connection.timer);
+  std::unique_ptr<Connection> closed = std::move(connections[fd]);
+  --open;
+  if (spare.size() < kMaxSpare &&
+      closed->input.capacity() <= kMaxRetainedInput &&
+      closed->request.getBody().capacity() <= kMaxRetainedInput) {
+    // Drop the response now rather than when the connection is reused
+    closed->reset(-1, 0);
+    spare.push_back(std::move(closed));
+  }
+}
+
+Reactor::Connection *Reactor::find(int fd) {
+  if (fd < 0 || static_cast<std::size_t>(fd) >= connections.size()) {
+    return nullptr;
+  }
+  return connections[fd].get();
+}
+
+}  // namespace core
@@ -0,0 +1,138 @@
+#include "server.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "reactor.hpp"
+
+namespace core {
+
+namespace {
+
+/**
+ * Creates a non-blocking IPv4 socket listening on the given address.
+ */
+int openListener(const std::string &host, int port, bool reusePort) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<std::uint16_t>(port));
+  if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("Invalid listen address: " + host);
+  }
+
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to create socket: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  int enable = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+  if (reusePort) {
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+  }
+  if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+      ::listen(fd, SOMAXCONN) < 0) {
+    std::string error = std::strerror(errno);
+    ::close(fd);
+    throw std::runtime_error("Failed to listen on " + host + ":" +
+                             std::to_string(port) + ": " + error);
+  }
+  return fd;
+}
+
+/**
+ * Returns the local port a socket is bound to.
+ */
+int boundPort(int fd) {
+  sockaddr_in address{};
+  socklen_t length = sizeof(address);
+  getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length);
+  return ntohs(address.sin_port);
+}
+
+/**
+ * Pins the calling thread to a single core. Failure is not fatal.
+ */
+void pinToCore(std::size_t core) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % CPU_SETSIZE, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+}  // namespace
+
+Server::Server(const App &app, const ServerOptions &options)
+    : app(app), options(options), port(0) {
+  if (this->options.threads == 0) {
+    this->options.threads =
+        std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+}
+
+Server::~Server() = default;
+
+void Server::listen(const std::string &host, int port) {
+  bool reusePort = options.threads > 1;
+  std::vector<std::unique_ptr<Reactor>> created;
+  if (!executor && options.workerThreads > 0) {
+    executor = std::make_unique<Executor>(options.workerThreads);
+  }
+
+  // The first socket resolves an ephemeral port; the others join it
+  int fd = openListener(host, port, reusePort);
+  this->port = boundPort(fd);
+  created.push_back(
+      std::make_unique<Reactor>(app, fd, options, executor.get()));
+  while (created.size() < options.threads) {
+    fd = openListener(host, this->port, reusePort);
+    created.push_back(
+        std::make_unique<Reactor>(app, fd, options, executor.get()));
+  }
+  reactors = std::move(created);
+}
+
+int Server::getPort() const { return port; }
+
+void Server::run() {
+  if (reactors.empty()) {
+    throw std::runtime_error("Server is not listening");
+  }
+  if (reactors.size() == 1) {
+    reactors.front()->run();
+    return;
+  }
+
+  std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::thread> threads;
+  threads.reserve(reactors.size());
+  for (std::size_t i = 0; i < reactors.size(); ++i) {
+    threads.emplace_back([this, i, cores] {
+      if (options.pinThreads) {
+        pinToCore(i % cores);
+      }
+      reactors[i]->run();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void Server::stop() {
+  for (auto &reactor : reactors) {
+    reactor->stop();
+  }
+}
+
+}  // namespace core
@@ -0,0 +1,201 @@
+#include "timer.hpp"
+
+#include <utility>
+
+namespace core {
+
+Timer::Timer()
+    : previous(nullptr), next(nullptr), wheel(nullptr), tick(0), slot(0) {}
+
+Timer::Timer(Callback callback) : Timer() {
+  this->callback = std::move(callback);
+}
+
+Timer::~Timer() {
+  if (wheel) {
+    wheel->cancel(*this);
+  }
+}
+
+void Timer::setCallback(Callback callback) {
+  this->callback = std::move(callback);
+}
+
+bool Timer::isArmed() const { return wheel != nullptr; }
+
+TimerWheel::TimerWheel(Clock::time_point start,
+                       std::chrono::milliseconds resolution)
+    : start(start), resolution(resolution), current(0), count(0) {
+  if (this->resolution <= Clock::duration::zero()) {
+    this->resolution = std::chrono::milliseconds(1);
+  }
+  slots.fill(nullptr);
+  occupied.fill(0);
+}
+
+TimerWheel::~TimerWheel() {
+  for (Timer *head : slots) {
+    for (Timer *timer = head; timer; timer = timer->next) {
+      timer->wheel = nullptr;
+    }
+  }
+}
+
+void TimerWheel::arm(Timer &timer, Clock::time_point deadline) {
+  if (timer.wheel) {
+    timer.wheel->cancel(timer);
+  }
+
+  // Round up so that a timer never fires before its deadline
+  std::uint64_t tick = 0;
+  if (deadline > start) {
+    Clock::duration elapsed = deadline - start;
+    tick = static_cast<std::uint64_t>(elapsed / resolution);
+    if (elapsed % resolution != Clock::duration::zero()) {
+      ++tick;
+    }
+  }
+  // The current tick has already fired
+  timer.tick = tick > current ? tick : current + 1;
+  timer.wheel = this;
+  insert(timer);
+  ++count;
+}
+
+void TimerWheel::cancel(Timer &timer) {
+  if (timer.wheel != this) {
+    return;
+  }
+  unlink(timer);
+  timer.wheel = nullptr;
+  --count;
+}
+
+std::size_t TimerWheel::advance(Clock::time_point now) {
+  if (now <= start) {
+    return 0;
+  }
+  auto target = static_cast<std::uint64_t>((now - start) / resolution);
+
+  std::size_t fired = 0;
+  while (current < target) {
+    // Ticks with nothing to fire or cascade are skipped in one step
+    std::uint64_t tick = nextTick();
+    if (tick > target) {
+      current = target;
+      break;
+    }
+    current = tick;
+
+    for (unsigned level = kLevels - 1; level > 0; --level) {
+      unsigned shift = kSlotBits * level;
+      if ((current & ((std::uint64_t(1) << shift) - 1)) == 0) {
+        cascade(level, (current >> shift) & kSlotMask);
+      }
+    }
+
+    // Callbacks may cancel or destroy other timers, so take one at a time
+    std::size_t slot = current & kSlotMask;
+    while (Timer *timer = slots[slot]) {
+      unlink(*timer);
+      timer->wheel = nullptr;
+      --count;
+      ++fired;
+      if (timer->callback) {
+        timer->callback();
+      }
+    }
+  }
+  return fired;
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextDeadline() const {
+  std::uint64_t tick = nextTick();
+  if (tick == kNever) {
+    return Clock::time_point::max();
+  }
+  return start + resolution * static_cast<Clock::rep>(tick);
+}
+
+std::size_t TimerWheel::size() const { return count; }
+
+void TimerWheel::insert(Timer &timer) {
+  constexpr std::uint64_t kHorizon =
+      (std::uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+  std::uint64_t delta = timer.tick - current;
+  unsigned level = 0;
+  while (level + 1 < kLevels &&
+         delta >= (std::uint64_t(1) << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+  // Deadlines beyond the last level wait at its far end and are re-inserted
+  // when it cascades
+  std::uint64_t tick = delta > kHorizon ? current + kHorizon : timer.tick;
+  std::uint64_t index = (tick >> (kSlotBits * level)) & kSlotMask;
+
+  timer.slot = static_cast<std::uint16_t>(level * kSlots + index);
+  Timer *&head = slots[timer.slot];
+  timer.previous = nullptr;
+  timer.next = head;
+  if (head) {
+    head->previous = &timer;
+  }
+  head = &timer;
+  occupied[level] |= std::uint64_t(1) << index;
+}
+
+void TimerWheel::unlink(Timer &timer) {
+  if (timer.previous) {
+    timer.previous->next = timer.next;
+  } else {
+    slots[timer.slot] = timer.next;
+    if (!timer.next) {
+      occupied[timer.slot / kSlots] &=
+          ~(std::uint64_t(1) << (timer.slot % kSlots));
+    }
+  }
+  if (timer.next) {
+    timer.next->previous = timer.previous;
+  }
+  timer.previous = nullptr;
+  timer.next = nullptr;
+}
+
+void TimerWheel::cascade(unsigned level, std::uint64_t index) {
+  std::size_t slot = level * kSlots + index;
+  Timer *timer = slots[slot];
+  slots[slot] = nullptr;
+  occupied[level] &= ~(std::uint64_t(1) << index);
+  while (timer) {
+    Timer *next = timer->next;
+    insert(*timer);
+    timer = next;
+  }
+}
+
+std::uint64_t TimerWheel::nextTick() const {
+  std::uint64_t best = kNever;
+  for (unsigned level = 0; level < kLevels; ++level) {
+    std::uint64_t bits = occupied[level];
+    if (!bits) {
+      continue;
+    }
+    // A slot at this level is reached when the level's index next moves onto
+    // it, at a multiple of the level's span
+    unsigned shift = kSlotBits * level;
+    std::uint64_t block = (current >> shift) + 1;
+    unsigned offset = static_cast<unsigned>(block & kSlotMask);
+    std::uint64_t rotated =
+        offset ? (bits >> offset) | (bits << (kSlots - offset)) : bits;
+    std::uint64_t tick = (block + static_cast<std::uint64_t>(
+                                      __builtin_ctzll(rotated)))
+                         << shift;
+    if (tick < best) {
+      best = tick;
+    }
+  }
+  return best;
+}
+
+}  // namespace core
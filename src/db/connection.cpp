@@ -5,17 +5,105 @@
 
 namespace db {
 
-Connection::Connection(const std::string &db_path) {
-  int result = sqlite3_open(db_path.c_str(), &db);
+double Connection::CacheStats::hitRate() const {
+  std::uint64_t calls = hits + misses;
+  return calls ? static_cast<double>(hits) / calls : 0.0;
+}
+
+Connection::Connection(const std::string &db_path, int flags) {
+  int result = sqlite3_open_v2(db_path.c_str(), &db, flags, nullptr);
 
   if (result != SQLITE_OK) {
-    throw std::runtime_error("Failed to open database: " +
-                             std::string(sqlite3_errmsg(db)));
+    std::string message = db ? sqlite3_errmsg(db) : sqlite3_errstr(result);
+    // A handle is allocated even when opening fails, and must be released
+    sqlite3_close(db);
+    throw std::runtime_error("Failed to open database: " + message);
   }
 }
 
-Connection::~Connection() { sqlite3_close(db); }
+Connection::~Connection() {
+  // sqlite3_close() refuses to close while statements are unfinalized
+  for (Statement::Entry &entry : cache) {
+    sqlite3_finalize(entry.statement);
+  }
+  sqlite3_close(db);
+}
+
+void Connection::execute(const std::string &sql) {
+  char *error = nullptr;
+  if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+    std::string message = error ? error : sqlite3_errmsg(db);
+    sqlite3_free(error);
+    throw std::runtime_error("Failed to execute statement: " + message);
+  }
+}
+
+Statement Connection::prepare(std::string_view sql) {
+  auto found = index.find(sql);
+  if (found != index.end()) {
+    Statement::Entry &entry = *found->second;
+    if (!entry.leased) {
+      ++stats.hits;
+      cache.splice(cache.begin(), cache, found->second);
+      entry.leased = true;
+      return Statement(entry.statement, &entry);
+    }
+    ++stats.misses;
+    return Statement(compile(sql), nullptr);
+  }
+
+  ++stats.misses;
+  sqlite3_stmt *statement = compile(sql);
+  cache.push_front(Statement::Entry{std::string(sql), statement, true});
+  // The key views the entry's own copy of the SQL, which list nodes keep in
+  // place
+  index.emplace(cache.front().sql, cache.begin());
+  evict();
+  return Statement(statement, &cache.front());
+}
+
+void Connection::setCacheCapacity(std::size_t capacity) {
+  this->capacity = capacity;
+  evict();
+}
+
+std::size_t Connection::getCacheSize() const { return cache.size(); }
+
+const Connection::CacheStats &Connection::getCacheStats() const {
+  return stats;
+}
 
 sqlite3 *Connection::get_db() const { return db; }
 
+sqlite3_stmt *Connection::compile(std::string_view sql) {
+  auto start = std::chrono::steady_clock::now();
+  sqlite3_stmt *statement = nullptr;
+  int result = sqlite3_prepare_v3(db, sql.data(), static_cast<int>(sql.size()),
+                                  SQLITE_PREPARE_PERSISTENT, &statement,
+                                  nullptr);
+  stats.prepareTime += std::chrono::steady_clock::now() - start;
+  if (result != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare statement: " +
+                             std::string(sqlite3_errmsg(db)));
+  }
+  if (!statement) {
+    throw std::runtime_error("Failed to prepare statement: no SQL");
+  }
+  return statement;
+}
+
+void Connection::evict() {
+  auto it = cache.end();
+  while (cache.size() > capacity && it != cache.begin()) {
+    --it;
+    if (it->leased) {
+      continue;
+    }
+    index.erase(it->sql);
+    sqlite3_finalize(it->statement);
+    it = cache.erase(it);
+    ++stats.evictions;
+  }
+}
+
 }  // namespace db
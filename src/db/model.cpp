@@ -0,0 +1,31 @@
+#include "model.hpp"
+
+namespace db {
+
+Transaction::Transaction(Connection &connection)
+    : connection(connection),
+      active(sqlite3_get_autocommit(connection.get_db()) != 0) {
+  if (active) {
+    connection.prepare("BEGIN IMMEDIATE").execute();
+  }
+}
+
+Transaction::~Transaction() {
+  if (!active) {
+    return;
+  }
+  // The statement that failed may already have rolled the transaction back
+  if (!sqlite3_get_autocommit(connection.get_db())) {
+    sqlite3_exec(connection.get_db(), "ROLLBACK", nullptr, nullptr, nullptr);
+  }
+}
+
+void Transaction::commit() {
+  if (!active) {
+    return;
+  }
+  connection.prepare("COMMIT").execute();
+  active = false;
+}
+
+}  // namespace db
@@ -0,0 +1,159 @@
+#include "pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace db {
+
+namespace {
+
+/**
+ * Hands every thread a distinct number the first time it asks, from which
+ * its home reader is derived.
+ */
+std::size_t threadHome() {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t home = next.fetch_add(1, std::memory_order_relaxed);
+  return home;
+}
+
+/**
+ * Reads the journal mode a connection reports, which also makes a reader
+ * open the WAL index right away.
+ */
+std::string journalMode(sqlite3 *db) {
+  sqlite3_stmt *statement = nullptr;
+  if (sqlite3_prepare_v2(db, "PRAGMA journal_mode", -1, &statement,
+                         nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to read journal mode: " +
+                             std::string(sqlite3_errmsg(db)));
+  }
+  std::string mode;
+  if (sqlite3_step(statement) == SQLITE_ROW) {
+    mode = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+  }
+  sqlite3_finalize(statement);
+  return mode;
+}
+
+}  // namespace
+
+Pool::Lease::Lease(Pool *pool, Slot *slot) : pool(pool), slot(slot) {}
+
+Pool::Lease::Lease(Lease &&other) noexcept
+    : pool(other.pool), slot(other.slot) {
+  other.slot = nullptr;
+}
+
+Pool::Lease &Pool::Lease::operator=(Lease &&other) noexcept {
+  if (this != &other) {
+    if (slot) {
+      pool->release(*slot);
+    }
+    pool = other.pool;
+    slot = other.slot;
+    other.slot = nullptr;
+  }
+  return *this;
+}
+
+Pool::Lease::~Lease() {
+  if (slot) {
+    pool->release(*slot);
+  }
+}
+
+Connection &Pool::Lease::operator*() const { return *slot->connection; }
+
+Connection *Pool::Lease::operator->() const { return slot->connection.get(); }
+
+sqlite3 *Pool::Lease::get_db() const { return slot->connection->get_db(); }
+
+Pool::Pool(const std::string &path, std::size_t readers, int busyTimeout)
+    : readerCount(readers), waiting(0) {
+  if (readerCount == 0) {
+    readerCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  slots = std::make_unique<Slot[]>(readerCount + 1);
+
+  // The writer creates the database and switches it to WAL before any
+  // reader opens it; read-only connections cannot change the journal mode
+  slots[0].connection = std::make_unique<Connection>(
+      path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+  sqlite3 *writer = slots[0].connection->get_db();
+  sqlite3_busy_timeout(writer, busyTimeout);
+  slots[0].connection->execute("PRAGMA journal_mode=WAL");
+  if (journalMode(writer) != "wal") {
+    throw std::runtime_error("Failed to enable WAL mode on " + path);
+  }
+
+  for (std::size_t i = 1; i <= readerCount; ++i) {
+    slots[i].connection = std::make_unique<Connection>(
+        path, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+    sqlite3_busy_timeout(slots[i].connection->get_db(), busyTimeout);
+  }
+}
+
+Pool::~Pool() = default;
+
+Pool::Lease Pool::read() {
+  return acquire(1, readerCount, threadHome() % readerCount);
+}
+
+Pool::Lease Pool::write() { return acquire(0, 1, 0); }
+
+std::size_t Pool::readers() const { return readerCount; }
+
+bool Pool::claim(Slot &slot) {
+  // A plain load first keeps a busy slot's cache line shared
+  if (slot.busy.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  bool expected = false;
+  return slot.busy.compare_exchange_strong(expected, true,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+}
+
+Pool::Slot *Pool::claimAny(std::size_t begin, std::size_t count,
+                           std::size_t first) {
+  for (std::size_t i = 0; i < count; ++i) {
+    Slot &slot = slots[begin + (first + i) % count];
+    if (claim(slot)) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+Pool::Lease Pool::acquire(std::size_t begin, std::size_t count,
+                          std::size_t first) {
+  if (Slot *slot = claimAny(begin, count, first)) {
+    return Lease(this, slot);
+  }
+
+  // Every slot is leased: sleep until one comes back. Announcing the wait
+  // before retrying pairs with release(), which frees the slot before it
+  // checks for waiters, so a returned slot is never missed
+  std::unique_lock<std::mutex> lock(mutex);
+  waiting.fetch_add(1);
+  Slot *slot = nullptr;
+  returned.wait(lock, [&] {
+    slot = claimAny(begin, count, first);
+    return slot != nullptr;
+  });
+  waiting.fetch_sub(1);
+  return Lease(this, slot);
+}
+
+void Pool::release(Slot &slot) {
+  slot.busy.store(false);
+  if (waiting.load() > 0) {
+    // Taking the mutex orders the wake-up after the waiter's last check
+    std::lock_guard<std::mutex> lock(mutex);
+    returned.notify_all();
+  }
+}
+
+}  // namespace db
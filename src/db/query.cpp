@@ -0,0 +1,204 @@
+#include "query.hpp"
+
+#include <stdexcept>
+
+namespace db {
+
+namespace {
+
+/**
+ * Quotes an identifier, doubling any quotes inside it.
+ */
+std::string quote(std::string_view identifier) {
+  std::string quoted = "\"";
+  for (char c : identifier) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+/**
+ * Checks a comparison operator and returns it in upper case.
+ */
+std::string comparisonFor(std::string_view comparison) {
+  static const char *const kComparisons[] = {
+      "=", "!=", "<>", "<", "<=", ">", ">=", "LIKE", "IS", "IS NOT",
+  };
+  std::string upper(comparison);
+  for (char &c : upper) {
+    if (c >= 'a' && c <= 'z') {
+      c = static_cast<char>(c - ('a' - 'A'));
+    }
+  }
+  for (const char *candidate : kComparisons) {
+    if (upper == candidate) {
+      return upper;
+    }
+  }
+  throw std::runtime_error("Unsupported comparison: " +
+                           std::string(comparison));
+}
+
+}  // namespace
+
+Query::Query(Kind kind, std::string_view table)
+    : kind(kind), table(quote(table)) {}
+
+Query Query::select(std::string_view table,
+                    const std::vector<std::string> &columns) {
+  Query query(Kind::Select, table);
+  for (const std::string &column : columns) {
+    if (!query.columns.empty()) {
+      query.columns += ", ";
+    }
+    query.columns += quote(column);
+  }
+  if (query.columns.empty()) {
+    query.columns = "*";
+  }
+  query.build();
+  return query;
+}
+
+Query Query::insert(std::string_view table,
+                    const std::vector<std::string> &columns) {
+  if (columns.empty()) {
+    throw std::runtime_error("INSERT needs at least one column");
+  }
+  Query query(Kind::Insert, table);
+  std::string placeholders;
+  for (const std::string &column : columns) {
+    if (!query.columns.empty()) {
+      query.columns += ", ";
+      placeholders += ", ";
+    }
+    query.columns += quote(column);
+    placeholders += '?';
+  }
+  query.columns = "(" + query.columns + ") VALUES (" + placeholders + ")";
+  query.columnParameters = static_cast<int>(columns.size());
+  query.build();
+  return query;
+}
+
+Query Query::update(std::string_view table,
+                    const std::vector<std::string> &columns) {
+  if (columns.empty()) {
+    throw std::runtime_error("UPDATE needs at least one column");
+  }
+  Query query(Kind::Update, table);
+  for (const std::string &column : columns) {
+    if (!query.columns.empty()) {
+      query.columns += ", ";
+    }
+    query.columns += quote(column) + " = ?";
+  }
+  query.columnParameters = static_cast<int>(columns.size());
+  query.build();
+  return query;
+}
+
+Query Query::remove(std::string_view table) {
+  Query query(Kind::Delete, table);
+  query.build();
+  return query;
+}
+
+Query &Query::where(std::string_view column, std::string_view comparison) {
+  if (kind == Kind::Insert) {
+    throw std::runtime_error("INSERT takes no conditions");
+  }
+  if (!conditions.empty()) {
+    conditions += " AND ";
+  }
+  conditions += quote(column) + " " + comparisonFor(comparison) + " ?";
+  ++conditionParameters;
+  build();
+  return *this;
+}
+
+Query &Query::whereIn(std::string_view column, std::size_t count) {
+  if (kind == Kind::Insert) {
+    throw std::runtime_error("INSERT takes no conditions");
+  }
+  if (count == 0) {
+    throw std::runtime_error("IN needs at least one value");
+  }
+  if (!conditions.empty()) {
+    conditions += " AND ";
+  }
+  conditions += quote(column) + " IN (";
+  for (std::size_t i = 0; i < count; ++i) {
+    conditions += i ? ", ?" : "?";
+  }
+  conditions += ")";
+  conditionParameters += static_cast<int>(count);
+  build();
+  return *this;
+}
+
+Query &Query::orderBy(std::string_view column, bool descending) {
+  if (kind != Kind::Select) {
+    throw std::runtime_error("Only SELECT can be ordered");
+  }
+  if (!order.empty()) {
+    order += ", ";
+  }
+  order += quote(column) + (descending ? " DESC" : " ASC");
+  build();
+  return *this;
+}
+
+Query &Query::limit(bool withOffset) {
+  if (kind != Kind::Select) {
+    throw std::runtime_error("Only SELECT can be limited");
+  }
+  limitParameters = withOffset ? 2 : 1;
+  build();
+  return *this;
+}
+
+const std::string &Query::getSql() const { return sql; }
+
+int Query::getParameterCount() const { return parameters; }
+
+Statement Query::start(Connection &connection, std::size_t values) const {
+  if (static_cast<int>(values) != parameters) {
+    throw std::runtime_error("Query takes " + std::to_string(parameters) +
+                             " values, got " + std::to_string(values));
+  }
+  return connection.prepare(sql);
+}
+
+void Query::build() {
+  switch (kind) {
+    case Kind::Select:
+      sql = "SELECT " + columns + " FROM " + table;
+      break;
+    case Kind::Insert:
+      sql = "INSERT INTO " + table + " " + columns;
+      break;
+    case Kind::Update:
+      sql = "UPDATE " + table + " SET " + columns;
+      break;
+    case Kind::Delete:
+      sql = "DELETE FROM " + table;
+      break;
+  }
+  if (!conditions.empty()) {
+    sql += " WHERE " + conditions;
+  }
+  if (!order.empty()) {
+    sql += " ORDER BY " + order;
+  }
+  if (limitParameters > 0) {
+    sql += limitParameters == 2 ? " LIMIT ? OFFSET ?" : " LIMIT ?";
+  }
+  parameters = columnParameters + conditionParameters + limitParameters;
+}
+
+}  // namespace db
@@ -0,0 +1,148 @@
+#include "statement.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace db {
+
+Statement::Statement(sqlite3_stmt *statement, Entry *entry)
+    : statement(statement), entry(entry) {}
+
+Statement::Statement(Statement &&other) noexcept
+    : statement(other.statement), entry(other.entry) {
+  other.statement = nullptr;
+  other.entry = nullptr;
+}
+
+Statement &Statement::operator=(Statement &&other) noexcept {
+  if (this != &other) {
+    release();
+    statement = other.statement;
+    entry = other.entry;
+    other.statement = nullptr;
+    other.entry = nullptr;
+  }
+  return *this;
+}
+
+Statement::~Statement() { release(); }
+
+Statement &Statement::bind(int index, int value) {
+  return check(sqlite3_bind_int(statement, index, value));
+}
+
+Statement &Statement::bind(int index, std::int64_t value) {
+  return check(sqlite3_bind_int64(statement, index, value));
+}
+
+Statement &Statement::bind(int index, unsigned int value) {
+  return bind(index, static_cast<std::int64_t>(value));
+}
+
+Statement &Statement::bind(int index, unsigned long value) {
+  return bind(index, static_cast<unsigned long long>(value));
+}
+
+Statement &Statement::bind(int index, unsigned long long value) {
+  if (value > static_cast<unsigned long long>(
+                  std::numeric_limits<std::int64_t>::max())) {
+    throw std::runtime_error("Value does not fit in an SQLite integer: " +
+                             std::to_string(value));
+  }
+  return bind(index, static_cast<std::int64_t>(value));
+}
+
+Statement &Statement::bind(int index, double value) {
+  return check(sqlite3_bind_double(statement, index, value));
+}
+
+Statement &Statement::bind(int index, std::string_view value) {
+  return check(sqlite3_bind_text(statement, index, value.data(),
+                                 static_cast<int>(value.size()),
+                                 SQLITE_STATIC));
+}
+
+Statement &Statement::bindCopy(int index, std::string_view value) {
+  return check(sqlite3_bind_text(statement, index, value.data(),
+                                 static_cast<int>(value.size()),
+                                 SQLITE_TRANSIENT));
+}
+
+Statement &Statement::bind(int index, std::nullptr_t) {
+  return check(sqlite3_bind_null(statement, index));
+}
+
+bool Statement::step() {
+  int result = sqlite3_step(statement);
+  if (result == SQLITE_ROW) {
+    return true;
+  }
+  if (result == SQLITE_DONE) {
+    return false;
+  }
+  throw std::runtime_error(
+      "Failed to execute statement: " +
+      std::string(sqlite3_errmsg(sqlite3_db_handle(statement))));
+}
+
+void Statement::execute() {
+  while (step()) {
+  }
+}
+
+void Statement::reset() {
+  sqlite3_reset(statement);
+  sqlite3_clear_bindings(statement);
+}
+
+int Statement::getColumnCount() const {
+  return sqlite3_column_count(statement);
+}
+
+bool Statement::isNull(int column) const {
+  return sqlite3_column_type(statement, column) == SQLITE_NULL;
+}
+
+std::int64_t Statement::getInt(int column) const {
+  return sqlite3_column_int64(statement, column);
+}
+
+double Statement::getDouble(int column) const {
+  return sqlite3_column_double(statement, column);
+}
+
+std::string_view Statement::getText(int column) const {
+  const unsigned char *text = sqlite3_column_text(statement, column);
+  if (!text) {
+    return std::string_view();
+  }
+  return std::string_view(reinterpret_cast<const char *>(text),
+                          sqlite3_column_bytes(statement, column));
+}
+
+sqlite3_stmt *Statement::get_stmt() const { return statement; }
+
+Statement &Statement::check(int result) {
+  if (result != SQLITE_OK) {
+    throw std::runtime_error(
+        "Failed to bind parameter: " +
+        std::string(sqlite3_errmsg(sqlite3_db_handle(statement))));
+  }
+  return *this;
+}
+
+void Statement::release() {
+  if (!statement) {
+    return;
+  }
+  if (entry) {
+    reset();
+    entry->leased = false;
+  } else {
+    sqlite3_finalize(statement);
+  }
+  statement = nullptr;
+  entry = nullptr;
+}
+
+}  // namespace db
@@ -0,0 +1,107 @@
+#include "writer.hpp"
+
+#include <stdexcept>
+
+#include "statement.hpp"
+
+namespace db {
+
+Writer::Writer(Connection &connection, WriterOptions options)
+    : connection(connection),
+      options(options),
+      stopping(false),
+      batches(0),
+      writes(0) {
+  if (this->options.maxBatch == 0) {
+    this->options.maxBatch = 1;
+  }
+  thread = std::thread(&Writer::work, this);
+}
+
+Writer::~Writer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  queued.notify_one();
+  thread.join();
+}
+
+std::uint64_t Writer::getBatchCount() const { return batches.load(); }
+
+std::uint64_t Writer::getWriteCount() const { return writes.load(); }
+
+void Writer::enqueue(std::unique_ptr<Job> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping) {
+      throw std::runtime_error("Writer is stopping");
+    }
+    queue.push_back(std::move(job));
+  }
+  queued.notify_one();
+}
+
+void Writer::work() {
+  std::vector<std::unique_ptr<Job>> batch;
+  batch.reserve(options.maxBatch);
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    queued.wait(lock, [this] { return stopping || !queue.empty(); });
+    if (queue.empty()) {
+      return;
+    }
+
+    // Give other writes the window to join the first one. Writes queued
+    // while the previous batch was committing are already here, so under
+    // load the batch fills without waiting at all
+    if (options.maxDelay.count() > 0 && !stopping) {
+      auto deadline = std::chrono::steady_clock::now() + options.maxDelay;
+      queued.wait_until(lock, deadline, [this] {
+        return stopping || queue.size() >= options.maxBatch;
+      });
+    }
+
+    while (!queue.empty() && batch.size() < options.maxBatch) {
+      batch.push_back(std::move(queue.front()));
+      queue.pop_front();
+    }
+    lock.unlock();
+    commit(batch);
+    batch.clear();
+    lock.lock();
+  }
+}
+
+void Writer::commit(std::vector<std::unique_ptr<Job>> &batch) {
+  std::exception_ptr error;
+  try {
+    connection.prepare("BEGIN IMMEDIATE").execute();
+    try {
+      for (std::unique_ptr<Job> &job : batch) {
+        connection.prepare("SAVEPOINT write").execute();
+        if (!job->run(connection)) {
+          connection.prepare("ROLLBACK TO write").execute();
+        }
+        connection.prepare("RELEASE write").execute();
+      }
+      connection.prepare("COMMIT").execute();
+    } catch (...) {
+      // The failing statement may already have ended the transaction
+      if (!sqlite3_get_autocommit(connection.get_db())) {
+        sqlite3_exec(connection.get_db(), "ROLLBACK", nullptr, nullptr,
+                     nullptr);
+      }
+      throw;
+    }
+    batches.fetch_add(1, std::memory_order_relaxed);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  writes.fetch_add(batch.size(), std::memory_order_relaxed);
+  for (std::unique_ptr<Job> &job : batch) {
+    job->complete(error);
+  }
+}
+
+}  // namespace db
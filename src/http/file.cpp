@@ -0,0 +1,170 @@
+#include "file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+namespace http {
+
+std::shared_ptr<const File> File::open(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) < 0 || !S_ISREG(status.st_mode)) {
+    ::close(fd);
+    return nullptr;
+  }
+  return std::shared_ptr<const File>(new File(fd, status));
+}
+
+File::File(int fd, const struct stat &status) : fd(fd), status(status) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "\"%lx-%llx-%llx\"",
+                static_cast<unsigned long>(status.st_ino),
+                static_cast<unsigned long long>(status.st_size),
+                static_cast<unsigned long long>(status.st_mtime));
+  etag = buffer;
+
+  std::tm time;
+  gmtime_r(&status.st_mtime, &time);
+  std::size_t length = std::strftime(buffer, sizeof(buffer),
+                                     "%a, %d %b %Y %H:%M:%S GMT", &time);
+  lastModified.assign(buffer, length);
+}
+
+File::~File() { ::close(fd); }
+
+int File::getFd() const { return fd; }
+
+std::size_t File::getSize() const {
+  return static_cast<std::size_t>(status.st_size);
+}
+
+std::time_t File::getModified() const { return status.st_mtime; }
+
+const std::string &File::getETag() const { return etag; }
+
+const std::string &File::getLastModified() const { return lastModified; }
+
+bool File::isCurrent(const struct stat &current) const {
+  return current.st_dev == status.st_dev && current.st_ino == status.st_ino &&
+         current.st_size == status.st_size &&
+         current.st_mtim.tv_sec == status.st_mtim.tv_sec &&
+         current.st_mtim.tv_nsec == status.st_mtim.tv_nsec;
+}
+
+namespace {
+
+/**
+ * @brief Picks how many shards a cache of a given capacity is split into:
+ * a power of two, and no more than leaves each shard a useful LRU order.
+ */
+std::size_t shardCount(std::size_t capacity, std::size_t most,
+                       std::size_t fewestEntries) {
+  std::size_t count = 1;
+  while (count < most && capacity / (count * 2) >= fewestEntries) {
+    count *= 2;
+  }
+  return count;
+}
+
+}  // namespace
+
+FileCache::FileCache(std::size_t capacity,
+                     std::chrono::milliseconds revalidateAfter)
+    : revalidateAfter(revalidateAfter),
+      shards(shardCount(capacity, kMaxShards, kMinShardCapacity)),
+      hits(0),
+      misses(0) {
+  shardCapacity = (capacity + shards.size() - 1) / shards.size();
+}
+
+std::shared_ptr<const File> FileCache::get(const std::string &path) {
+  Shard &shard = shardFor(path);
+  auto now = std::chrono::steady_clock::now();
+  std::shared_ptr<const File> cached;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(path);
+    if (it != shard.index.end()) {
+      Entry &entry = *it->second;
+      shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+      if (now - entry.checked < revalidateAfter) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return entry.file;
+      }
+      cached = entry.file;
+    }
+  }
+
+  // Revalidate and open outside the lock, so a slow disk only stalls the
+  // lookups of this path
+  if (cached) {
+    struct stat status;
+    if (stat(path.c_str(), &status) == 0 && cached->isCurrent(status)) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.index.find(path);
+      if (it != shard.index.end() && it->second->file == cached) {
+        it->second->checked = now;
+      }
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return cached;
+    }
+  }
+  misses.fetch_add(1, std::memory_order_relaxed);
+
+  std::shared_ptr<const File> file = File::open(path);
+  if (shardCapacity > 0 && (file || cached)) {
+    store(shard, path, file, now);
+  }
+  return file;
+}
+
+std::size_t FileCache::size() const {
+  std::size_t total = 0;
+  for (const Shard &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    total += shard.entries.size();
+  }
+  return total;
+}
+
+std::size_t FileCache::getHits() const {
+  return hits.load(std::memory_order_relaxed);
+}
+
+std::size_t FileCache::getMisses() const {
+  return misses.load(std::memory_order_relaxed);
+}
+
+FileCache::Shard &FileCache::shardFor(const std::string &path) {
+  return shards[std::hash<std::string>()(path) & (shards.size() - 1)];
+}
+
+void FileCache::store(Shard &shard, const std::string &path,
+                      const std::shared_ptr<const File> &file,
+                      std::chrono::steady_clock::time_point now) {
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.index.find(path);
+  if (it != shard.index.end()) {
+    // Changed on disk, or opened by another lookup meanwhile: responses in
+    // flight keep their copy
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+  }
+  if (!file) {
+    return;
+  }
+  shard.entries.push_front(Entry{path, file, now});
+  shard.index[path] = shard.entries.begin();
+  if (shard.entries.size() > shardCapacity) {
+    shard.index.erase(shard.entries.back().path);
+    shard.entries.pop_back();
+  }
+}
+
+}  // namespace http
@@ -0,0 +1,290 @@
+#include "headers.hpp"
+
+#include <cstring>
+
+namespace http {
+
+namespace {
+
+/**
+ * The lowercase names of the well-known headers, in Headers::Known order.
+ */
+constexpr std::string_view kKnownNames[] = {
+    "accept",
+    "accept-encoding",
+    "allow",
+    "cache-control",
+    "connection",
+    "content-length",
+    "content-type",
+    "cookie",
+    "date",
+    "etag",
+    "host",
+    "if-modified-since",
+    "if-none-match",
+    "keep-alive",
+    "last-modified",
+    "location",
+    "range",
+    "server",
+    "transfer-encoding",
+    "user-agent",
+};
+
+static_assert(sizeof(kKnownNames) / sizeof(kKnownNames[0]) ==
+                  static_cast<std::size_t>(Headers::Known::Count),
+              "kKnownNames must list every Headers::Known value");
+
+char lower(char c) { return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c; }
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (lower(a[i]) != lower(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Headers::Iterator::Iterator(const Headers *headers, std::size_t index)
+    : headers(headers), index(index) {}
+
+Headers::Field Headers::Iterator::operator*() const {
+  return (*headers)[index];
+}
+
+Headers::Iterator &Headers::Iterator::operator++() {
+  ++index;
+  return *this;
+}
+
+bool Headers::Iterator::operator==(const Iterator &other) const {
+  return index == other.index;
+}
+
+bool Headers::Iterator::operator!=(const Iterator &other) const {
+  return index != other.index;
+}
+
+Headers::Headers() : Headers(std::pmr::get_default_resource()) {}
+
+Headers::Headers(std::pmr::memory_resource *resource)
+    : arena(resource), spilledEntries(resource), count(0) {
+  knownIndex.fill(kAbsent);
+}
+
+Headers::Headers(std::initializer_list<Field> fields,
+                 std::pmr::memory_resource *resource)
+    : Headers(resource) {
+  for (const auto &field : fields) {
+    set(field.name, field.value);
+  }
+}
+
+Headers::Headers(const std::map<std::string, std::string> &fields)
+    : Headers() {
+  for (const auto &field : fields) {
+    set(field.first, field.second);
+  }
+}
+
+std::size_t Headers::size() const { return count; }
+
+bool Headers::empty() const { return count == 0; }
+
+Headers::Field Headers::operator[](std::size_t index) const {
+  const Entry &record = entry(index);
+  return Field{view(record.nameOffset, record.nameLength),
+               view(record.valueOffset, record.valueLength)};
+}
+
+std::string_view Headers::get(std::string_view name) const {
+  std::size_t index = find(name, classify(name));
+  return index == count ? std::string_view() : (*this)[index].value;
+}
+
+std::string_view Headers::get(Known name) const {
+  std::uint32_t slot = knownIndex[static_cast<std::size_t>(name)];
+  return slot == kAbsent ? std::string_view() : (*this)[slot - 1].value;
+}
+
+bool Headers::has(std::string_view name) const {
+  return find(name, classify(name)) != count;
+}
+
+bool Headers::has(Known name) const {
+  return knownIndex[static_cast<std::size_t>(name)] != kAbsent;
+}
+
+void Headers::set(std::string_view name, std::string_view value) {
+  std::size_t index = find(name, classify(name));
+  if (index == count) {
+    add(name, value);
+    return;
+  }
+
+  Entry &record = entry(index);
+  if (value.size() <= record.valueLength) {
+    // Overwrite in place; the shortened tail stays unused until clear()
+    std::memcpy(&arena[record.valueOffset], value.data(), value.size());
+  } else {
+    record.valueOffset = store(value);
+  }
+  record.valueLength = static_cast<std::uint32_t>(value.size());
+}
+
+void Headers::add(std::string_view name, std::string_view value) {
+  Entry record;
+  record.nameOffset = store(name);
+  record.nameLength = static_cast<std::uint32_t>(name.size());
+  record.valueOffset = store(value);
+  record.valueLength = static_cast<std::uint32_t>(value.size());
+  record.known = classify(name);
+
+  if (count < kInlineCapacity) {
+    inlineEntries[count] = record;
+  } else {
+    spilledEntries.push_back(record);
+  }
+  ++count;
+
+  if (record.known != Known::Count) {
+    std::uint32_t &slot = knownIndex[static_cast<std::size_t>(record.known)];
+    if (slot == kAbsent) {
+      slot = static_cast<std::uint32_t>(count);
+    }
+  }
+}
+
+bool Headers::remove(std::string_view name) {
+  Known known = classify(name);
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const Entry &record = entry(i);
+    std::string_view recordName = view(record.nameOffset, record.nameLength);
+    bool matches =
+        record.known == known &&
+        (known != Known::Count || equalsIgnoreCase(recordName, name));
+    if (!matches) {
+      entry(kept++) = record;
+    }
+  }
+  if (kept == count) {
+    return false;
+  }
+
+  count = kept;
+  if (count <= kInlineCapacity) {
+    spilledEntries.clear();
+  } else {
+    spilledEntries.resize(count - kInlineCapacity);
+  }
+  reindex();
+  return true;
+}
+
+void Headers::clear() {
+  arena.clear();
+  spilledEntries.clear();
+  count = 0;
+  knownIndex.fill(kAbsent);
+}
+
+void Headers::reserve(std::size_t bytes) { arena.reserve(bytes); }
+
+std::pmr::memory_resource *Headers::getResource() const {
+  return arena.get_allocator().resource();
+}
+
+Headers::Iterator Headers::begin() const { return Iterator(this, 0); }
+
+Headers::Iterator Headers::end() const { return Iterator(this, count); }
+
+bool Headers::operator==(const Headers &other) const {
+  if (count != other.count) {
+    return false;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    Field a = (*this)[i];
+    Field b = other[i];
+    if (a.name != b.name || a.value != b.value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Headers::operator!=(const Headers &other) const {
+  return !(*this == other);
+}
+
+Headers::Known Headers::classify(std::string_view name) {
+  if (name.empty()) {
+    return Known::Count;
+  }
+  // Header names of the same length rarely share a first letter, so this
+  // rejects almost every candidate after two comparisons
+  for (std::size_t i = 0; i < static_cast<std::size_t>(Known::Count); ++i) {
+    std::string_view candidate = kKnownNames[i];
+    if (candidate.size() == name.size() && candidate[0] == lower(name[0]) &&
+        equalsIgnoreCase(candidate, name)) {
+      return static_cast<Known>(i);
+    }
+  }
+  return Known::Count;
+}
+
+Headers::Entry &Headers::entry(std::size_t index) {
+  return index < kInlineCapacity ? inlineEntries[index]
+                                 : spilledEntries[index - kInlineCapacity];
+}
+
+const Headers::Entry &Headers::entry(std::size_t index) const {
+  return index < kInlineCapacity ? inlineEntries[index]
+                                 : spilledEntries[index - kInlineCapacity];
+}
+
+std::size_t Headers::find(std::string_view name, Known known) const {
+  if (known != Known::Count) {
+    std::uint32_t slot = knownIndex[static_cast<std::size_t>(known)];
+    return slot == kAbsent ? count : slot - 1;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    const Entry &record = entry(i);
+    if (record.known == Known::Count &&
+        equalsIgnoreCase(view(record.nameOffset, record.nameLength), name)) {
+      return i;
+    }
+  }
+  return count;
+}
+
+std::uint32_t Headers::store(std::string_view text) {
+  auto offset = static_cast<std::uint32_t>(arena.size());
+  arena.append(text.data(), text.size());
+  return offset;
+}
+
+void Headers::reindex() {
+  knownIndex.fill(kAbsent);
+  for (std::size_t i = count; i-- > 0;) {
+    const Entry &record = entry(i);
+    if (record.known != Known::Count) {
+      knownIndex[static_cast<std::size_t>(record.known)] =
+          static_cast<std::uint32_t>(i + 1);
+    }
+  }
+}
+
+std::string_view Headers::view(std::uint32_t offset,
+                               std::size_t length) const {
+  return std::string_view(arena).substr(offset, length);
+}
+
+}  // namespace http
@@ -0,0 +1,67 @@
+#include "method.hpp"
+
+#include <cstddef>
+
+namespace http {
+
+namespace {
+
+/**
+ * Canonical method names, indexed by Method.
+ */
+constexpr std::string_view kMethodNames[] = {
+    "GET",     "HEAD",    "POST",  "PUT",   "DELETE",
+    "CONNECT", "OPTIONS", "TRACE", "PATCH",
+};
+
+static_assert(sizeof(kMethodNames) / sizeof(kMethodNames[0]) ==
+                  static_cast<std::size_t>(Method::Count),
+              "every method needs a name");
+
+char upper(char c) { return c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c; }
+
+}  // namespace
+
+Method parseMethod(std::string_view name) {
+  if (name.empty()) {
+    return Method::Count;
+  }
+  // Method names of the same length rarely share a first letter, so this
+  // rejects almost every candidate after two comparisons
+  char first = upper(name[0]);
+  for (std::size_t i = 0; i < static_cast<std::size_t>(Method::Count); ++i) {
+    std::string_view candidate = kMethodNames[i];
+    if (candidate.size() != name.size() || candidate[0] != first) {
+      continue;
+    }
+    std::size_t j = 1;
+    while (j < name.size() && upper(name[j]) == candidate[j]) {
+      ++j;
+    }
+    if (j == name.size()) {
+      return static_cast<Method>(i);
+    }
+  }
+  return Method::Count;
+}
+
+std::string_view methodName(Method method) {
+  return method == Method::Count
+             ? std::string_view()
+             : kMethodNames[static_cast<std::size_t>(method)];
+}
+
+std::string formatMethods(MethodSet methods) {
+  std::string list;
+  for (std::size_t i = 0; i < static_cast<std::size_t>(Method::Count); ++i) {
+    if (methods & methodBit(static_cast<Method>(i))) {
+      if (!list.empty()) {
+        list += ", ";
+      }
+      list += kMethodNames[i];
+    }
+  }
+  return list;
+}
+
+}  // namespace http
@@ -0,0 +1,155 @@
+#include "parameters.hpp"
+
+namespace http {
+
+namespace {
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/**
+ * Decodes one form-encoded component onto the end of a string.
+ */
+void decode(std::string_view encoded, std::pmr::string &decoded) {
+  for (std::size_t i = 0; i < encoded.size(); ++i) {
+    char c = encoded[i];
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%' && i + 2 < encoded.size()) {
+      int high = hexValue(encoded[i + 1]);
+      int low = hexValue(encoded[i + 2]);
+      if (high >= 0 && low >= 0) {
+        c = static_cast<char>(high * 16 + low);
+        i += 2;
+      }
+    }
+    decoded.push_back(c);
+  }
+}
+
+}  // namespace
+
+Parameters::Iterator::Iterator(const Parameters *parameters, std::size_t index)
+    : parameters(parameters), index(index) {}
+
+Parameters::Field Parameters::Iterator::operator*() const {
+  return (*parameters)[index];
+}
+
+Parameters::Iterator &Parameters::Iterator::operator++() {
+  ++index;
+  return *this;
+}
+
+bool Parameters::Iterator::operator==(const Iterator &other) const {
+  return index == other.index;
+}
+
+bool Parameters::Iterator::operator!=(const Iterator &other) const {
+  return index != other.index;
+}
+
+Parameters::Parameters() : Parameters(std::pmr::get_default_resource()) {}
+
+Parameters::Parameters(std::pmr::memory_resource *resource)
+    : data(resource), entries(resource) {}
+
+void Parameters::parse(std::string_view encoded) {
+  clear();
+  // Decoding never lengthens the text, so the data never reallocates
+  data.reserve(encoded.size());
+
+  std::size_t position = 0;
+  while (position < encoded.size()) {
+    std::size_t end = encoded.find('&', position);
+    if (end == std::string_view::npos) {
+      end = encoded.size();
+    }
+    std::string_view pair = encoded.substr(position, end - position);
+    position = end + 1;
+    if (pair.empty()) {
+      continue;
+    }
+
+    std::size_t equals = pair.find('=');
+    Entry entry;
+    entry.nameOffset = static_cast<std::uint32_t>(data.size());
+    decode(pair.substr(0, equals), data);
+    entry.nameLength = static_cast<std::uint32_t>(data.size()) -
+                       entry.nameOffset;
+    entry.valueOffset = static_cast<std::uint32_t>(data.size());
+    if (equals != std::string_view::npos) {
+      decode(pair.substr(equals + 1), data);
+    }
+    entry.valueLength = static_cast<std::uint32_t>(data.size()) -
+                        entry.valueOffset;
+    entries.push_back(entry);
+  }
+}
+
+std::size_t Parameters::size() const { return entries.size(); }
+
+bool Parameters::empty() const { return entries.empty(); }
+
+Parameters::Field Parameters::operator[](std::size_t index) const {
+  const Entry &entry = entries[index];
+  return Field{view(entry.nameOffset, entry.nameLength),
+               view(entry.valueOffset, entry.valueLength)};
+}
+
+std::string_view Parameters::get(std::string_view name) const {
+  for (std::size_t i = entries.size(); i > 0; --i) {
+    const Entry &entry = entries[i - 1];
+    if (view(entry.nameOffset, entry.nameLength) == name) {
+      return view(entry.valueOffset, entry.valueLength);
+    }
+  }
+  return std::string_view();
+}
+
+std::vector<std::string_view> Parameters::getAll(std::string_view name) const {
+  std::vector<std::string_view> values;
+  for (const Entry &entry : entries) {
+    if (view(entry.nameOffset, entry.nameLength) == name) {
+      values.push_back(view(entry.valueOffset, entry.valueLength));
+    }
+  }
+  return values;
+}
+
+bool Parameters::has(std::string_view name) const {
+  for (const Entry &entry : entries) {
+    if (view(entry.nameOffset, entry.nameLength) == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Parameters::clear() {
+  data.clear();
+  entries.clear();
+}
+
+Parameters::Iterator Parameters::begin() const { return Iterator(this, 0); }
+
+Parameters::Iterator Parameters::end() const {
+  return Iterator(this, entries.size());
+}
+
+std::string_view Parameters::view(std::uint32_t offset,
+                                  std::uint32_t length) const {
+  return std::string_view(data.data() + offset, length);
+}
+
+}  // namespace http
@@ -0,0 +1,369 @@
+#include "parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "scan.hpp"
+
+namespace http {
+
+namespace {
+
+constexpr std::size_t kMaxChunkLine = 1024;  ///< Chunk-size line limit.
+
+/**
+ * Lookup table of the characters allowed in a method or header name.
+ */
+const std::array<bool, 256> kTokenTable = [] {
+  std::array<bool, 256> table{};
+  for (int c = 0; c < 256; ++c) {
+    table[c] = std::isalnum(c) ||
+               std::string_view("!#$%&'*+-.^_`|~").find(static_cast<char>(c)) !=
+                   std::string_view::npos;
+  }
+  return table;
+}();
+
+/**
+ * Returns true for the characters allowed in a method or header name.
+ */
+bool isToken(char c) { return kTokenTable[static_cast<unsigned char>(c)]; }
+
+bool isToken(std::string_view text) {
+  return !text.empty() && std::all_of(text.begin(), text.end(),
+                                      [](char c) { return isToken(c); });
+}
+
+/**
+ * Compares an ASCII string with a lowercase literal, ignoring case.
+ */
+bool equalsLower(std::string_view text, std::string_view lower) {
+  return text.size() == lower.size() &&
+         std::equal(text.begin(), text.end(), lower.begin(),
+                    [](char a, char b) {
+                      return std::tolower(static_cast<unsigned char>(a)) == b;
+                    });
+}
+
+/**
+ * Parses a non-empty run of decimal digits.
+ */
+bool parseDecimal(std::string_view text, std::size_t &value) {
+  if (text.empty() || text.size() > 18) {
+    return false;
+  }
+  value = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + static_cast<std::size_t>(c - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
+Parser::Parser(std::size_t maxHeaderSize, std::size_t maxBodySize)
+    : maxHeaderSize(maxHeaderSize), maxBodySize(maxBodySize) {
+  reset();
+}
+
+void Parser::reset() {
+  buffer = std::string_view();
+  state = State::RequestLine;
+  position = 0;
+  scanned = 0;
+  errorStatus = 0;
+  method = uri = version = body = Span{0, 0};
+  headers.clear();
+  framed = false;
+  lengthSeen = false;
+  chunked = false;
+  contentLength = 0;
+  remaining = 0;
+  chunkedBody.clear();
+}
+
+Parser::Status Parser::parse(std::string_view data) {
+  buffer = data;
+  while (true) {
+    Span line;
+    switch (state) {
+      case State::RequestLine:
+      case State::Headers:
+        if (!nextLine(line)) {
+          return data.size() > maxHeaderSize ? fail(431) : Status::Incomplete;
+        }
+        if (position > maxHeaderSize) {
+          return fail(431);
+        }
+        if (state == State::RequestLine) {
+          // Tolerate empty lines before the request line
+          if (line.length > 0) {
+            if (!parseRequestLine(line)) {
+              return Status::Error;
+            }
+            state = State::Headers;
+          }
+        } else if (line.length == 0) {
+          if (!finishHeaders()) {
+            return Status::Error;
+          }
+        } else if (!parseHeader(line)) {
+          return Status::Error;
+        }
+        break;
+
+      case State::Body:
+        if (data.size() - position < contentLength) {
+          return Status::Incomplete;
+        }
+        body = Span{position, contentLength};
+        position += contentLength;
+        state = State::Done;
+        break;
+
+      case State::ChunkSize:
+        if (!nextLine(line)) {
+          return data.size() - position > kMaxChunkLine ? fail(400)
+                                                        : Status::Incomplete;
+        }
+        if (!parseChunkSize(line)) {
+          return Status::Error;
+        }
+        break;
+
+      case State::ChunkData: {
+        std::size_t available = std::min(remaining, data.size() - position);
+        if (available == 0) {
+          return Status::Incomplete;
+        }
+        chunkedBody.append(data.data() + position, available);
+        position += available;
+        scanned = position;
+        remaining -= available;
+        if (remaining == 0) {
+          state = State::ChunkDataEnd;
+        }
+        break;
+      }
+
+      case State::ChunkDataEnd:
+        if (!nextLine(line)) {
+          return data.size() - position > 2 ? fail(400) : Status::Incomplete;
+        }
+        if (line.length != 0) {
+          return fail(400);
+        }
+        state = State::ChunkSize;
+        break;
+
+      case State::Trailers:
+        // Trailer fields are accepted but not exposed
+        if (!nextLine(line)) {
+          return data.size() - position > maxHeaderSize ? fail(431)
+                                                        : Status::Incomplete;
+        }
+        if (line.length == 0) {
+          state = State::Done;
+        }
+        break;
+
+      case State::Done:
+        return Status::Complete;
+
+      case State::Failed:
+        return Status::Error;
+    }
+  }
+}
+
+std::size_t Parser::getConsumed() const { return position; }
+
+int Parser::getErrorStatus() const { return errorStatus; }
+
+std::string_view Parser::getMethod() const { return view(method); }
+
+std::string_view Parser::getUri() const { return view(uri); }
+
+std::string_view Parser::getVersion() const { return view(version); }
+
+std::size_t Parser::getHeaderCount() const { return headers.size(); }
+
+bool Parser::hasHead() const {
+  return state != State::RequestLine && state != State::Headers &&
+         state != State::Failed;
+}
+
+Parser::Header Parser::getHeader(std::size_t index) const {
+  return Header{view(headers[index].name), view(headers[index].value)};
+}
+
+std::string_view Parser::getBody() const {
+  return chunked ? std::string_view(chunkedBody) : view(body);
+}
+
+bool Parser::hasFraming() const { return framed; }
+
+void Parser::toRequest(Request &request) const {
+  request.assign(getMethod(), getUri(), getVersion(), getBody());
+  for (std::size_t i = 0; i < headers.size(); ++i) {
+    Header header = getHeader(i);
+    request.addHeader(header.name, header.value);
+  }
+}
+
+bool Parser::nextLine(Span &line) {
+  std::size_t end = scan::findLineEnd(buffer, std::max(position, scanned));
+  if (end == std::string_view::npos) {
+    // Remember how far we looked so the next call resumes there
+    scanned = buffer.size();
+    return false;
+  }
+
+  line = Span{position, end - position};
+  if (line.length > 0 && buffer[end - 1] == '\r') {
+    --line.length;
+  }
+  position = end + 1;
+  scanned = position;
+  return true;
+}
+
+bool Parser::parseRequestLine(Span line) {
+  std::string_view text = view(line);
+  std::size_t first = scan::find(text, ' ');
+  std::size_t second = first == std::string_view::npos
+                           ? first
+                           : scan::find(text, ' ', first + 1);
+  if (second == std::string_view::npos ||
+      scan::find(text, ' ', second + 1) != std::string_view::npos) {
+    fail(400);
+    return false;
+  }
+
+  method = Span{line.offset, first};
+  uri = Span{line.offset + first + 1, second - first - 1};
+  version = Span{line.offset + second + 1, text.size() - second - 1};
+
+  std::string_view versionText = view(version);
+  if (!isToken(view(method)) || uri.length == 0 ||
+      versionText.size() != 8 || versionText.compare(0, 5, "HTTP/") != 0) {
+    fail(400);
+    return false;
+  }
+  return true;
+}
+
+bool Parser::parseHeader(Span line) {
+  std::string_view text = view(line);
+  std::size_t colon = scan::find(text, ':');
+  if (colon == std::string_view::npos || !isToken(text.substr(0, colon))) {
+    // Also rejects obsolete line folding, which starts with whitespace
+    fail(400);
+    return false;
+  }
+
+  std::size_t start = colon + 1;
+  std::size_t end = text.size();
+  while (start < end && (text[start] == ' ' || text[start] == '\t')) {
+    ++start;
+  }
+  while (end > start && (text[end - 1] == ' ' || text[end - 1] == '\t')) {
+    --end;
+  }
+
+  Span name{line.offset, colon};
+  Span value{line.offset + start, end - start};
+  headers.push_back(HeaderSpan{name, value});
+
+  std::string_view nameText = view(name);
+  std::string_view valueText = view(value);
+  if (equalsLower(nameText, "content-length")) {
+    std::size_t length = 0;
+    if (!parseDecimal(valueText, length) ||
+        (lengthSeen && length != contentLength)) {
+      fail(400);
+      return false;
+    }
+    if (length > maxBodySize) {
+      fail(413);
+      return false;
+    }
+    contentLength = length;
+    lengthSeen = true;
+    framed = true;
+  } else if (equalsLower(nameText, "transfer-encoding")) {
+    if (!equalsLower(valueText, "chunked")) {
+      fail(501);
+      return false;
+    }
+    chunked = true;
+    framed = true;
+  }
+  return true;
+}
+
+bool Parser::finishHeaders() {
+  if (chunked && lengthSeen) {
+    // Ambiguous framing is a request smuggling vector
+    fail(400);
+    return false;
+  }
+  if (chunked) {
+    state = State::ChunkSize;
+  } else if (contentLength > 0) {
+    state = State::Body;
+  } else {
+    body = Span{position, 0};
+    state = State::Done;
+  }
+  return true;
+}
+
+bool Parser::parseChunkSize(Span line) {
+  std::string_view text = view(line);
+  std::size_t size = 0;
+  std::size_t digits = 0;
+  while (digits < text.size() &&
+         std::isxdigit(static_cast<unsigned char>(text[digits]))) {
+    if (digits == 15) {
+      fail(413);
+      return false;
+    }
+    int c = std::tolower(static_cast<unsigned char>(text[digits]));
+    size = size * 16 +
+           static_cast<std::size_t>(c <= '9' ? c - '0' : c - 'a' + 10);
+    ++digits;
+  }
+
+  // Chunk extensions after ';' are ignored
+  std::string_view rest = text.substr(digits);
+  if (digits == 0 || (!rest.empty() && rest.front() != ';' &&
+                      rest.front() != ' ' && rest.front() != '\t')) {
+    fail(400);
+    return false;
+  }
+  if (size > maxBodySize - chunkedBody.size()) {
+    fail(413);
+    return false;
+  }
+
+  remaining = size;
+  state = size == 0 ? State::Trailers : State::ChunkData;
+  return true;
+}
+
+Parser::Status Parser::fail(int status) {
+  state = State::Failed;
+  errorStatus = status;
+  return Status::Error;
+}
+
+std::string_view Parser::view(Span span) const {
+  return buffer.substr(span.offset, span.length);
+}
+
+}  // namespace http
@@ -2,155 +2,273 @@
 
 #include <algorithm>
 #include <sstream>
+#include <utility>
 #include <vector>
 
+#include "parser.hpp"
+
 namespace http {
 
-Request::Request() : method(""), uri(""), version(""), body("") {}
+namespace {
 
-Request::Request(const std::string &method, const std::string &uri,
-                 const std::string &version, const std::string &body,
-                 const std::map<std::string, std::string> &headers)
-    : method(method),
-      uri(uri),
-      version(version),
-      body(body),
-      headers(headers) {}
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    char x = a[i] >= 'A' && a[i] <= 'Z' ? a[i] + ('a' - 'A') : a[i];
+    char y = b[i] >= 'A' && b[i] <= 'Z' ? b[i] + ('a' - 'A') : b[i];
+    if (x != y) {
+      return false;
+    }
+  }
+  return true;
+}
 
-std::string Request::getMethod() const { return method; }
+}  // namespace
 
-std::string Request::getUri() const { return uri; }
+Request::Request()
+    : method(""),
+      methodId(Method::Count),
+      uri(""),
+      version(""),
+      body(""),
+      queryParsed(false),
+      inputParsed(false) {}
 
-std::string Request::getVersion() const { return version; }
+Request::Request(std::pmr::memory_resource *resource)
+    : methodId(Method::Count),
+      headers(resource),
+      parameters(resource),
+      query(resource),
+      input(resource),
+      queryParsed(false),
+      inputParsed(false) {}
 
-std::string Request::getHeader(const std::string &key) const {
-  auto it = headers.find(key);
-  if (it != headers.end()) {
-    return it->second;
-  }
-  return "";
+Request::Request(std::string method, std::string uri, std::string version,
+                 std::string body, Headers headers)
+    : method(std::move(method)),
+      methodId(parseMethod(this->method)),
+      uri(std::move(uri)),
+      version(std::move(version)),
+      body(std::move(body)),
+      headers(std::move(headers)),
+      parameters(this->headers.getResource()),
+      query(this->headers.getResource()),
+      input(this->headers.getResource()),
+      queryParsed(false),
+      inputParsed(false) {}
+
+const std::string &Request::getMethod() const { return method; }
+
+Method Request::getMethodId() const { return methodId; }
+
+const std::string &Request::getUri() const { return uri; }
+
+const std::string &Request::getVersion() const { return version; }
+
+std::string Request::getHeader(std::string_view key) const {
+  return std::string(headers.get(key));
+}
+
+const Headers &Request::getHeaders() const { return headers; }
+
+std::pmr::memory_resource *Request::getResource() const {
+  return headers.getResource();
+}
+
+const std::string &Request::getBody() const { return body; }
+
+void Request::setMethod(std::string method) {
+  this->method = std::move(method);
+  methodId = parseMethod(this->method);
+}
+
+void Request::setUri(std::string uri) {
+  this->uri = std::move(uri);
+  parameters.clear();
+  queryParsed = false;
 }
 
-std::map<std::string, std::string> Request::getHeaders() const {
-  return headers;
+void Request::setVersion(std::string version) {
+  this->version = std::move(version);
 }
 
-std::string Request::getBody() const { return body; }
+void Request::setHeader(std::string_view key, std::string_view value) {
+  headers.set(key, value);
+}
 
-void Request::setMethod(const std::string &method) { this->method = method; }
+void Request::addHeader(std::string_view key, std::string_view value) {
+  headers.add(key, value);
+}
 
-void Request::setUri(const std::string &uri) { this->uri = uri; }
+void Request::setBody(std::string body) {
+  this->body = std::move(body);
+  inputParsed = false;
+}
 
-void Request::setVersion(const std::string &version) {
-  this->version = version;
+void Request::assign(std::string_view method, std::string_view uri,
+                     std::string_view version, std::string_view body) {
+  this->method.assign(method);
+  methodId = parseMethod(method);
+  this->uri.assign(uri);
+  this->version.assign(version);
+  this->body.assign(body);
+  parameters.clear();
+  queryParsed = false;
+  inputParsed = false;
 }
 
-void Request::setHeader(const std::string &key, const std::string &value) {
-  headers[key] = value;
+void Request::clear() {
+  std::pmr::memory_resource *resource = getResource();
+  assign({}, {}, {}, {});
+  // Replaced rather than cleared, which would keep their capacity
+  headers = Headers(resource);
+  parameters = std::pmr::vector<Parameter>(resource);
+  query = Parameters(resource);
+  input = Parameters(resource);
 }
 
-void Request::setBody(const std::string &body) { this->body = body; }
+const Parameters &Request::getQuery() const {
+  if (!queryParsed) {
+    std::size_t mark = uri.find('?');
+    query.parse(mark == std::string::npos
+                    ? std::string_view()
+                    : std::string_view(uri).substr(mark + 1));
+    queryParsed = true;
+  }
+  return query;
+}
 
 std::map<std::string, std::string> Request::getQueryParameters() const {
   std::map<std::string, std::string> queryParams;
-  auto pos = uri.find('?');
-  if (pos != std::string::npos) {
-    std::string query = uri.substr(pos + 1);
-    std::istringstream queryStream(query);
-    std::string pair;
-    while (std::getline(queryStream, pair, '&')) {
-      auto equalsPos = pair.find('=');
-      if (equalsPos != std::string::npos) {
-        std::string key = pair.substr(0, equalsPos);
-        std::string value = pair.substr(equalsPos + 1);
-        queryParams[key] = value;
-      }
-    }
+  for (const auto &field : getQuery()) {
+    queryParams[std::string(field.name)] = std::string(field.value);
   }
   return queryParams;
 }
 
 std::string Request::getQueryParameter(const std::string &key) const {
-  auto queryParams = getQueryParameters();
-  auto it = queryParams.find(key);
-  if (it != queryParams.end()) {
-    return it->second;
+  return std::string(getQuery().get(key));
+}
+
+std::string Request::getPath() const { return std::string(getPathView()); }
+
+std::string_view Request::getPathView() const {
+  return std::string_view(uri).substr(0, uri.find('?'));
+}
+
+bool Request::isKeepAlive() const {
+  bool close = false;
+  bool keepAlive = false;
+  std::string_view list = headers.get(Headers::Known::Connection);
+  while (!list.empty()) {
+    std::size_t comma = list.find(',');
+    std::string_view token = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view()
+                                           : list.substr(comma + 1);
+    while (!token.empty() && (token.front() == ' ' || token.front() == '\t')) {
+      token.remove_prefix(1);
+    }
+    while (!token.empty() && (token.back() == ' ' || token.back() == '\t')) {
+      token.remove_suffix(1);
+    }
+    close = close || equalsIgnoreCase(token, "close");
+    keepAlive = keepAlive || equalsIgnoreCase(token, "keep-alive");
+  }
+  if (close) {
+    return false;
   }
-  return "";
+  return version == "HTTP/1.1" || keepAlive;
 }
 
-std::string Request::getPath() const {
-  auto pos = uri.find('?');
-  if (pos != std::string::npos) {
-    return uri.substr(0, pos);
+const Parameters &Request::getInput() const {
+  if (!inputParsed) {
+    input.parse(body);
+    inputParsed = true;
   }
-  return uri;
+  return input;
 }
 
 std::map<std::string, std::string> Request::getInputParameters() const {
   std::map<std::string, std::string> inputParams;
-  std::istringstream bodyStream(body);
-  std::string pair;
-  while (std::getline(bodyStream, pair, '&')) {
-    auto equalsPos = pair.find('=');
-    if (equalsPos != std::string::npos) {
-      std::string key = pair.substr(0, equalsPos);
-      std::string value = pair.substr(equalsPos + 1);
-      inputParams[key] = value;
-    }
+  for (const auto &field : getInput()) {
+    inputParams[std::string(field.name)] = std::string(field.value);
   }
   return inputParams;
 }
 
 std::string Request::getInputParameter(const std::string &key) const {
-  auto inputParams = getInputParameters();
-  auto it = inputParams.find(key);
-  if (it != inputParams.end()) {
-    return it->second;
+  return std::string(getInput().get(key));
+}
+
+std::string_view Request::getParameter(std::string_view name) const {
+  for (const auto &parameter : parameters) {
+    if (parameter.name == name) {
+      return std::string_view(uri).substr(parameter.offset, parameter.length);
+    }
   }
-  return "";
+  return std::string_view();
 }
 
-void Request::parseRequest(const std::string &rawRequest) {
-  std::istringstream stream(rawRequest);
-  std::string line;
+bool Request::hasParameter(std::string_view name) const {
+  for (const auto &parameter : parameters) {
+    if (parameter.name == name) {
+      return true;
+    }
+  }
+  return false;
+}
 
-  // Parse request line
-  if (std::getline(stream, line)) {
-    std::istringstream lineStream(line);
-    lineStream >> method >> uri >> version;
+void Request::setParameters(const std::vector<std::string> &names,
+                            const std::vector<std::string_view> &values) const {
+  parameters.clear();
+  std::size_t count = std::min(names.size(), values.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    auto offset = static_cast<std::size_t>(values[i].data() - uri.data());
+    parameters.push_back({names[i], offset, values[i].size()});
   }
+}
 
-  // Parse headers
-  while (std::getline(stream, line) && line != "\r") {
-    if (line.back() == '\r') {
-      line.pop_back();  // Remove the trailing '\r'
-    }
-    std::size_t delimiterPosition = line.find(": ");
-    if (delimiterPosition != std::string::npos) {
-      std::string key = line.substr(0, delimiterPosition);
-      std::string value = line.substr(delimiterPosition + 2);
-      headers[key] = value;
-    }
+void Request::parseRequest(const std::string &rawRequest) {
+  parameters.clear();
+  queryParsed = false;
+  inputParsed = false;
+
+  Parser parser;
+  Parser::Status status = parser.parse(rawRequest);
+
+  method = parser.getMethod();
+  methodId = parseMethod(method);
+  uri = parser.getUri();
+  version = parser.getVersion();
+  headers.clear();
+  for (std::size_t i = 0; i < parser.getHeaderCount(); ++i) {
+    Parser::Header header = parser.getHeader(i);
+    headers.add(header.name, header.value);
   }
 
-  // Parse body
-  std::stringstream bodyStream;
-  while (std::getline(stream, line)) {
-    bodyStream << line << "\n";
+  if (status != Parser::Status::Complete) {
+    body.clear();
+  } else if (parser.hasFraming()) {
+    body = parser.getBody();
+  } else {
+    // Without framing headers, the rest of the message is the body
+    body = rawRequest.substr(parser.getConsumed());
   }
-  body = bodyStream.str();
 }
 
 std::string Request::toString() const {
   std::ostringstream requestStream;
   requestStream << method << " " << uri << " " << version << "\r\n";
-  // Copy headers to a vector and sort by key to ensure consistent order
-  std::vector<std::pair<std::string, std::string>> sortedHeaders(
-      headers.begin(), headers.end());
-  std::sort(sortedHeaders.begin(), sortedHeaders.end());
+  // Copy headers to a vector and sort by name to ensure consistent order
+  std::vector<Headers::Field> sortedHeaders(headers.begin(), headers.end());
+  std::sort(sortedHeaders.begin(), sortedHeaders.end(),
+            [](const Headers::Field &a, const Headers::Field &b) {
+              return a.name < b.name;
+            });
   for (const auto &header : sortedHeaders) {
-    requestStream << header.first << ": " << header.second << "\r\n";
+    requestStream << header.name << ": " << header.value << "\r\n";
   }
   requestStream << "\r\n" << body;
   return requestStream.str();
@@ -1,102 +1,200 @@
 #include "response.hpp"
 
+#include <unistd.h>
+
 #include <algorithm>
-#include <sstream>
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-namespace http {
+#include "file.hpp"
+#include "scan.hpp"
 
-Response::Response() : statusCode(200), statusMessage("OK"), body("") {}
+namespace http {
 
-Response::Response(int statusCode, const std::string &statusMessage,
-                   const std::string &body,
-                   const std::map<std::string, std::string> &headers)
+Response::Response()
+    : statusCode(200),
+      statusMessage("OK"),
+      body(""),
+      fileOffset(0),
+      fileLength(0) {}
+
+Response::Response(std::pmr::memory_resource *resource)
+    : statusCode(200),
+      statusMessage("OK"),
+      headers(resource),
+      body(""),
+      fileOffset(0),
+      fileLength(0) {}
+
+Response::Response(int statusCode, std::string statusMessage,
+                   std::string body, Headers headers)
     : statusCode(statusCode),
-      statusMessage(statusMessage),
-      body(body),
-      headers(headers) {}
+      statusMessage(std::move(statusMessage)),
+      headers(std::move(headers)),
+      body(std::move(body)),
+      fileOffset(0),
+      fileLength(0) {}
 
 int Response::getStatusCode() const { return statusCode; }
 
-std::string Response::getStatusMessage() const { return statusMessage; }
+const std::string &Response::getStatusMessage() const {
+  return statusMessage;
+}
 
-std::string Response::getHeader(const std::string &key) const {
-  auto it = headers.find(key);
-  if (it != headers.end()) {
-    return it->second;
-  }
-  return "";
+std::string Response::getHeader(std::string_view key) const {
+  return std::string(headers.get(key));
 }
 
-std::map<std::string, std::string> Response::getHeaders() const {
-  return headers;
+const Headers &Response::getHeaders() const { return headers; }
+
+std::pmr::memory_resource *Response::getResource() const {
+  return headers.getResource();
 }
 
-std::string Response::getBody() const { return body; }
+const std::string &Response::getBody() const { return body; }
 
 void Response::setStatusCode(int statusCode) { this->statusCode = statusCode; }
 
-void Response::setStatusMessage(const std::string &statusMessage) {
-  this->statusMessage = statusMessage;
+void Response::setStatusMessage(std::string statusMessage) {
+  this->statusMessage = std::move(statusMessage);
 }
 
-void Response::setHeader(const std::string &key, const std::string &value) {
-  headers[key] = value;
+void Response::setHeader(std::string_view key, std::string_view value) {
+  headers.set(key, value);
 }
 
-void Response::setBody(const std::string &body) { this->body = body; }
+void Response::setBody(std::string body) {
+  this->body = std::move(body);
+  file.reset();
+  fileOffset = fileLength = 0;
+}
+
+void Response::setFile(std::shared_ptr<const File> file, std::size_t offset,
+                       std::size_t length) {
+  body.clear();
+  this->file = std::move(file);
+  fileOffset = offset;
+  fileLength = length;
+}
+
+const std::shared_ptr<const File> &Response::getFile() const { return file; }
+
+std::size_t Response::getFileOffset() const { return fileOffset; }
+
+std::size_t Response::getFileLength() const { return fileLength; }
+
+std::size_t Response::getContentLength() const {
+  return file ? fileLength : body.size();
+}
 
 void Response::parseResponse(const std::string &rawResponse) {
-  std::istringstream stream(rawResponse);
-  std::string line;
+  std::string_view text(rawResponse);
+  std::size_t position = 0;
+
+  // Returns the next line without its line ending, scanning for '\n' in
+  // vector-sized blocks
+  auto nextLine = [&](std::string_view &line) {
+    if (position >= text.size()) {
+      return false;
+    }
+    std::size_t end = scan::findLineEnd(text, position);
+    std::size_t next = end == std::string_view::npos ? text.size() : end + 1;
+    line = text.substr(position, next - position);
+    if (!line.empty() && line.back() == '\n') {
+      line.remove_suffix(1);
+    }
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    position = next;
+    return true;
+  };
 
   // Parse status line
-  if (std::getline(stream, line)) {
-    std::istringstream lineStream(line);
-    std::string httpVersion;
-    lineStream >> httpVersion >> statusCode;
-    std::getline(lineStream, statusMessage);
-    if (!statusMessage.empty() && statusMessage[0] == ' ') {
-      statusMessage.erase(0, 1);  // Remove leading space
-    }
-    if (!statusMessage.empty() && statusMessage.back() == '\r') {
-      statusMessage.pop_back();  // Remove trailing '\r'
+  std::string_view line;
+  if (nextLine(line)) {
+    std::size_t codeStart = scan::find(line, ' ');
+    if (codeStart != std::string_view::npos) {
+      std::size_t codeEnd = scan::find(line, ' ', codeStart + 1);
+      std::string_view code = line.substr(
+          codeStart + 1, codeEnd == std::string_view::npos
+                             ? std::string_view::npos
+                             : codeEnd - codeStart - 1);
+      statusCode = std::atoi(std::string(code).c_str());
+      statusMessage = codeEnd == std::string_view::npos
+                          ? std::string()
+                          : std::string(line.substr(codeEnd + 1));
     }
   }
 
-  // Parse headers
-  while (std::getline(stream, line) && line != "\r") {
-    if (line.back() == '\r') {
-      line.pop_back();  // Remove the trailing '\r'
-    }
-    std::size_t delimiterPosition = line.find(": ");
-    if (delimiterPosition != std::string::npos) {
-      std::string key = line.substr(0, delimiterPosition);
-      std::string value = line.substr(delimiterPosition + 2);
-      headers[key] = value;
+  // Parse headers, keeping repeated fields such as Set-Cookie
+  headers.clear();
+  while (nextLine(line) && !line.empty()) {
+    std::size_t colon = scan::find(line, ':');
+    if (colon != std::string_view::npos && colon + 1 < line.size() &&
+        line[colon + 1] == ' ') {
+      headers.add(line.substr(0, colon), line.substr(colon + 2));
     }
   }
 
-  // Parse body
-  std::stringstream bodyStream;
-  while (std::getline(stream, line)) {
-    bodyStream << line << "\n";
+  // Parse body, terminating its last line like the line-based reader did
+  body.assign(text.substr(std::min(position, text.size())));
+  if (!body.empty() && body.back() != '\n') {
+    body.push_back('\n');
   }
-  body = bodyStream.str();
 }
 
 std::string Response::toString() const {
-  std::ostringstream responseStream;
-  responseStream << "HTTP/1.1 " << statusCode << " " << statusMessage << "\r\n";
-  // Copy headers to a vector and sort by key to ensure consistent order
-  std::vector<std::pair<std::string, std::string>> sortedHeaders(
-      headers.begin(), headers.end());
-  std::sort(sortedHeaders.begin(), sortedHeaders.end());
-  for (const auto &header : sortedHeaders) {
-    responseStream << header.first << ": " << header.second << "\r\n";
+  std::string response;
+  serializeHead(response, true);
+  response += body;
+  if (file) {
+    // Only debugging and tests get here; servers sendfile() the range
+    std::size_t start = response.size();
+    response.resize(start + fileLength);
+    ssize_t read = pread(file->getFd(), &response[start], fileLength,
+                         static_cast<off_t>(fileOffset));
+    response.resize(start + (read > 0 ? static_cast<std::size_t>(read) : 0));
+  }
+  return response;
+}
+
+void Response::serializeHead(std::string &buffer, bool sortHeaders) const {
+  buffer.clear();
+
+  char code[16];
+  auto result = std::to_chars(code, code + sizeof(code), statusCode);
+  buffer.append("HTTP/1.1 ");
+  buffer.append(code, result.ptr);
+  buffer.push_back(' ');
+  buffer.append(statusMessage);
+  buffer.append("\r\n");
+
+  auto appendField = [&buffer](const Headers::Field &field) {
+    buffer.append(field.name.data(), field.name.size());
+    buffer.append(": ");
+    buffer.append(field.value.data(), field.value.size());
+    buffer.append("\r\n");
+  };
+
+  if (sortHeaders) {
+    std::vector<Headers::Field> sortedHeaders(headers.begin(), headers.end());
+    std::sort(sortedHeaders.begin(), sortedHeaders.end(),
+              [](const Headers::Field &a, const Headers::Field &b) {
+                return a.name < b.name;
+              });
+    for (const auto &field : sortedHeaders) {
+      appendField(field);
+    }
+  } else {
+    for (Headers::Field field : headers) {
+      appendField(field);
+    }
   }
-  responseStream << "\r\n" << body;
-  return responseStream.str();
+  buffer.append("\r\n");
 }
 
 }  // namespace http
@@ -0,0 +1,21 @@
+#include "scan.hpp"
+
+#include <cstring>
+
+namespace http {
+
+namespace scan {
+
+std::size_t find(std::string_view text, char byte, std::size_t from) {
+  if (from >= text.size()) {
+    return std::string_view::npos;
+  }
+  const char *found = static_cast<const char *>(
+      std::memchr(text.data() + from, byte, text.size() - from));
+  return found ? static_cast<std::size_t>(found - text.data())
+               : std::string_view::npos;
+}
+
+}  // namespace scan
+
+}  // namespace http
@@ -0,0 +1,321 @@
+#include "static.hpp"
+
+#include <ctime>
+#include <utility>
+
+namespace http {
+
+namespace {
+
+/**
+ * Media types by file extension.
+ */
+constexpr std::pair<std::string_view, std::string_view> kContentTypes[] = {
+    {"css", "text/css; charset=utf-8"},
+    {"gif", "image/gif"},
+    {"htm", "text/html; charset=utf-8"},
+    {"html", "text/html; charset=utf-8"},
+    {"ico", "image/x-icon"},
+    {"jpeg", "image/jpeg"},
+    {"jpg", "image/jpeg"},
+    {"js", "text/javascript; charset=utf-8"},
+    {"json", "application/json"},
+    {"map", "application/json"},
+    {"mjs", "text/javascript; charset=utf-8"},
+    {"mp4", "video/mp4"},
+    {"pdf", "application/pdf"},
+    {"png", "image/png"},
+    {"svg", "image/svg+xml"},
+    {"txt", "text/plain; charset=utf-8"},
+    {"wasm", "application/wasm"},
+    {"webp", "image/webp"},
+    {"woff", "font/woff"},
+    {"woff2", "font/woff2"},
+    {"xml", "application/xml"},
+};
+
+Response notFound() {
+  return Response(404, "Not Found",
+                  "The requested URL was not found on this server.",
+                  {{"Content-Type", "text/plain"}});
+}
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/**
+ * Decodes a percent-encoded path and checks that it stays below the root.
+ */
+bool decodePath(std::string_view encoded, std::string &decoded) {
+  decoded.clear();
+  for (std::size_t i = 0; i < encoded.size(); ++i) {
+    char c = encoded[i];
+    if (c == '%') {
+      if (i + 2 >= encoded.size()) {
+        return false;
+      }
+      int high = hexValue(encoded[i + 1]);
+      int low = hexValue(encoded[i + 2]);
+      if (high < 0 || low < 0) {
+        return false;
+      }
+      c = static_cast<char>(high * 16 + low);
+      i += 2;
+    }
+    if (c == '\0' || c == '\\') {
+      return false;
+    }
+    decoded.push_back(c);
+  }
+
+  // Reject empty, "." and ".." segments so the path cannot escape the root
+  std::size_t position = 0;
+  while (position <= decoded.size()) {
+    std::size_t end = decoded.find('/', position);
+    if (end == std::string::npos) {
+      end = decoded.size();
+    }
+    std::string_view segment(decoded.data() + position, end - position);
+    if (segment.empty() || segment == "." || segment == "..") {
+      return false;
+    }
+    position = end + 1;
+  }
+  return true;
+}
+
+/**
+ * Parses an IMF-fixdate such as "Sun, 06 Nov 1994 08:49:37 GMT".
+ */
+bool parseHttpDate(std::string_view text, std::time_t &time) {
+  std::string copy(text);
+  std::tm parts{};
+  const char *end =
+      strptime(copy.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &parts);
+  if (!end || *end != '\0') {
+    return false;
+  }
+  time = timegm(&parts);
+  return true;
+}
+
+/**
+ * Checks an If-None-Match list against an entity tag, ignoring weakness.
+ */
+bool matchesETag(std::string_view list, std::string_view etag) {
+  std::size_t position = 0;
+  while (position < list.size()) {
+    std::size_t end = list.find(',', position);
+    if (end == std::string_view::npos) {
+      end = list.size();
+    }
+    std::string_view candidate = list.substr(position, end - position);
+    while (!candidate.empty() && candidate.front() == ' ') {
+      candidate.remove_prefix(1);
+    }
+    while (!candidate.empty() && candidate.back() == ' ') {
+      candidate.remove_suffix(1);
+    }
+    if (candidate.compare(0, 2, "W/") == 0) {
+      candidate.remove_prefix(2);
+    }
+    if (candidate == "*" || candidate == etag) {
+      return true;
+    }
+    position = end + 1;
+  }
+  return false;
+}
+
+bool parseNumber(std::string_view text, std::size_t &value) {
+  if (text.empty() || text.size() > 18) {
+    return false;
+  }
+  value = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + static_cast<std::size_t>(c - '0');
+  }
+  return true;
+}
+
+/**
+ * The outcome of parsing a Range header against a file size.
+ */
+enum class RangeResult { Ignore, Satisfiable, Unsatisfiable };
+
+/**
+ * Parses a single "bytes=" range. Multiple ranges and malformed headers are
+ * ignored, which serves the whole file as RFC 9110 allows.
+ */
+RangeResult parseRange(std::string_view header, std::size_t size,
+                       std::size_t &first, std::size_t &last) {
+  constexpr std::string_view kUnit = "bytes=";
+  if (header.compare(0, kUnit.size(), kUnit) != 0) {
+    return RangeResult::Ignore;
+  }
+  std::string_view spec = header.substr(kUnit.size());
+  std::size_t dash = spec.find('-');
+  if (dash == std::string_view::npos ||
+      spec.find(',') != std::string_view::npos) {
+    return RangeResult::Ignore;
+  }
+
+  std::string_view start = spec.substr(0, dash);
+  std::string_view end = spec.substr(dash + 1);
+  if (start.empty()) {
+    // A suffix range: the last N bytes
+    std::size_t length = 0;
+    if (!parseNumber(end, length)) {
+      return RangeResult::Ignore;
+    }
+    if (length == 0 || size == 0) {
+      return RangeResult::Unsatisfiable;
+    }
+    first = length >= size ? 0 : size - length;
+    last = size - 1;
+    return RangeResult::Satisfiable;
+  }
+
+  if (!parseNumber(start, first)) {
+    return RangeResult::Ignore;
+  }
+  if (end.empty()) {
+    last = size == 0 ? 0 : size - 1;
+  } else if (!parseNumber(end, last) || last < first) {
+    return RangeResult::Ignore;
+  }
+  if (first >= size) {
+    return RangeResult::Unsatisfiable;
+  }
+  if (last >= size) {
+    last = size - 1;
+  }
+  return RangeResult::Satisfiable;
+}
+
+}  // namespace
+
+StaticFiles::StaticFiles(std::string root, std::size_t cacheCapacity,
+                         std::chrono::milliseconds revalidateAfter)
+    : root(std::move(root)),
+      cache(std::make_shared<FileCache>(cacheCapacity, revalidateAfter)) {
+  while (this->root.size() > 1 && this->root.back() == '/') {
+    this->root.pop_back();
+  }
+}
+
+Response StaticFiles::serve(const Request &request,
+                            std::string_view path) const {
+  path = path.substr(0, path.find('?'));
+  std::string relative;
+  if (!decodePath(path, relative)) {
+    return notFound();
+  }
+
+  std::shared_ptr<const File> file = cache->get(root + "/" + relative);
+  if (!file) {
+    return notFound();
+  }
+
+  Response response(200, "OK", "",
+                    {{"Content-Type", contentType(relative)},
+                     {"ETag", file->getETag()},
+                     {"Last-Modified", file->getLastModified()},
+                     {"Accept-Ranges", "bytes"}});
+
+  // If-None-Match takes precedence over If-Modified-Since
+  const Headers &headers = request.getHeaders();
+  std::time_t since = 0;
+  bool notModified =
+      headers.has(Headers::Known::IfNoneMatch)
+          ? matchesETag(headers.get(Headers::Known::IfNoneMatch),
+                        file->getETag())
+          : parseHttpDate(headers.get(Headers::Known::IfModifiedSince),
+                          since) &&
+                file->getModified() <= since;
+  if (notModified) {
+    response.setStatusCode(304);
+    response.setStatusMessage("Not Modified");
+    return response;
+  }
+
+  std::size_t size = file->getSize();
+  std::string_view range = headers.get(Headers::Known::Range);
+  std::string_view ifRange = headers.get("If-Range");
+  bool rangeApplies = !range.empty() &&
+                      (ifRange.empty() || ifRange == file->getETag() ||
+                       ifRange == file->getLastModified());
+  std::size_t first = 0;
+  std::size_t last = 0;
+  RangeResult result = rangeApplies ? parseRange(range, size, first, last)
+                                    : RangeResult::Ignore;
+
+  if (result == RangeResult::Unsatisfiable) {
+    response.setStatusCode(416);
+    response.setStatusMessage("Range Not Satisfiable");
+    response.setHeader("Content-Range", "bytes */" + std::to_string(size));
+    return response;
+  }
+
+  std::size_t offset = 0;
+  std::size_t length = size;
+  if (result == RangeResult::Satisfiable) {
+    response.setStatusCode(206);
+    response.setStatusMessage("Partial Content");
+    response.setHeader("Content-Range", "bytes " + std::to_string(first) +
+                                            "-" + std::to_string(last) + "/" +
+                                            std::to_string(size));
+    offset = first;
+    length = last - first + 1;
+  }
+
+  // A HEAD response announces the body it leaves out
+  if (request.getMethodId() == Method::Head) {
+    response.setHeader("Content-Length", std::to_string(length));
+  } else {
+    response.setFile(std::move(file), offset, length);
+  }
+  return response;
+}
+
+Response StaticFiles::operator()(const Request &request) const {
+  return serve(request, request.getParameter("path"));
+}
+
+const FileCache &StaticFiles::getCache() const { return *cache; }
+
+std::string_view StaticFiles::contentType(std::string_view path) {
+  std::size_t slash = path.rfind('/');
+  std::size_t dot = path.rfind('.');
+  if (dot == std::string_view::npos ||
+      (slash != std::string_view::npos && dot < slash)) {
+    return "application/octet-stream";
+  }
+  std::string extension(path.substr(dot + 1));
+  for (char &c : extension) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  for (const auto &entry : kContentTypes) {
+    if (entry.first == extension) {
+      return entry.second;
+    }
+  }
+  return "application/octet-stream";
+}
+
+}  // namespace http
@@ -1,46 +1,47 @@
+#include <cstdlib>
 #include <iostream>
 
 #include "app.hpp"
-#include "kernel.hpp"
 #include "request.hpp"
 #include "response.hpp"
+#include "server.hpp"
 
 /**
  * @brief Main entry point of the application.
  *
- * This function serves as the starting point for program execution. It takes
- * command line arguments and can use them to influence the program's behavior.
+ * This function serves as the starting point for program execution. It
+ * registers the application's routes and serves them over HTTP until the
+ * process is terminated.
  *
  * @param argc The number of command line arguments.
- * @param argv An array of command line argument strings.
+ * @param argv An array of command line argument strings. The optional first
+ * argument is the port to listen on (defaults to 8080).
  *
  * @return int Returns 0 upon successful execution.
  */
-int main() {
+int main(int argc, char **argv) {
   core::App app;
 
   // Register a GET route
-  app.registerRoute("GET", "/home", [](const http::Request &request) {
+  app.registerRoute("GET", "/home", [](const http::Request &) {
     return http::Response(200, "OK", "Welcome to the home page!",
                           {{"Content-Type", "text/plain"}});
   });
 
   // Register a POST route
-  app.registerRoute("POST", "/submit", [](const http::Request &request) {
+  app.registerRoute("POST", "/submit", [](const http::Request &) {
     return http::Response(200, "OK", "Form submitted successfully!",
                           {{"Content-Type", "text/plain"}});
   });
 
-  core::Kernel kernel(app);
+  int port = argc > 1 ? std::atoi(argv[1]) : 8080;
 
-  // Create a test request
-  http::Request request("GET", "/home", "HTTP/1.1", "", {});
+  core::Server server(app);
+  server.listen("0.0.0.0", port);
 
-  // Handle the request
-  http::Response response = kernel.handleRequest(request);
+  std::cout << "Listening on http://0.0.0.0:" << server.getPort() << std::endl;
 
-  // Output the response
-  std::cout << response.toString() << std::endl;
+  server.run();
 
   return 0;
 }
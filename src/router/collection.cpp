@@ -2,13 +2,16 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <utility>
+
+#include "router.hpp"
 
 namespace router {
 
-void Collection::addRoute(
-    const std::string &method, const std::string &path,
-    const std::function<http::Response(const http::Request &)> &handler) {
-  routes.emplace_back(method, path, handler);
+void Collection::addRoute(const std::string &method, const std::string &path,
+                          Handler handler, bool blocking) {
+  routes.emplace_back(method, path, std::move(handler), blocking);
+  tree.insert(routes.back().getMethodId(), path, routes.size() - 1);
 }
 
 const Route &Collection::getRoute(const std::string &method,
@@ -22,14 +25,18 @@ const Route &Collection::getRoute(const std::string &method,
 }
 
 http::Response Collection::handleRequest(const http::Request &request) const {
-  for (const auto &route : routes) {
-    if (route.matches(request)) {
-      return route.handle(request);
-    }
+  // Reused per thread, as in Router::resolve; the values are copied into the
+  // request before the handler runs, so a nested collection may reuse it
+  thread_local std::vector<std::string_view> captures;
+  http::MethodSet allowed = 0;
+  std::size_t index = tree.find(request.getMethodId(), request.getPathView(),
+                                &captures, &allowed);
+  if (index != Tree::npos) {
+    const Route &route = routes[index];
+    request.setParameters(route.getParameterNames(), captures);
+    return route.handle(request);
   }
-  return http::Response(404, "Not Found",
-                        "The requested URL was not found on this server.",
-                        {{"Content-Type", "text/plain"}});
+  return Router::unmatched(allowed, request.getResource());
 }
 
 void Collection::removeRoute(const std::string &method,
@@ -40,6 +47,12 @@ void Collection::removeRoute(const std::string &method,
                                        route.getPath() == path;
                               }),
                routes.end());
+
+  // Route indices shift on removal, so the tree is rebuilt from scratch
+  tree.clear();
+  for (std::size_t index = 0; index < routes.size(); ++index) {
+    tree.insert(routes[index].getMethodId(), routes[index].getPath(), index);
+  }
 }
 
 }  // namespace router
@@ -1,53 +1,140 @@
 #include "route.hpp"
 
-#include <strings.h>
-
-#include <regex>
-#include <sstream>
 #include <stdexcept>
+#include <utility>
 
 namespace router {
 
-Route::Route(
-    const std::string &method, const std::string &path,
-    const std::function<http::Response(const http::Request &)> &handler)
-    : method(method), path(path), handler(handler) {}
+Route::Route(const std::string &method, const std::string &path,
+             Handler handler, bool blocking)
+    : method(method),
+      methodId(http::parseMethod(method)),
+      path(path),
+      handler(std::move(handler)),
+      blocking(blocking) {
+  if (methodId == http::Method::Count) {
+    throw std::runtime_error("Unsupported HTTP method: " + method);
+  }
+  compile(path);
+}
 
 bool Route::matches(const http::Request &request) const {
-  if (strcasecmp(request.getMethod().c_str(), method.c_str()) != 0) {
+  return request.getMethodId() == methodId &&
+         matchPath(request.getPathView());
+}
+
+bool Route::matchPath(std::string_view path,
+                      std::vector<std::string_view> *captures) const {
+  if (captures) {
+    captures->clear();
+  }
+  if (path.empty() || path.front() != '/') {
     return false;
   }
 
-  std::regex pathRegex(pathToRegex(path));
-  return std::regex_match(request.getUri(), pathRegex);
+  // Match trailing slash optionally
+  if (path.size() > 1 && path.back() == '/') {
+    path.remove_suffix(1);
+  }
+  path.remove_prefix(1);
+
+  std::size_t position = 0;
+  for (const auto &segment : segments) {
+    if (position > path.size()) {
+      return false;
+    }
+    std::size_t end = path.find('/', position);
+    if (end == std::string_view::npos) {
+      end = path.size();
+    }
+    std::string_view part = path.substr(position, end - position);
+    if (segment.wildcard) {
+      // Swallow the rest of the path, which must not be empty
+      std::string_view rest =
+          position < path.size() ? path.substr(position) : std::string_view();
+      if (rest.empty()) {
+        return false;
+      }
+      if (captures) {
+        captures->push_back(rest);
+      }
+      return true;
+    }
+    if (segment.parameter) {
+      if (part.empty()) {
+        return false;
+      }
+      if (captures) {
+        captures->push_back(part);
+      }
+    } else if (part != segment.value) {
+      return false;
+    }
+    position = end + 1;
+  }
+
+  // Every path segment must have been consumed by the pattern
+  return segments.empty() ? path.empty() : position == path.size() + 1;
 }
 
 http::Response Route::handle(const http::Request &request) const {
+  if (request.getMethodId() != methodId) {
+    return http::Response(
+        405, "Method Not Allowed", "Method Not Allowed",
+        http::Headers({{"Content-Type", "text/plain"},
+                       {"Allow", http::methodName(methodId)}},
+                      request.getResource()));
+  }
   return handler(request);
 }
 
-std::string Route::getMethod() const { return method; }
+const std::string &Route::getMethod() const { return method; }
 
-std::string Route::getPath() const { return path; }
+http::Method Route::getMethodId() const { return methodId; }
 
-std::function<http::Response(const http::Request &)> Route::getHandler() const {
-  return handler;
+const std::string &Route::getPath() const { return path; }
+
+const std::vector<std::string> &Route::getParameterNames() const {
+  return parameterNames;
 }
 
-std::string Route::pathToRegex(const std::string &path) const {
-  std::stringstream ss;
-  ss << "^";
-  for (char c : path) {
-    if (c == ':') {
-      ss << "([^/]+)";
-    } else if (c == '/') {
-      ss << "\\/";
+bool Route::isBlocking() const { return blocking; }
+
+const Handler &Route::getHandler() const { return handler; }
+
+void Route::compile(const std::string &path) {
+  std::string_view pattern(path);
+  if (!pattern.empty() && pattern.front() == '/') {
+    pattern.remove_prefix(1);
+  }
+  if (!pattern.empty() && pattern.back() == '/') {
+    pattern.remove_suffix(1);
+  }
+  if (pattern.empty()) {
+    return;
+  }
+
+  std::size_t position = 0;
+  while (position <= pattern.size()) {
+    std::size_t end = pattern.find('/', position);
+    if (end == std::string_view::npos) {
+      end = pattern.size();
+    }
+    std::string_view part = pattern.substr(position, end - position);
+    if (part.size() > 1 && part.front() == '*') {
+      if (end != pattern.size()) {
+        throw std::runtime_error("Wildcard must be the last segment: " + path);
+      }
+      segments.push_back({false, true, std::string(part.substr(1))});
+      parameterNames.emplace_back(part.substr(1));
+    } else if (part.size() > 1 && part.front() == ':') {
+      segments.push_back({true, false, std::string(part.substr(1))});
+      parameterNames.emplace_back(part.substr(1));
     } else {
-      ss << c;
+      segments.push_back({false, false, std::string(part)});
     }
+    position = end + 1;
   }
-  ss << "/?$";  // Match trailing slash optionally
-  return ss.str();
 }
 
 }  // namespace router
@@ -1,22 +1,64 @@
 #include "router.hpp"
 
+#include <utility>
+
 namespace router {
 
-void Router::addRoute(
-    const std::string &method, const std::string &path,
-    const std::function<http::Response(const http::Request &)> &handler) {
-  routes.emplace_back(method, path, handler);
+void Router::addRoute(const std::string &method, const std::string &path,
+                      Handler handler, bool blocking) {
+  routes.emplace_back(method, path, std::move(handler), blocking);
+  tree.insert(routes.back().getMethodId(), path, routes.size() - 1);
+}
+
+const Route *Router::resolve(const http::Request &request) const {
+  // Reused per thread; the values are copied into the request as offsets
+  thread_local std::vector<std::string_view> captures;
+  std::size_t index = tree.find(request.getMethodId(),
+                                request.getPathView(), &captures);
+  if (index == Tree::npos) {
+    return nullptr;
+  }
+  const Route &route = routes[index];
+  request.setParameters(route.getParameterNames(), captures);
+  return &route;
+}
+
+http::Response Router::notFound(std::pmr::memory_resource *resource) {
+  return http::Response(
+      404, "Not Found", "The requested URL was not found on this server.",
+      http::Headers({{"Content-Type", "text/plain"}}, resource));
+}
+
+http::Response Router::methodNotAllowed(http::MethodSet allowed,
+                                        std::pmr::memory_resource *resource) {
+  return http::Response(
+      405, "Method Not Allowed", "Method Not Allowed",
+      http::Headers({{"Content-Type", "text/plain"},
+                     {"Allow", http::formatMethods(allowed)}},
+                    resource));
+}
+
+http::Response Router::unmatched(http::MethodSet allowed,
+                                 std::pmr::memory_resource *resource) {
+  if (allowed) {
+    return methodNotAllowed(allowed, resource);
+  }
+  return notFound(resource);
+}
+
+http::Response Router::fallback(const http::Request &request) const {
+  // Only requests that missed pay for the second walk
+  http::MethodSet allowed = 0;
+  tree.find(request.getMethodId(), request.getPathView(), nullptr, &allowed);
+  return unmatched(allowed, request.getResource());
 }
 
 http::Response Router::handle(const http::Request &request) const {
-  for (const auto &route : routes) {
-    if (route.matches(request)) {
-      return route.handle(request);
-    }
+  const Route *route = resolve(request);
+  if (route) {
+    return route->handle(request);
   }
-  return http::Response(404, "Not Found",
-                        "The requested URL was not found on this server.",
-                        {{"Content-Type", "text/plain"}});
+  return fallback(request);
 }
 
 }  // namespace router
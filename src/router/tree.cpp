@@ -0,0 +1,258 @@
+#include "tree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace router {
+
+namespace {
+
+/**
+ * Returns the first segment of a '/'-joined label.
+ */
+std::string_view firstSegment(std::string_view label) {
+  return label.substr(0, label.find('/'));
+}
+
+/**
+ * Returns true if the pattern segment is a `:param` capture.
+ */
+bool isParameter(std::string_view segment) {
+  return segment.size() > 1 && segment.front() == ':';
+}
+
+/**
+ * Returns true if the pattern segment is a trailing `*name` capture.
+ */
+bool isWildcard(std::string_view segment) {
+  return segment.size() > 1 && segment.front() == '*';
+}
+
+}  // namespace
+
+void Tree::insert(const std::string &method, const std::string &path,
+                  std::size_t index) {
+  http::Method id = http::parseMethod(method);
+  if (id == http::Method::Count) {
+    throw std::runtime_error("Unsupported HTTP method: " + method);
+  }
+  insert(id, path, index);
+}
+
+void Tree::insert(http::Method method, const std::string &path,
+                  std::size_t index) {
+  if (method == http::Method::Count) {
+    throw std::runtime_error("Unsupported HTTP method");
+  }
+  std::string_view pattern(path);
+  if (!pattern.empty() && pattern.front() == '/') {
+    pattern.remove_prefix(1);
+  }
+  if (!pattern.empty() && pattern.back() == '/') {
+    pattern.remove_suffix(1);
+  }
+
+  std::vector<std::string_view> segments;
+  std::size_t position = 0;
+  while (!pattern.empty() && position <= pattern.size()) {
+    std::size_t end = pattern.find('/', position);
+    if (end == std::string_view::npos) {
+      end = pattern.size();
+    }
+    segments.push_back(pattern.substr(position, end - position));
+    position = end + 1;
+  }
+
+  insert(root, segments, 0, method, index);
+}
+
+std::size_t Tree::find(std::string_view method, std::string_view path,
+                       std::vector<std::string_view> *captures) const {
+  return find(http::parseMethod(method), path, captures);
+}
+
+std::size_t Tree::find(http::Method method, std::string_view path,
+                       std::vector<std::string_view> *captures,
+                       http::MethodSet *allowed) const {
+  if (captures) {
+    captures->clear();
+  }
+  if (path.empty() || path.front() != '/') {
+    return npos;
+  }
+
+  // Match trailing slash optionally
+  if (path.size() > 1 && path.back() == '/') {
+    path.remove_suffix(1);
+  }
+  if (path.size() == 1) {
+    path = std::string_view();
+  }
+
+  return find(root, method, path, captures, allowed);
+}
+
+void Tree::clear() {
+  root.children.clear();
+  root.parameter.reset();
+  root.wildcard.reset();
+  root.methods = 0;
+}
+
+void Tree::insert(Node &node, const std::vector<std::string_view> &segments,
+                  std::size_t position, http::Method method,
+                  std::size_t index) {
+  if (position == segments.size()) {
+    http::MethodSet bit = http::methodBit(method);
+    if (!(node.methods & bit)) {
+      node.methods |= bit;
+      node.routes[static_cast<std::size_t>(method)] = index;
+    }
+    return;
+  }
+
+  std::string_view segment = segments[position];
+  if (isWildcard(segment)) {
+    // Route validates that the wildcard is the last segment
+    if (!node.wildcard) {
+      node.wildcard = std::make_unique<Node>();
+    }
+    insert(*node.wildcard, segments, segments.size(), method, index);
+    return;
+  }
+  if (isParameter(segment)) {
+    if (!node.parameter) {
+      node.parameter = std::make_unique<Node>();
+    }
+    insert(*node.parameter, segments, position + 1, method, index);
+    return;
+  }
+
+  auto it = std::lower_bound(
+      node.children.begin(), node.children.end(), segment,
+      [](const std::unique_ptr<Node> &child, std::string_view key) {
+        return firstSegment(child->label) < key;
+      });
+
+  if (it == node.children.end() || firstSegment((*it)->label) != segment) {
+    // No edge shares this segment: add one absorbing every static segment up
+    // to the next parameter or wildcard.
+    auto child = std::make_unique<Node>();
+    std::size_t end = position;
+    while (end < segments.size() && !isParameter(segments[end]) &&
+           !isWildcard(segments[end])) {
+      if (end > position) {
+        child->label += '/';
+      }
+      child->label += segments[end];
+      ++end;
+    }
+    Node &inserted = **node.children.insert(it, std::move(child));
+    insert(inserted, segments, end, method, index);
+    return;
+  }
+
+  // Count the segments shared with the existing edge label
+  Node &child = **it;
+  std::string_view label(child.label);
+  std::size_t common = 0;
+  std::size_t consumed = position;
+  std::size_t offset = 0;
+  while (offset <= label.size() && consumed < segments.size()) {
+    std::size_t end = label.find('/', offset);
+    if (end == std::string_view::npos) {
+      end = label.size();
+    }
+    if (label.substr(offset, end - offset) != segments[consumed]) {
+      break;
+    }
+    common = end;
+    offset = end + 1;
+    ++consumed;
+  }
+
+  if (common < label.size()) {
+    // Split the edge where the new pattern diverges from it
+    auto tail = std::make_unique<Node>();
+    tail->label = child.label.substr(common + 1);
+    tail->children = std::move(child.children);
+    tail->parameter = std::move(child.parameter);
+    tail->wildcard = std::move(child.wildcard);
+    tail->methods = child.methods;
+    tail->routes = child.routes;
+    child.label.resize(common);
+    child.children.clear();
+    child.methods = 0;
+    child.children.push_back(std::move(tail));
+  }
+
+  insert(child, segments, consumed, method, index);
+}
+
+std::size_t Tree::find(const Node &node, http::Method method,
+                       std::string_view rest,
+                       std::vector<std::string_view> *captures,
+                       http::MethodSet *allowed) {
+  if (rest.empty()) {
+    if (node.methods & http::methodBit(method)) {
+      return node.routes[static_cast<std::size_t>(method)];
+    }
+    if (allowed) {
+      *allowed |= node.methods;
+    }
+    return npos;
+  }
+
+  // The remaining path always starts with '/'
+  std::string_view tail = rest.substr(1);
+  std::size_t slash = tail.find('/');
+  std::string_view segment = tail.substr(0, slash);
+
+  auto it = std::lower_bound(
+      node.children.begin(), node.children.end(), segment,
+      [](const std::unique_ptr<Node> &child, std::string_view key) {
+        return firstSegment(child->label) < key;
+      });
+  if (it != node.children.end()) {
+    std::string_view label((*it)->label);
+    if (tail.compare(0, label.size(), label) == 0 &&
+        (tail.size() == label.size() || tail[label.size()] == '/')) {
+      std::size_t found =
+          find(**it, method, tail.substr(label.size()), captures, allowed);
+      if (found != npos) {
+        return found;
+      }
+    }
+  }
+
+  if (node.parameter && !segment.empty()) {
+    std::size_t mark = captures ? captures->size() : 0;
+    if (captures) {
+      captures->push_back(segment);
+    }
+    std::size_t found =
+        find(*node.parameter, method,
+             slash == std::string_view::npos ? std::string_view()
+                                             : tail.substr(slash),
+             captures, allowed);
+    if (found != npos) {
+      return found;
+    }
+    if (captures) {
+      captures->resize(mark);
+    }
+  }
+
+  if (node.wildcard && !tail.empty()) {
+    std::size_t found = find(*node.wildcard, method, std::string_view(),
+                             nullptr, allowed);
+    if (found != npos && captures) {
+      captures->push_back(tail);
+    }
+    return found;
+  }
+
+  return npos;
+}
+
+}  // namespace router
@@ -0,0 +1,185 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "app.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "server.hpp"
+
+// Built as its own executable, runAllocationTests, since replacing the
+// global allocation functions affects every test linked with them
+
+using namespace core;
+using namespace http;
+
+namespace {
+
+/**
+ * Heap allocations made by any thread of the test program.
+ */
+std::atomic<std::size_t> allocations{0};
+
+void *allocate(std::size_t size, std::size_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void *pointer = nullptr;
+  if (posix_memalign(&pointer, alignment, size ? size : 1) != 0) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate(size, std::max(static_cast<std::size_t>(alignment),
+                                 sizeof(void *)));
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+class SteadyLoadTest : public ::testing::Test {
+ protected:
+  App app;
+  std::unique_ptr<Server> server;
+  std::thread thread;
+
+  void SetUp() override {
+    // A form post, answered from its query and body without copying either
+    app.registerRoute(
+        "POST", "/users/:id/settings", [](const Request &request) {
+          Headers headers({{"Content-Type", "text/plain"}},
+                          request.getResource());
+          if (request.getQuery().get("tab") != "appearance") {
+            return Response(400, "Bad Request", "", std::move(headers));
+          }
+          return Response(200, "OK",
+                          std::string(request.getInput().get("theme")),
+                          std::move(headers));
+        });
+
+    server = std::make_unique<Server>(app);
+    server->listen("127.0.0.1", 0);
+    thread = std::thread([this] { server->run(); });
+  }
+
+  void TearDown() override {
+    server->stop();
+    thread.join();
+  }
+
+  int connectClient() {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(server->getPort()));
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(
+        connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)),
+        0);
+    return fd;
+  }
+};
+
+TEST_F(SteadyLoadTest, ServesRequestsWithoutAllocating) {
+  // The URI and body are well past the small string limit, so any copy of
+  // them outside the arena would show up as an allocation
+  static constexpr char kRequest[] =
+      "POST /users/7/settings?return=%2Fusers%2F7%2Fprofile&tab=appearance"
+      "&ref=nav HTTP/1.1\r\nHost: localhost\r\n"
+      "Content-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 56\r\n\r\n"
+      "theme=dark&language=en-GB&timezone=UTC&newsletter=weekly";
+  static constexpr char kLastRequest[] =
+      "POST /users/7/settings?return=%2Fusers%2F7%2Fprofile&tab=appearance"
+      "&ref=nav HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n"
+      "Content-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 56\r\n\r\n"
+      "theme=dark&language=en-GB&timezone=UTC&newsletter=weekly";
+
+  // Every response but the last is the same, so one measures them all
+  int fd = connectClient();
+  ASSERT_EQ(send(fd, kRequest, sizeof(kRequest) - 1, 0),
+            static_cast<ssize_t>(sizeof(kRequest) - 1));
+  std::string response;
+  char buffer[4096];
+  while (response.size() < 4 ||
+         response.compare(response.size() - 4, 4, "dark") != 0) {
+    ssize_t result = recv(fd, buffer, sizeof(buffer), 0);
+    ASSERT_GT(result, 0);
+    response.append(buffer, static_cast<std::size_t>(result));
+  }
+  close(fd);
+  ASSERT_EQ(response.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  std::size_t length = response.size();
+
+  // Opens connections one after another and sends several requests on each,
+  // using nothing but syscalls and the stack so the client allocates nothing
+  auto serve = [&](int count, int requests) {
+    int failures = 0;
+    for (int i = 0; i < count; ++i) {
+      int client = connectClient();
+      for (int j = 0; j < requests; ++j) {
+        bool last = j + 1 == requests;
+        const char *request = last ? kLastRequest : kRequest;
+        std::size_t size =
+            last ? sizeof(kLastRequest) - 1 : sizeof(kRequest) - 1;
+        failures += send(client, request, size, 0) !=
+                    static_cast<ssize_t>(size);
+        // The last response ends with the connection, and says so
+        std::size_t expected = last ? sizeof(buffer) : length;
+        std::size_t received = 0;
+        while (received < expected) {
+          std::size_t wanted = std::min(sizeof(buffer), expected - received);
+          ssize_t result = recv(client, buffer, wanted, 0);
+          if (result <= 0) {
+            break;
+          }
+          received += static_cast<std::size_t>(result);
+        }
+        failures += last ? received == 0 : received != length;
+      }
+      close(client);
+    }
+    return failures;
+  };
+
+  // Warm up the connection pool, arena chunks and buffers
+  ASSERT_EQ(serve(20, 10), 0);
+
+  std::size_t before = allocations.load();
+  int failures = serve(200, 10);
+  std::size_t after = allocations.load();
+  EXPECT_EQ(failures, 0);
+  EXPECT_EQ(after - before, 0);
+}
@@ -2,9 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <string>
+
 #include "request.hpp"
 #include "response.hpp"
 #include "router.hpp"
+#include "temporary_directory.hpp"
 
 using namespace http;
 using namespace router;
@@ -14,7 +18,7 @@ class AppTest : public ::testing::Test {
  protected:
   core::App app;
 
-  static Response sampleHandler(const Request &request) {
+  static Response sampleHandler(const Request &) {
     return Response(200, "OK", "Sample response",
                     {{"Content-Type", "text/plain"}});
   }
@@ -33,7 +37,7 @@ TEST_F(AppTest, RegisterAndRetrieveRoute) {
 }
 
 TEST_F(AppTest, RegisterMultipleRoutes) {
-  app.getRouter().addRoute("POST", "/submit", [](const Request &request) {
+  app.getRouter().addRoute("POST", "/submit", [](const Request &) {
     return Response(200, "OK", "POST response",
                     {{"Content-Type", "text/plain"}});
   });
@@ -61,7 +65,7 @@ TEST_F(AppTest, HandleUnknownRoute) {
 TEST_F(AppTest, RouteHandlerCalledWithCorrectRequest) {
   bool handlerCalled = false;
   app.getRouter().addRoute("GET", "/test",
-                           [&handlerCalled](const Request &request) {
+                           [&handlerCalled](const Request &) {
                              handlerCalled = true;
                              return Response(200, "OK", "Test response",
                                              {{"Content-Type", "text/plain"}});
@@ -74,3 +78,30 @@ TEST_F(AppTest, RouteHandlerCalledWithCorrectRequest) {
   EXPECT_EQ(response.getBody(), "Test response");
   EXPECT_TRUE(handlerCalled);
 }
+
+TEST_F(AppTest, RegisterBlockingRoute) {
+  app.registerBlockingRoute("GET", "/report", sampleHandler);
+
+  Request request("GET", "/report", "HTTP/1.1", "", {});
+  const Route *route = app.getRouter().resolve(request);
+  ASSERT_NE(route, nullptr);
+  EXPECT_TRUE(route->isBlocking());
+  EXPECT_FALSE(app.getRouter()
+                   .resolve(Request("GET", "/sample", "HTTP/1.1", "", {}))
+                   ->isBlocking());
+}
+
+TEST_F(AppTest, RegisterStaticServesDirectory) {
+  TemporaryDirectory directory("ember-app");
+  std::ofstream(directory.getPath() + "/hello.txt") << "hello";
+
+  app.registerStatic("/static/", directory.getPath());
+  Response response = app.getRouter().handle(
+      Request("GET", "/static/hello.txt", "HTTP/1.1", "", {}));
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getContentLength(), 5);
+  EXPECT_EQ(app.getRouter()
+                .handle(Request("GET", "/static/nope.txt", "HTTP/1.1", "", {}))
+                .getStatusCode(),
+            404);
+}
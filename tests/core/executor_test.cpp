@@ -0,0 +1,155 @@
+#include "executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+TEST(ExecutorTest, RunsEverySubmittedTask) {
+  std::atomic<int> count(0);
+  {
+    Executor executor(4);
+    EXPECT_EQ(executor.size(), 4);
+    for (int i = 0; i < 1000; ++i) {
+      executor.submit([&count] { count.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ExecutorTest, ZeroThreadsStillRunsTasks) {
+  std::atomic<int> count(0);
+  {
+    Executor executor(0);
+    EXPECT_EQ(executor.size(), 1);
+    executor.submit([&count] { count.fetch_add(1); });
+  }
+  EXPECT_EQ(count.load(), 1);
+}
+
+TEST(ExecutorTest, TasksCanSubmitTasks) {
+  std::atomic<int> count(0);
+  {
+    Executor executor(2);
+    executor.submit([&executor, &count] {
+      for (int i = 0; i < 100; ++i) {
+        executor.submit([&count] { count.fetch_add(1); });
+      }
+    });
+  }
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST(ExecutorTest, IdleWorkersStealQueuedTasks) {
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release = false;
+  std::mutex idsMutex;
+  std::set<std::thread::id> ids;
+  std::atomic<int> count(0);
+  {
+    Executor executor(2);
+    // Block one worker, then queue work behind it from inside that worker
+    executor.submit([&] {
+      for (int i = 0; i < 50; ++i) {
+        executor.submit([&] {
+          {
+            std::lock_guard<std::mutex> lock(idsMutex);
+            ids.insert(std::this_thread::get_id());
+          }
+          count.fetch_add(1);
+        });
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      released.wait(lock, [&] { return release; });
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (count.load() < 50 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(count.load(), 50);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release = true;
+    }
+    released.notify_all();
+  }
+  EXPECT_EQ(ids.size(), 1);
+}
+
+TEST(ExecutorTest, SaturatedPoolRunsExternalTasksOldestFirst) {
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release[2] = {false, false};
+  std::atomic<int> blocked(0);
+  std::mutex orderMutex;
+  std::vector<int> order;
+  std::set<std::thread::id> ids;
+  {
+    Executor executor(2);
+    // Occupy every worker, then queue requests behind them from outside
+    for (int i = 0; i < 2; ++i) {
+      executor.submit([&, i] {
+        blocked.fetch_add(1);
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return release[i]; });
+      });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (blocked.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(blocked.load(), 2);
+    for (int i = 0; i < 100; ++i) {
+      executor.submit([&, i] {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(i);
+        ids.insert(std::this_thread::get_id());
+      });
+    }
+
+    // Free one worker only, which must also steal what queued on the other
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release[0] = true;
+    }
+    released.notify_all();
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+      {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        if (order.size() == 100) {
+          break;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release[1] = true;
+    }
+    released.notify_all();
+  }
+  EXPECT_EQ(ids.size(), 1);
+  ASSERT_EQ(order.size(), 100);
+
+  // Requests were dealt to the two deques in turn, and each deque was
+  // served in the order its requests were submitted
+  std::vector<int> deques[2];
+  for (int i : order) {
+    deques[i % 2].push_back(i);
+  }
+  for (const std::vector<int> &taken : deques) {
+    EXPECT_EQ(taken.size(), 50);
+    EXPECT_TRUE(std::is_sorted(taken.begin(), taken.end()));
+  }
+}
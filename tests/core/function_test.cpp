@@ -0,0 +1,97 @@
+#include "function.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <utility>
+
+using namespace core;
+
+namespace {
+
+int twice(int value) { return value * 2; }
+
+/**
+ * Counts the live instances of a callable, to check that the wrapper
+ * destroys exactly what it builds.
+ */
+struct Counted {
+  static int live;
+  int offset;
+
+  explicit Counted(int offset) : offset(offset) { ++live; }
+  Counted(const Counted &other) : offset(other.offset) { ++live; }
+  Counted(Counted &&other) noexcept : offset(other.offset) { ++live; }
+  ~Counted() { --live; }
+
+  int operator()(int value) const { return value + offset; }
+};
+
+int Counted::live = 0;
+
+}  // namespace
+
+TEST(FunctionTest, CallsFunctionsAndLambdas) {
+  Function<int(int)> function = twice;
+  EXPECT_EQ(function(4), 8);
+
+  int offset = 3;
+  Function<int(int)> lambda = [&offset](int value) { return value + offset; };
+  EXPECT_EQ(lambda(4), 7);
+}
+
+TEST(FunctionTest, EmptyWrapperThrows) {
+  Function<int(int)> empty;
+  EXPECT_FALSE(empty);
+  EXPECT_THROW(empty(1), std::bad_function_call);
+
+  int (*null)(int) = nullptr;
+  Function<int(int)> fromNull = null;
+  EXPECT_FALSE(fromNull);
+}
+
+TEST(FunctionTest, HoldsMoveOnlyCallables) {
+  auto value = std::make_unique<int>(5);
+  Function<int()> function = [value = std::move(value)] { return *value; };
+  EXPECT_EQ(function(), 5);
+}
+
+TEST(FunctionTest, StoresSmallCallablesInline) {
+  auto small = [p = static_cast<void *>(nullptr)] { return p; };
+  auto large = [a = std::array<char, 256>()] { return a[0]; };
+  EXPECT_TRUE(Function<void *()>::storesInline<decltype(small)>());
+  EXPECT_FALSE(Function<char()>::storesInline<decltype(large)>());
+
+  Function<char()> function = large;
+  EXPECT_EQ(function(), 0);
+}
+
+TEST(FunctionTest, MoveLeavesTheSourceEmpty) {
+  Function<int(int)> source = Counted(1);
+  Function<int(int)> target = std::move(source);
+  EXPECT_FALSE(source);
+  EXPECT_EQ(target(1), 2);
+
+  Function<int(int)> assigned;
+  assigned = std::move(target);
+  EXPECT_FALSE(target);
+  EXPECT_EQ(assigned(1), 2);
+}
+
+TEST(FunctionTest, DestroysInlineAndHeapCallables) {
+  Counted::live = 0;
+  {
+    Function<int(int)> small = Counted(1);
+    Function<int(int), 1> large = Counted(2);
+    EXPECT_EQ(Counted::live, 2);
+    EXPECT_EQ(large(1), 3);
+
+    Function<int(int), 1> moved = std::move(large);
+    EXPECT_EQ(Counted::live, 2);
+    small = nullptr;
+    EXPECT_EQ(Counted::live, 1);
+  }
+  EXPECT_EQ(Counted::live, 0);
+}
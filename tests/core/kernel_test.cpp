@@ -1,7 +1,10 @@
 #include "kernel.hpp"
 
+#include <string>
+
 #include "app.hpp"
 #include "gtest/gtest.h"
+#include "middleware.hpp"
 #include "request.hpp"
 #include "response.hpp"
 
@@ -15,11 +18,11 @@ class KernelTest : public ::testing::Test {
 
   void SetUp() override {
     // Initialize the App with some routes
-    app.registerRoute("GET", "/home", [](const Request &request) {
+    app.registerRoute("GET", "/home", [](const Request &) {
       return Response(200, "OK", "Home Page", {{"Content-Type", "text/plain"}});
     });
 
-    app.registerRoute("POST", "/submit", [](const Request &request) {
+    app.registerRoute("POST", "/submit", [](const Request &) {
       return Response(201, "Created", "Form Submitted",
                       {{"Content-Type", "text/plain"}});
     });
@@ -55,6 +58,14 @@ TEST_F(KernelTest, HandleUnregisteredRoute) {
   EXPECT_EQ(response.getHeader("Content-Type"), "text/plain");
 }
 
+TEST_F(KernelTest, HandleWrongMethod) {
+  Request request("GET", "/submit", "HTTP/1.1", "", {});
+  Response response = kernel->handleRequest(request);
+
+  EXPECT_EQ(response.getStatusCode(), 405);
+  EXPECT_EQ(response.getHeader("Allow"), "POST");
+}
+
 TEST_F(KernelTest, HandleMultipleRoutes) {
   Request getRequest("GET", "/home", "HTTP/1.1", "", {});
   Response getResponse = kernel->handleRequest(getRequest);
@@ -87,3 +98,69 @@ TEST_F(KernelTest, RouteHandlerCalledWithCorrectRequest) {
   EXPECT_EQ(response.getStatusMessage(), "OK");
   EXPECT_EQ(response.getBody(), "Test");
 }
+
+TEST_F(KernelTest, ResolveAndDispatch) {
+  Request request("GET", "/home", "HTTP/1.1", "", {});
+  const router::Route *route = kernel->resolve(request);
+  ASSERT_NE(route, nullptr);
+  EXPECT_EQ(route->getPath(), "/home");
+  EXPECT_EQ(kernel->dispatch(route, request).getBody(), "Home Page");
+
+  Request unknown("GET", "/unknown", "HTTP/1.1", "", {});
+  EXPECT_EQ(kernel->resolve(unknown), nullptr);
+  EXPECT_EQ(kernel->dispatch(nullptr, unknown).getStatusCode(), 404);
+}
+
+TEST_F(KernelTest, GlobalMiddlewareWrapsRoutesAndFallbacks) {
+  app.use([](const Request &request, Next next) {
+    Response response = next(request);
+    response.setHeader("X-Seen", "yes");
+    return response;
+  });
+
+  Request home("GET", "/home", "HTTP/1.1", "", {});
+  Response routed = kernel->handleRequest(home);
+  EXPECT_EQ(routed.getBody(), "Home Page");
+  EXPECT_EQ(routed.getHeader("X-Seen"), "yes");
+
+  Request unknown("GET", "/unknown", "HTTP/1.1", "", {});
+  Response missing = kernel->handleRequest(unknown);
+  EXPECT_EQ(missing.getStatusCode(), 404);
+  EXPECT_EQ(missing.getHeader("X-Seen"), "yes");
+}
+
+TEST_F(KernelTest, RouteMiddlewareRunsInsideGlobalMiddleware) {
+  std::string order;
+  app.use([&order](const Request &request, Next next) {
+    order += "global ";
+    return next(request);
+  });
+  app.registerRoute(
+      "GET", "/admin",
+      layers([&order](const Request &request, Next next) {
+        order += "route ";
+        if (request.getHeader("Authorization").empty()) {
+          return Response(401, "Unauthorized", "", {});
+        }
+        return next(request);
+      }),
+      [&order](const Request &) {
+        order += "handler";
+        return Response(200, "OK", "Admin", {});
+      });
+
+  Request anonymous("GET", "/admin", "HTTP/1.1", "", {});
+  EXPECT_EQ(kernel->handleRequest(anonymous).getStatusCode(), 401);
+  EXPECT_EQ(order, "global route ");
+
+  order.clear();
+  Request signedIn("GET", "/admin", "HTTP/1.1", "", {{"Authorization", "t"}});
+  EXPECT_EQ(kernel->handleRequest(signedIn).getBody(), "Admin");
+  EXPECT_EQ(order, "global route handler");
+
+  // Routes without middleware of their own only see the global layer
+  order.clear();
+  Request home("GET", "/home", "HTTP/1.1", "", {});
+  EXPECT_EQ(kernel->handleRequest(home).getBody(), "Home Page");
+  EXPECT_EQ(order, "global ");
+}
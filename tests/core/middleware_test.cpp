@@ -0,0 +1,141 @@
+#include "middleware.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "request.hpp"
+#include "response.hpp"
+
+using namespace core;
+using namespace http;
+
+namespace {
+
+Response ok(const Request &) {
+  return Response(200, "OK", "handled", {{"Content-Type", "text/plain"}});
+}
+
+/**
+ * A middleware recording its name before and after the rest of the chain.
+ */
+Middleware trace(std::vector<std::string> &log, const std::string &name) {
+  return [&log, name](const Request &request, Next next) {
+    log.push_back(name + ">");
+    Response response = next(request);
+    log.push_back("<" + name);
+    return response;
+  };
+}
+
+}  // namespace
+
+TEST(PipelineTest, RunsLayersOutermostFirst) {
+  std::vector<std::string> log;
+  Pipeline pipeline(layers(trace(log, "a"), trace(log, "b")), ok);
+  EXPECT_EQ(pipeline.size(), 2);
+
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(pipeline(request).getBody(), "handled");
+  EXPECT_EQ(log, (std::vector<std::string>{"a>", "b>", "<b", "<a"}));
+}
+
+TEST(PipelineTest, EmptyPipelineCallsTheHandler) {
+  Pipeline pipeline({}, ok);
+  EXPECT_TRUE(pipeline.empty());
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(pipeline(request).getStatusCode(), 200);
+}
+
+TEST(PipelineTest, MiddlewareCanAnswerWithoutCallingNext) {
+  bool reached = false;
+  Pipeline pipeline(
+      layers([](const Request &request, Next next) {
+        if (request.getHeader("Authorization").empty()) {
+          return Response(401, "Unauthorized", "", {});
+        }
+        return next(request);
+      }),
+      [&reached](const Request &request) {
+        reached = true;
+        return ok(request);
+      });
+
+  Request anonymous("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(pipeline(anonymous).getStatusCode(), 401);
+  EXPECT_FALSE(reached);
+
+  Request signedIn("GET", "/", "HTTP/1.1", "", {{"Authorization", "token"}});
+  EXPECT_EQ(pipeline(signedIn).getStatusCode(), 200);
+  EXPECT_TRUE(reached);
+}
+
+TEST(PipelineTest, MiddlewareCanRewriteTheResponse) {
+  Pipeline pipeline({}, ok);
+  pipeline.use([](const Request &request, Next next) {
+    Response response = next(request);
+    response.setHeader("X-Layer", "outer");
+    return response;
+  });
+
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  Response response = pipeline(request);
+  EXPECT_EQ(response.getBody(), "handled");
+  EXPECT_EQ(response.getHeader("X-Layer"), "outer");
+}
+
+TEST(ChainTest, ComposesGenericAndTypeErasedMiddleware) {
+  std::vector<std::string> log;
+  auto generic = [&log](const Request &request, const auto &next) {
+    log.push_back("generic");
+    return next(request);
+  };
+  auto handler = chain(generic, trace(log, "erased"), ok);
+
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(handler(request).getBody(), "handled");
+  EXPECT_EQ(log, (std::vector<std::string>{"generic", "erased>", "<erased"}));
+}
+
+TEST(ChainTest, ChainOfOneIsTheHandler) {
+  auto handler = chain(ok);
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(handler(request).getStatusCode(), 200);
+}
+
+TEST(PipelineTest, OuterMiddlewareRunsInFrontOfItsOwn) {
+  std::vector<std::string> log;
+  Middleware shared = trace(log, "global");
+  Pipeline pipeline(layers(trace(log, "route")), ok);
+  pipeline.wrap({&shared});
+  EXPECT_EQ(pipeline.size(), 2);
+
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(pipeline(request).getBody(), "handled");
+  EXPECT_EQ(log, (std::vector<std::string>{"global>", "route>", "<route",
+                                           "<global"}));
+
+  // Wrapping again replaces the outer layers rather than adding to them
+  log.clear();
+  pipeline.wrap({});
+  EXPECT_EQ(pipeline.size(), 1);
+  pipeline(request);
+  EXPECT_EQ(log, (std::vector<std::string>{"route>", "<route"}));
+}
+
+TEST(PipelineTest, MovedPipelineStillReachesItsHandler) {
+  std::vector<std::string> log;
+  Pipeline original(layers(trace(log, "a"), trace(log, "b")), ok);
+  Pipeline moved(std::move(original));
+
+  Request request("GET", "/", "HTTP/1.1", "", {});
+  EXPECT_EQ(moved(request).getBody(), "handled");
+  EXPECT_EQ(log, (std::vector<std::string>{"a>", "b>", "<b", "<a"}));
+
+  Pipeline assigned({}, ok);
+  assigned = std::move(moved);
+  log.clear();
+  EXPECT_EQ(assigned(request).getBody(), "handled");
+  EXPECT_EQ(log.size(), 4);
+}
@@ -0,0 +1,586 @@
+#include "server.hpp"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include "temporary_directory.hpp"
+
+using namespace core;
+using namespace http;
+
+class ServerTest : public ::testing::Test {
+ protected:
+  App app;
+  ServerOptions options;
+  std::unique_ptr<Server> server;
+  std::thread thread;
+  TemporaryDirectory assets{"ember-assets"};
+
+  void SetUp() override {
+    app.registerRoute("GET", "/home", [](const Request &) {
+      return Response(200, "OK", "Home Page", {{"Content-Type", "text/plain"}});
+    });
+
+    app.registerRoute("POST", "/echo", [](const Request &request) {
+      return Response(200, "OK", request.getBody(),
+                      {{"Content-Type", "text/plain"}});
+    });
+
+    app.registerBlockingRoute("GET", "/slow", [](const Request &) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      return Response(200, "OK", "Slow Page", {{"Content-Type", "text/plain"}});
+    });
+
+    app.registerRoute("GET", "/users/:id", [](const Request &request) {
+      return Response(
+          200, "OK", std::string(request.getParameter("id")),
+          Headers({{"Content-Type", "text/plain"}}, request.getResource()));
+    });
+
+    app.registerRoute("GET", "/large", [](const Request &) {
+      return Response(200, "OK", largeBody(),
+                      {{"Content-Type", "application/octet-stream"}});
+    });
+
+    std::ofstream(assets.getPath() + "/app.js", std::ios::binary)
+        << largeBody();
+    app.registerStatic("/assets", assets.getPath());
+
+    start();
+  }
+
+  static std::string largeBody() {
+    std::string body(4 * 1024 * 1024, '\0');
+    for (std::size_t i = 0; i < body.size(); ++i) {
+      body[i] = static_cast<char>('a' + i % 26);
+    }
+    return body;
+  }
+
+  void TearDown() override {
+    stop();
+  }
+
+  void start() {
+    server = std::make_unique<Server>(app, options);
+    server->listen("127.0.0.1", 0);
+    thread = std::thread([this] { server->run(); });
+  }
+
+  void stop() {
+    if (thread.joinable()) {
+      server->stop();
+      thread.join();
+    }
+  }
+
+  int connectClient() {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(server->getPort()));
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(
+        connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)),
+        0);
+    return fd;
+  }
+
+  static void sendAll(int fd, const std::string &data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t result = send(fd, data.data() + sent, data.size() - sent, 0);
+      ASSERT_GT(result, 0);
+      sent += static_cast<std::size_t>(result);
+    }
+  }
+
+  static std::string readAll(int fd) {
+    std::string data;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+      data.append(buffer, static_cast<std::size_t>(received));
+    }
+    return data;
+  }
+
+  /**
+   * Reads one response, framed by its Content-Length, leaving anything after
+   * it in pending.
+   */
+  static std::string readResponse(int fd, std::string &pending) {
+    char buffer[4096];
+    std::size_t end;
+    while ((end = pending.find("\r\n\r\n")) == std::string::npos) {
+      ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+      if (received <= 0) {
+        return "";
+      }
+      pending.append(buffer, static_cast<std::size_t>(received));
+    }
+    end += 4;
+    std::size_t length = 0;
+    std::size_t field = pending.find("Content-Length: ");
+    if (field != std::string::npos && field < end) {
+      length = std::stoul(pending.substr(field + 16));
+    }
+    while (pending.size() < end + length) {
+      ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+      if (received <= 0) {
+        return "";
+      }
+      pending.append(buffer, static_cast<std::size_t>(received));
+    }
+    std::string response = pending.substr(0, end + length);
+    pending.erase(0, end + length);
+    return response;
+  }
+
+  /**
+   * Sends a request, signals that no more will follow, and reads until the
+   * server closes the connection.
+   */
+  std::string roundTrip(const std::string &rawRequest) {
+    int fd = connectClient();
+    sendAll(fd, rawRequest);
+    shutdown(fd, SHUT_WR);
+    std::string response = readAll(fd);
+    close(fd);
+    return response;
+  }
+};
+
+TEST_F(ServerTest, ServesRegisteredRoute) {
+  std::string raw = roundTrip("GET /home HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+  Response response;
+  response.parseResponse(raw);
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getHeader("Content-Length"), "9");
+  EXPECT_NE(raw.find("\r\n\r\nHome Page"), std::string::npos);
+}
+
+TEST_F(ServerTest, ServesNotFound) {
+  std::string raw = roundTrip("GET /missing HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(raw.compare(0, 22, "HTTP/1.1 404 Not Found"), 0);
+}
+
+TEST_F(ServerTest, PassesRouteParameters) {
+  std::string raw = roundTrip("GET /users/42 HTTP/1.1\r\n\r\n");
+  EXPECT_NE(raw.find("\r\n\r\n42"), std::string::npos);
+}
+
+TEST_F(ServerTest, ReadsBodyByContentLength) {
+  std::string raw = roundTrip(
+      "POST /echo HTTP/1.1\r\nContent-Length: 11\r\n\r\nhello\nworld");
+  EXPECT_NE(raw.find("\r\n\r\nhello\nworld"), std::string::npos);
+}
+
+TEST_F(ServerTest, WritesLargeBodyIntact) {
+  std::string raw = roundTrip("GET /large HTTP/1.1\r\n\r\n");
+
+  std::size_t headEnd = raw.find("\r\n\r\n");
+  ASSERT_NE(headEnd, std::string::npos);
+  EXPECT_NE(raw.find("Content-Length: 4194304\r\n"), std::string::npos);
+  EXPECT_TRUE(raw.compare(headEnd + 4, std::string::npos, largeBody()) == 0);
+}
+
+TEST_F(ServerTest, ServesStaticFileWithSendfile) {
+  std::string raw = roundTrip("GET /assets/app.js HTTP/1.1\r\n\r\n");
+
+  std::size_t headEnd = raw.find("\r\n\r\n");
+  ASSERT_NE(headEnd, std::string::npos);
+  std::string head = raw.substr(0, headEnd);
+  EXPECT_NE(head.find("HTTP/1.1 200 OK"), std::string::npos);
+  EXPECT_NE(head.find("Content-Length: 4194304"), std::string::npos);
+  EXPECT_NE(head.find("Content-Type: text/javascript"), std::string::npos);
+  EXPECT_TRUE(raw.compare(headEnd + 4, std::string::npos, largeBody()) == 0);
+}
+
+TEST_F(ServerTest, AnswersHeadForStaticFileWithoutBody) {
+  std::string raw = roundTrip("HEAD /assets/app.js HTTP/1.1\r\n\r\n");
+
+  EXPECT_EQ(raw.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  EXPECT_NE(raw.find("Content-Length: 4194304\r\n"), std::string::npos);
+  EXPECT_EQ(raw.substr(raw.size() - 4), "\r\n\r\n");
+}
+
+TEST_F(ServerTest, ServesStaticFileRangesAndValidators) {
+  std::string raw = roundTrip(
+      "GET /assets/app.js HTTP/1.1\r\nRange: bytes=26-30\r\n\r\n");
+  EXPECT_EQ(raw.compare(0, 28, "HTTP/1.1 206 Partial Content"), 0);
+  EXPECT_NE(raw.find("Content-Range: bytes 26-30/4194304"), std::string::npos);
+  EXPECT_NE(raw.find("Content-Length: 5\r\n"), std::string::npos);
+  EXPECT_EQ(raw.substr(raw.size() - 5), "abcde");
+
+  Response response;
+  response.parseResponse(raw);
+  std::string etag = response.getHeader("ETag");
+  raw = roundTrip("GET /assets/app.js HTTP/1.1\r\nIf-None-Match: " + etag +
+                  "\r\n\r\n");
+  EXPECT_EQ(raw.compare(0, 25, "HTTP/1.1 304 Not Modified"), 0);
+  EXPECT_EQ(raw.find("Content-Length"), std::string::npos);
+  EXPECT_EQ(raw.substr(raw.size() - 4), "\r\n\r\n");
+
+  raw = roundTrip("GET /assets/missing.js HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(raw.compare(0, 22, "HTTP/1.1 404 Not Found"), 0);
+}
+
+TEST_F(ServerTest, ReadsChunkedBody) {
+  std::string raw = roundTrip(
+      "POST /echo HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+      "5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n");
+  EXPECT_NE(raw.find("\r\n\r\nhello world"), std::string::npos);
+}
+
+TEST_F(ServerTest, ParsesRequestArrivingInPieces) {
+  int fd = connectClient();
+  std::string request =
+      "POST /echo HTTP/1.1\r\nContent-Length: 5\r\n\r\nabcde";
+  for (char c : request) {
+    sendAll(fd, std::string(1, c));
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  shutdown(fd, SHUT_WR);
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_EQ(raw.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  EXPECT_NE(raw.find("\r\n\r\nabcde"), std::string::npos);
+}
+
+TEST_F(ServerTest, RejectsMalformedRequest) {
+  std::string raw = roundTrip("NONSENSE\r\n\r\n");
+  EXPECT_EQ(raw.compare(0, 24, "HTTP/1.1 400 Bad Request"), 0);
+}
+
+TEST_F(ServerTest, ServesManyConcurrentConnections) {
+  constexpr int kClients = 256;
+  std::vector<int> clients;
+  for (int i = 0; i < kClients; ++i) {
+    clients.push_back(connectClient());
+  }
+  for (int fd : clients) {
+    sendAll(fd, "GET /home HTTP/1.1\r\n\r\n");
+    shutdown(fd, SHUT_WR);
+  }
+  for (int fd : clients) {
+    std::string raw = readAll(fd);
+    close(fd);
+    EXPECT_NE(raw.find("\r\n\r\nHome Page"), std::string::npos);
+  }
+}
+
+TEST_F(ServerTest, ServesFromSeveralReactors) {
+  stop();
+  options.threads = 4;
+  start();
+
+  std::vector<int> clients;
+  for (int i = 0; i < 64; ++i) {
+    clients.push_back(connectClient());
+  }
+  for (int fd : clients) {
+    sendAll(fd, "GET /users/7 HTTP/1.1\r\n\r\n");
+    shutdown(fd, SHUT_WR);
+  }
+  for (int fd : clients) {
+    std::string raw = readAll(fd);
+    close(fd);
+    EXPECT_NE(raw.find("\r\n\r\n7"), std::string::npos);
+  }
+}
+
+TEST_F(ServerTest, BlockingRoutesDoNotStallTheReactor) {
+  int slow = connectClient();
+  sendAll(slow, "GET /slow HTTP/1.1\r\n\r\n");
+  shutdown(slow, SHUT_WR);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  auto started = std::chrono::steady_clock::now();
+  std::string fast = roundTrip("GET /home HTTP/1.1\r\n\r\n");
+  EXPECT_LT(std::chrono::steady_clock::now() - started,
+            std::chrono::milliseconds(150));
+  EXPECT_NE(fast.find("\r\n\r\nHome Page"), std::string::npos);
+
+  std::string raw = readAll(slow);
+  close(slow);
+  EXPECT_NE(raw.find("\r\n\r\nSlow Page"), std::string::npos);
+}
+
+TEST_F(ServerTest, IdleWorkerStealsFromOneStuckInAHandler) {
+  stop();
+  options.threads = 2;
+  options.workerThreads = 2;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<bool> holding{false};
+  app.registerBlockingRoute("GET", "/hold", [&](const Request &) {
+    holding = true;
+    released.wait();
+    return Response(200, "OK", "Held", {{"Content-Type", "text/plain"}});
+  });
+  app.registerBlockingRoute("GET", "/query", [](const Request &) {
+    return Response(200, "OK", "Done", {{"Content-Type", "text/plain"}});
+  });
+  start();
+
+  int held = connectClient();
+  sendAll(held, "GET /hold HTTP/1.1\r\n\r\n");
+  shutdown(held, SHUT_WR);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!holding && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(holding);
+
+  // The reactors spread these over both workers' deques, so half of them are
+  // queued behind the held handler and are answered only if stolen
+  timeval timeout{5, 0};
+  std::vector<int> clients;
+  for (int i = 0; i < 16; ++i) {
+    int fd = connectClient();
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sendAll(fd, "GET /query HTTP/1.1\r\n\r\n");
+    shutdown(fd, SHUT_WR);
+    clients.push_back(fd);
+  }
+  for (int fd : clients) {
+    std::string raw = readAll(fd);
+    close(fd);
+    EXPECT_NE(raw.find("\r\n\r\nDone"), std::string::npos);
+  }
+
+  release.set_value();
+  std::string raw = readAll(held);
+  close(held);
+  EXPECT_NE(raw.find("\r\n\r\nHeld"), std::string::npos);
+}
+
+TEST_F(ServerTest, ReusesConnectionForSeveralRequests) {
+  int fd = connectClient();
+  std::string pending;
+  sendAll(fd, "GET /home HTTP/1.1\r\n\r\n");
+  std::string first = readResponse(fd, pending);
+  EXPECT_EQ(first.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  EXPECT_NE(first.find("Connection: keep-alive"), std::string::npos);
+  EXPECT_NE(first.find("\r\n\r\nHome Page"), std::string::npos);
+
+  sendAll(fd, "POST /echo HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello");
+  std::string second = readResponse(fd, pending);
+  EXPECT_NE(second.find("\r\n\r\nhello"), std::string::npos);
+
+  sendAll(fd, "GET /users/42 HTTP/1.1\r\nConnection: close\r\n\r\n");
+  std::string last = readAll(fd);
+  close(fd);
+  EXPECT_EQ(pending, "");
+  EXPECT_NE(last.find("Connection: close"), std::string::npos);
+  EXPECT_NE(last.find("\r\n\r\n42"), std::string::npos);
+}
+
+TEST_F(ServerTest, AnswersPipelinedRequestsInOrder) {
+  int fd = connectClient();
+  sendAll(fd,
+          "GET /users/1 HTTP/1.1\r\n\r\n"
+          "GET /slow HTTP/1.1\r\n\r\n"
+          "POST /echo HTTP/1.1\r\nContent-Length: 4\r\n\r\nping"
+          "GET /users/2 HTTP/1.1\r\n\r\n");
+  shutdown(fd, SHUT_WR);
+  std::string raw = readAll(fd);
+  close(fd);
+
+  std::size_t first = raw.find("\r\n\r\n1");
+  std::size_t second = raw.find("\r\n\r\nSlow Page");
+  std::size_t third = raw.find("\r\n\r\nping");
+  std::size_t fourth = raw.find("\r\n\r\n2");
+  ASSERT_NE(first, std::string::npos);
+  ASSERT_NE(second, std::string::npos);
+  ASSERT_NE(third, std::string::npos);
+  ASSERT_NE(fourth, std::string::npos);
+  EXPECT_LT(first, second);
+  EXPECT_LT(second, third);
+  EXPECT_LT(third, fourth);
+}
+
+TEST_F(ServerTest, ClosesAfterMaxRequestsPerConnection) {
+  stop();
+  options.maxRequestsPerConnection = 2;
+  start();
+
+  int fd = connectClient();
+  sendAll(fd,
+          "GET /users/1 HTTP/1.1\r\n\r\n"
+          "GET /users/2 HTTP/1.1\r\n\r\n"
+          "GET /users/3 HTTP/1.1\r\n\r\n");
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_NE(raw.find("\r\n\r\n1"), std::string::npos);
+  EXPECT_NE(raw.find("Connection: close\r\n"), std::string::npos);
+  EXPECT_NE(raw.find("\r\n\r\n2"), std::string::npos);
+  EXPECT_EQ(raw.find("\r\n\r\n3"), std::string::npos);
+}
+
+TEST_F(ServerTest, ClosesIdleConnections) {
+  stop();
+  options.idleTimeout = std::chrono::milliseconds(100);
+  start();
+
+  int fd = connectClient();
+  std::string pending;
+  sendAll(fd, "GET /home HTTP/1.1\r\n\r\n");
+  EXPECT_NE(readResponse(fd, pending).find("Home Page"), std::string::npos);
+
+  auto started = std::chrono::steady_clock::now();
+  EXPECT_EQ(readAll(fd), "");
+  close(fd);
+  auto waited = std::chrono::steady_clock::now() - started;
+  EXPECT_GE(waited, std::chrono::milliseconds(90));
+  EXPECT_LT(waited, std::chrono::seconds(2));
+}
+
+TEST_F(ServerTest, TimesOutHeadersThatTrickleIn) {
+  stop();
+  options.headerTimeout = std::chrono::milliseconds(400);
+  start();
+
+  // Steady progress does not extend the header deadline, which would
+  // otherwise end 400 ms after the last byte rather than the first
+  int fd = connectClient();
+  auto started = std::chrono::steady_clock::now();
+  for (char c : std::string("GET /home HTTP/1.1\r\nX-Slow: ")) {
+    sendAll(fd, std::string(1, c));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_EQ(raw.compare(0, 28, "HTTP/1.1 408 Request Timeout"), 0);
+  EXPECT_LT(std::chrono::steady_clock::now() - started,
+            std::chrono::milliseconds(650));
+}
+
+TEST_F(ServerTest, TimesOutStalledBodies) {
+  stop();
+  options.bodyTimeout = std::chrono::milliseconds(100);
+  start();
+
+  int fd = connectClient();
+  sendAll(fd, "POST /echo HTTP/1.1\r\nContent-Length: 10\r\n\r\nabc");
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_EQ(raw.compare(0, 28, "HTTP/1.1 408 Request Timeout"), 0);
+}
+
+TEST_F(ServerTest, ClosesConnectionsThatStopReading) {
+  stop();
+  options.writeTimeout = std::chrono::milliseconds(100);
+  start();
+
+  int fd = connectClient();
+  int size = 4096;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  sendAll(fd, "GET /large HTTP/1.1\r\n\r\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+  // The server gave up before the whole body was written
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_LT(raw.size(), largeBody().size());
+}
+
+TEST_F(ServerTest, ClosesHttp10ConnectionsUnlessAskedToKeepThem) {
+  int fd = connectClient();
+  sendAll(fd, "GET /home HTTP/1.0\r\n\r\n");
+  std::string raw = readAll(fd);
+  close(fd);
+  EXPECT_NE(raw.find("Connection: close"), std::string::npos);
+  EXPECT_NE(raw.find("\r\n\r\nHome Page"), std::string::npos);
+
+  fd = connectClient();
+  std::string pending;
+  sendAll(fd, "GET /home HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+  raw = readResponse(fd, pending);
+  EXPECT_NE(raw.find("Connection: keep-alive"), std::string::npos);
+  sendAll(fd, "GET /users/5 HTTP/1.0\r\n\r\n");
+  raw = readAll(fd);
+  close(fd);
+  EXPECT_NE(raw.find("\r\n\r\n5"), std::string::npos);
+}
+
+TEST_F(ServerTest, StopDrainsBlockingRequests) {
+  int slow = connectClient();
+  sendAll(slow, "GET /slow HTTP/1.1\r\n\r\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  stop();
+  std::string raw = readAll(slow);
+  close(slow);
+  EXPECT_NE(raw.find("\r\n\r\nSlow Page"), std::string::npos);
+}
+
+TEST_F(ServerTest, StopDrainsInFlightRequests) {
+  int busy = connectClient();
+  int idle = connectClient();
+  sendAll(busy, "POST /echo HTTP/1.1\r\nContent-Length: 4\r\n\r\nab");
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::thread stopper([this] { server->stop(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // The idle connection is closed without a response
+  EXPECT_EQ(readAll(idle), "");
+  close(idle);
+
+  // The in-flight request still completes
+  sendAll(busy, "cd");
+  std::string raw = readAll(busy);
+  close(busy);
+  EXPECT_NE(raw.find("\r\n\r\nabcd"), std::string::npos);
+
+  stopper.join();
+  thread.join();
+}
+
+TEST_F(ServerTest, StopGivesUpAfterDrainTimeout) {
+  stop();
+  options.drainTimeout = std::chrono::milliseconds(50);
+  start();
+
+  int stalled = connectClient();
+  sendAll(stalled, "GET /home HTTP/1.1\r\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto started = std::chrono::steady_clock::now();
+  stop();
+  EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(2));
+  EXPECT_EQ(readAll(stalled), "");
+  close(stalled);
+}
+
+TEST(ServerLifecycleTest, RunWithoutListenThrows) {
+  App app;
+  Server server(app);
+  EXPECT_THROW(server.run(), std::runtime_error);
+}
+
+TEST(ServerLifecycleTest, InvalidAddressThrows) {
+  App app;
+  Server server(app);
+  EXPECT_THROW(server.listen("not-an-address", 0), std::runtime_error);
+}
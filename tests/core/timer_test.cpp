@@ -0,0 +1,181 @@
+#include "timer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace core;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  TimerWheel::Clock::time_point origin = TimerWheel::Clock::now();
+  TimerWheel wheel{origin};
+
+  TimerWheel::Clock::time_point at(TimerWheel::Clock::duration offset) {
+    return origin + offset;
+  }
+};
+
+TEST_F(TimerWheelTest, FiresAtTheDeadlineAndNotBefore) {
+  int fired = 0;
+  Timer timer([&fired] { ++fired; });
+  wheel.arm(timer, at(milliseconds(10)));
+  EXPECT_TRUE(timer.isArmed());
+  EXPECT_EQ(wheel.size(), 1);
+
+  EXPECT_EQ(wheel.advance(at(milliseconds(9))), 0);
+  EXPECT_EQ(fired, 0);
+  EXPECT_EQ(wheel.advance(at(milliseconds(10))), 1);
+  EXPECT_EQ(fired, 1);
+  EXPECT_FALSE(timer.isArmed());
+  EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TimerWheelTest, CancelledTimersDoNotFire) {
+  int fired = 0;
+  Timer timer([&fired] { ++fired; });
+  wheel.arm(timer, at(milliseconds(5)));
+  wheel.cancel(timer);
+  EXPECT_FALSE(timer.isArmed());
+  wheel.advance(at(seconds(1)));
+  EXPECT_EQ(fired, 0);
+
+  // Cancelling twice is harmless
+  wheel.cancel(timer);
+  EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TimerWheelTest, RearmingMovesTheDeadline) {
+  int fired = 0;
+  Timer timer([&fired] { ++fired; });
+  wheel.arm(timer, at(milliseconds(5)));
+  wheel.arm(timer, at(milliseconds(500)));
+  EXPECT_EQ(wheel.size(), 1);
+  wheel.advance(at(milliseconds(499)));
+  EXPECT_EQ(fired, 0);
+  wheel.advance(at(milliseconds(500)));
+  EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerWheelTest, DestroyingATimerCancelsIt) {
+  auto timer = std::make_unique<Timer>([] { FAIL(); });
+  wheel.arm(*timer, at(milliseconds(5)));
+  timer.reset();
+  EXPECT_EQ(wheel.size(), 0);
+  wheel.advance(at(seconds(1)));
+}
+
+TEST_F(TimerWheelTest, CascadesDeadlinesFromEveryLevel) {
+  // One deadline per level, plus one beyond the wheel's span
+  std::vector<TimerWheel::Clock::duration> offsets = {
+      milliseconds(63), milliseconds(64), milliseconds(4095),
+      milliseconds(4096), seconds(300), hours(4), hours(10)};
+  std::vector<std::unique_ptr<Timer>> timers;
+  std::vector<TimerWheel::Clock::duration> firedAt(offsets.size());
+  TimerWheel::Clock::duration now{};
+  for (std::size_t i = 0; i < offsets.size(); ++i) {
+    timers.push_back(
+        std::make_unique<Timer>([&firedAt, &now, i] { firedAt[i] = now; }));
+    wheel.arm(*timers[i], at(offsets[i]));
+  }
+
+  // Step in uneven increments so that whole ranges of ticks are skipped
+  for (now = milliseconds(0); now <= hours(11); now += milliseconds(997)) {
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+      if (offsets[i] <= now && offsets[i] + milliseconds(997) > now) {
+        // Due in this step: check the exact tick too
+        wheel.advance(at(offsets[i] - milliseconds(1)));
+        EXPECT_TRUE(timers[i]->isArmed()) << i;
+      }
+    }
+    wheel.advance(at(now));
+  }
+  for (std::size_t i = 0; i < offsets.size(); ++i) {
+    EXPECT_FALSE(timers[i]->isArmed()) << i;
+    EXPECT_GE(firedAt[i], offsets[i]) << i;
+    EXPECT_LT(firedAt[i], offsets[i] + milliseconds(997)) << i;
+  }
+}
+
+TEST_F(TimerWheelTest, PastDeadlinesFireOnTheNextAdvance) {
+  wheel.advance(at(seconds(1)));
+  int fired = 0;
+  Timer timer([&fired] { ++fired; });
+  wheel.arm(timer, at(milliseconds(1)));
+  EXPECT_EQ(wheel.advance(at(seconds(1))), 0);
+  EXPECT_EQ(wheel.advance(at(seconds(1) + milliseconds(1))), 1);
+  EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerWheelTest, NextDeadlineBoundsTheSleep) {
+  EXPECT_EQ(wheel.nextDeadline(), TimerWheel::Clock::time_point::max());
+
+  Timer near;
+  Timer far;
+  wheel.arm(far, at(seconds(30)));
+  // Far deadlines report when they are cascaded, which is no later
+  EXPECT_LE(wheel.nextDeadline(), at(seconds(30)));
+  wheel.arm(near, at(milliseconds(20)));
+  EXPECT_EQ(wheel.nextDeadline(), at(milliseconds(20)));
+
+  while (far.isArmed()) {
+    TimerWheel::Clock::time_point next = wheel.nextDeadline();
+    ASSERT_GT(next, at(milliseconds(0)));
+    ASSERT_LE(next, at(seconds(30)));
+    wheel.advance(next);
+  }
+  EXPECT_EQ(wheel.nextDeadline(), TimerWheel::Clock::time_point::max());
+}
+
+TEST_F(TimerWheelTest, CallbacksMayCancelAndRearmTimers) {
+  Timer other([] { FAIL(); });
+  int repeats = 0;
+  Timer repeating;
+  repeating.setCallback([&] {
+    wheel.cancel(other);
+    if (++repeats < 3) {
+      wheel.arm(repeating, at(milliseconds(10 * (repeats + 1))));
+    }
+  });
+  wheel.arm(repeating, at(milliseconds(10)));
+  wheel.arm(other, at(milliseconds(15)));
+
+  wheel.advance(at(seconds(1)));
+  EXPECT_EQ(repeats, 3);
+  EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TimerWheelTest, FiresManyTimersInDeadlineOrder) {
+  constexpr int kTimers = 100000;
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> deadline(1, 60000);
+  std::vector<std::unique_ptr<Timer>> timers;
+  int last = 0;
+  int fired = 0;
+  bool ordered = true;
+  for (int i = 0; i < kTimers; ++i) {
+    int milliseconds = deadline(random);
+    timers.push_back(std::make_unique<Timer>([&, milliseconds] {
+      ordered = ordered && milliseconds >= last;
+      last = milliseconds;
+      ++fired;
+    }));
+    wheel.arm(*timers.back(), at(std::chrono::milliseconds(milliseconds)));
+  }
+  EXPECT_EQ(wheel.size(), kTimers);
+
+  // Cancel every tenth timer
+  for (int i = 0; i < kTimers; i += 10) {
+    wheel.cancel(*timers[i]);
+  }
+  wheel.advance(at(seconds(61)));
+  EXPECT_EQ(fired, kTimers - kTimers / 10);
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(wheel.size(), 0);
+}
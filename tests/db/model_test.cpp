@@ -0,0 +1,166 @@
+#include "model.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "connection.hpp"
+#include "query.hpp"
+
+namespace {
+
+struct User {
+  std::int64_t id;
+  std::string name;
+  int age;
+  double score;
+  bool active;
+};
+
+/**
+ * The same table as User, with the name read as a view.
+ */
+struct UserView {
+  std::int64_t id;
+  std::string_view name;
+};
+
+}  // namespace
+
+template <>
+struct db::Schema<User> {
+  static constexpr const char *table = "users";
+  static constexpr auto fields = std::make_tuple(
+      db::field("id", &User::id), db::field("name", &User::name),
+      db::field("age", &User::age), db::field("score", &User::score),
+      db::field("active", &User::active));
+};
+
+template <>
+struct db::Schema<UserView> {
+  static constexpr const char *table = "users";
+  static constexpr auto fields = std::make_tuple(
+      db::field("id", &UserView::id), db::field("name", &UserView::name));
+};
+
+using namespace db;
+
+class ModelTest : public ::testing::Test {
+ protected:
+  Connection connection{":memory:"};
+
+  void SetUp() override {
+    connection.execute(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT NOT NULL, "
+        "age INTEGER, score REAL, active INTEGER)");
+  }
+
+  std::vector<User> sampleUsers() {
+    return {{0, "Ada", 36, 9.5, true},
+            {0, "Grace", 45, 8.0, false},
+            {0, "Linus", 28, 7.25, true}};
+  }
+};
+
+TEST_F(ModelTest, InsertsAndFindsRows) {
+  User user{0, "Ada", 36, 9.5, true};
+  Model<User>::insert(connection, user);
+  EXPECT_GT(user.id, 0);
+
+  std::optional<User> found = Model<User>::find(connection, user.id);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(found->name, "Ada");
+  EXPECT_EQ(found->age, 36);
+  EXPECT_DOUBLE_EQ(found->score, 9.5);
+  EXPECT_TRUE(found->active);
+
+  EXPECT_FALSE(Model<User>::find(connection, user.id + 1));
+}
+
+TEST_F(ModelTest, InsertManyAssignsKeys) {
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+  EXPECT_EQ(users[0].id + 1, users[1].id);
+  EXPECT_EQ(users[1].id + 1, users[2].id);
+
+  std::vector<User> all = Model<User>::all(connection);
+  ASSERT_EQ(all.size(), 3);
+  EXPECT_EQ(all[2].name, "Linus");
+  EXPECT_FALSE(all[1].active);
+}
+
+TEST_F(ModelTest, InsertManyIsAllOrNothing) {
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+
+  // An empty view binds NULL, so the second row violates NOT NULL and the
+  // first is rolled back with it
+  std::vector<UserView> views = {{0, "Katherine"}, {0, std::string_view()}};
+  EXPECT_THROW(Model<UserView>::insertMany(connection, views),
+               std::runtime_error);
+  EXPECT_EQ(Model<User>::all(connection).size(), 3);
+
+  // The connection is left outside any transaction
+  EXPECT_NE(sqlite3_get_autocommit(connection.get_db()), 0);
+}
+
+TEST_F(ModelTest, UpdatesRows) {
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+
+  users[0].age = 37;
+  EXPECT_TRUE(Model<User>::update(connection, users[0]));
+  EXPECT_EQ(Model<User>::find(connection, users[0].id)->age, 37);
+
+  for (User &user : users) {
+    user.score += 1;
+  }
+  User missing{999, "Nobody", 0, 0, false};
+  users.push_back(missing);
+  EXPECT_EQ(Model<User>::updateMany(connection, users), 3);
+  EXPECT_DOUBLE_EQ(Model<User>::find(connection, users[2].id)->score, 8.25);
+}
+
+TEST_F(ModelTest, RemovesRows) {
+  User user{0, "Ada", 36, 9.5, true};
+  Model<User>::insert(connection, user);
+  EXPECT_TRUE(Model<User>::remove(connection, user.id));
+  EXPECT_FALSE(Model<User>::remove(connection, user.id));
+  EXPECT_TRUE(Model<User>::all(connection).empty());
+}
+
+TEST_F(ModelTest, SelectsWithQueries) {
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+
+  static const Query olderThan =
+      Model<User>::query().where("age", ">").orderBy("age", true);
+  std::vector<User> older = Model<User>::select(connection, olderThan, 30);
+  ASSERT_EQ(older.size(), 2);
+  EXPECT_EQ(older[0].name, "Grace");
+  EXPECT_EQ(older[1].name, "Ada");
+}
+
+TEST_F(ModelTest, StreamsRowsAsViews) {
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+
+  std::vector<std::string> names;
+  Model<UserView>::each(
+      connection, Model<UserView>::query().orderBy("name"),
+      [&names](const UserView &user) { names.emplace_back(user.name); });
+  EXPECT_EQ(names, (std::vector<std::string>{"Ada", "Grace", "Linus"}));
+}
+
+TEST_F(ModelTest, JoinsAnOuterTransaction) {
+  connection.execute("BEGIN");
+  std::vector<User> users = sampleUsers();
+  Model<User>::insertMany(connection, users);
+  connection.execute("ROLLBACK");
+  EXPECT_TRUE(Model<User>::all(connection).empty());
+}
@@ -0,0 +1,115 @@
+#include "pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "temporary_directory.hpp"
+
+using namespace db;
+
+class PoolTest : public ::testing::Test {
+ protected:
+  TemporaryDirectory directory{"ember-pool"};
+  std::string path = directory.getPath() + "/test.db";
+
+  static std::string text(sqlite3 *db, const std::string &sql) {
+    sqlite3_stmt *statement = nullptr;
+    EXPECT_EQ(sqlite3_prepare_v2(db, sql.c_str(), -1, &statement, nullptr),
+              SQLITE_OK);
+    std::string value;
+    if (sqlite3_step(statement) == SQLITE_ROW) {
+      value = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+    }
+    sqlite3_finalize(statement);
+    return value;
+  }
+};
+
+TEST_F(PoolTest, EnablesWalMode) {
+  Pool pool(path, 2);
+  EXPECT_EQ(pool.readers(), 2);
+  EXPECT_EQ(text(pool.read().get_db(), "PRAGMA journal_mode"), "wal");
+}
+
+TEST_F(PoolTest, ReadersSeeCommittedWrites) {
+  Pool pool(path, 2);
+  pool.write()->execute(
+      "CREATE TABLE users (name TEXT); INSERT INTO users VALUES ('Ada');");
+  EXPECT_EQ(text(pool.read().get_db(), "SELECT name FROM users"), "Ada");
+}
+
+TEST_F(PoolTest, ReadersAreReadOnly) {
+  Pool pool(path, 1);
+  pool.write()->execute("CREATE TABLE users (name TEXT)");
+  EXPECT_THROW(pool.read()->execute("INSERT INTO users VALUES ('Ada')"),
+               std::runtime_error);
+}
+
+TEST_F(PoolTest, ThreadKeepsItsHomeReader) {
+  Pool pool(path, 4);
+  sqlite3 *first = pool.read().get_db();
+  EXPECT_EQ(pool.read().get_db(), first);
+
+  // While the home reader is leased, another one is handed out
+  Pool::Lease held = pool.read();
+  Pool::Lease other = pool.read();
+  EXPECT_NE(held.get_db(), other.get_db());
+}
+
+TEST_F(PoolTest, MovedLeaseReturnsTheConnectionOnce) {
+  Pool pool(path, 1);
+  sqlite3 *db = nullptr;
+  {
+    Pool::Lease lease = pool.read();
+    Pool::Lease moved = std::move(lease);
+    db = moved.get_db();
+  }
+  EXPECT_EQ(pool.read().get_db(), db);
+}
+
+TEST_F(PoolTest, WaitsForALeaseToBeReturned) {
+  Pool pool(path, 1);
+  std::atomic<bool> acquired{false};
+  std::thread waiter;
+  {
+    Pool::Lease writer = pool.write();
+    waiter = std::thread([&pool, &acquired] {
+      Pool::Lease lease = pool.write();
+      acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired);
+  }
+  waiter.join();
+  EXPECT_TRUE(acquired);
+}
+
+TEST_F(PoolTest, ServesManyThreads) {
+  Pool pool(path, 2);
+  pool.write()->execute(
+      "CREATE TABLE counters (value INTEGER);"
+      "INSERT INTO counters VALUES (7);");
+
+  std::atomic<int> matches{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&pool, &matches] {
+      for (int j = 0; j < 50; ++j) {
+        if (text(pool.read().get_db(), "SELECT value FROM counters") == "7") {
+          ++matches;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(matches, 400);
+}
@@ -0,0 +1,131 @@
+#include "query.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "connection.hpp"
+#include "statement.hpp"
+
+using namespace db;
+
+class QueryTest : public ::testing::Test {
+ protected:
+  Connection connection{":memory:"};
+
+  void SetUp() override {
+    connection.execute(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, age INTEGER)");
+  }
+};
+
+TEST_F(QueryTest, BuildsParameterizedSql) {
+  EXPECT_EQ(Query::select("users").getSql(), "SELECT * FROM \"users\"");
+  EXPECT_EQ(Query::select("users", {"id", "name"})
+                .where("age", ">=")
+                .where("name", "like")
+                .orderBy("age", true)
+                .orderBy("id")
+                .limit(true)
+                .getSql(),
+            "SELECT \"id\", \"name\" FROM \"users\" WHERE \"age\" >= ? AND "
+            "\"name\" LIKE ? ORDER BY \"age\" DESC, \"id\" ASC LIMIT ? "
+            "OFFSET ?");
+  EXPECT_EQ(Query::insert("users", {"name", "age"}).getSql(),
+            "INSERT INTO \"users\" (\"name\", \"age\") VALUES (?, ?)");
+  EXPECT_EQ(Query::update("users", {"name"}).where("id").getSql(),
+            "UPDATE \"users\" SET \"name\" = ? WHERE \"id\" = ?");
+  EXPECT_EQ(Query::remove("users").whereIn("id", 3).getSql(),
+            "DELETE FROM \"users\" WHERE \"id\" IN (?, ?, ?)");
+}
+
+TEST_F(QueryTest, CountsParameters) {
+  EXPECT_EQ(Query::select("users").getParameterCount(), 0);
+  EXPECT_EQ(Query::select("users").where("id").limit(true).getParameterCount(),
+            3);
+  EXPECT_EQ(Query::update("users", {"name", "age"})
+                .where("id")
+                .getParameterCount(),
+            3);
+}
+
+TEST_F(QueryTest, QuotesIdentifiers) {
+  EXPECT_EQ(Query::select("we\"ird", {"a b"}).getSql(),
+            "SELECT \"a b\" FROM \"we\"\"ird\"");
+}
+
+TEST_F(QueryTest, RejectsInvalidShapes) {
+  EXPECT_THROW(Query::insert("users", {}), std::runtime_error);
+  EXPECT_THROW(Query::update("users", {}), std::runtime_error);
+  EXPECT_THROW(Query::insert("users", {"name"}).where("id"),
+               std::runtime_error);
+  EXPECT_THROW(Query::remove("users").orderBy("id"), std::runtime_error);
+  EXPECT_THROW(Query::remove("users").limit(), std::runtime_error);
+  EXPECT_THROW(Query::select("users").where("id", "; DROP"),
+               std::runtime_error);
+  EXPECT_THROW(Query::select("users").whereIn("id", 0), std::runtime_error);
+}
+
+TEST_F(QueryTest, RunsAgainstAConnection) {
+  Query insert = Query::insert("users", {"name", "age"});
+  EXPECT_EQ(insert.execute(connection, "Ada", 36), 1);
+  EXPECT_EQ(insert.execute(connection, std::string("Grace"), 45), 1);
+  EXPECT_EQ(insert.execute(connection, "Linus", nullptr), 1);
+
+  Query update = Query::update("users", {"age"}).where("name");
+  EXPECT_EQ(update.execute(connection, 37, "Ada"), 1);
+
+  Query select =
+      Query::select("users", {"name", "age"}).where("age", ">").orderBy("age");
+  Statement statement = select.prepare(connection, 30);
+  ASSERT_TRUE(statement.step());
+  EXPECT_EQ(statement.getText(0), "Ada");
+  EXPECT_EQ(statement.getInt(1), 37);
+  ASSERT_TRUE(statement.step());
+  EXPECT_EQ(statement.getText(0), "Grace");
+  EXPECT_FALSE(statement.step());
+
+  EXPECT_EQ(Query::remove("users").where("age", "IS").execute(connection,
+                                                              nullptr),
+            1);
+}
+
+TEST_F(QueryTest, SameShapeReusesTheCachedStatement) {
+  Query byId = Query::select("users", {"name"}).where("id");
+  byId.prepare(connection, 1);
+  std::uint64_t hits = connection.getCacheStats().hits;
+  Query::select("users", {"name"}).where("id").prepare(connection, 2);
+  EXPECT_EQ(connection.getCacheStats().hits, hits + 1);
+}
+
+TEST_F(QueryTest, RejectsWrongNumberOfValues) {
+  Query byId = Query::select("users").where("id");
+  EXPECT_THROW(byId.prepare(connection), std::runtime_error);
+  EXPECT_THROW(byId.prepare(connection, 1, 2), std::runtime_error);
+}
+
+TEST_F(QueryTest, PreparedStatementOwnsItsText) {
+  std::string name(40, 'n');
+  Query::insert("users", {"name", "age"}).execute(connection, name, 36);
+
+  // The temporary is freed, and its memory reused, before the statement
+  // steps
+  Query byName = Query::select("users", {"age"}).where("name");
+  Statement statement = byName.prepare(connection, std::string(name));
+  std::string filler(40, 'x');
+  ASSERT_TRUE(statement.step());
+  EXPECT_EQ(statement.getInt(0), 36);
+}
+
+TEST_F(QueryTest, BindsUnsignedValues) {
+  Query insert = Query::insert("users", {"id", "age"});
+  EXPECT_EQ(insert.execute(connection, std::size_t{7}, 30u), 1);
+
+  Statement statement = Query::select("users", {"age"})
+                            .where("id")
+                            .prepare(connection, std::uint64_t{7});
+  ASSERT_TRUE(statement.step());
+  EXPECT_EQ(statement.getInt(0), 30);
+}
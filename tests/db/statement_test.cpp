@@ -0,0 +1,156 @@
+#include "statement.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "connection.hpp"
+
+using namespace db;
+
+class StatementTest : public ::testing::Test {
+ protected:
+  Connection connection{":memory:"};
+
+  void SetUp() override {
+    connection.execute(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, score REAL)");
+  }
+
+  void insert(std::int64_t id, std::string_view name, double score) {
+    connection.prepare("INSERT INTO users VALUES (?, ?, ?)")
+        .bind(1, id)
+        .bind(2, name)
+        .bind(3, score)
+        .execute();
+  }
+};
+
+TEST_F(StatementTest, BindsAndReadsTypedValues) {
+  insert(1, "Ada", 9.5);
+  connection.prepare("INSERT INTO users VALUES (?, ?, ?)")
+      .bind(1, 2)
+      .bind(2, nullptr)
+      .bind(3, nullptr)
+      .execute();
+
+  Statement select =
+      connection.prepare("SELECT id, name, score FROM users ORDER BY id");
+  EXPECT_EQ(select.getColumnCount(), 3);
+  ASSERT_TRUE(select.step());
+  EXPECT_EQ(select.getInt(0), 1);
+  EXPECT_EQ(select.getText(1), "Ada");
+  EXPECT_DOUBLE_EQ(select.getDouble(2), 9.5);
+  ASSERT_TRUE(select.step());
+  EXPECT_EQ(select.getInt(0), 2);
+  EXPECT_TRUE(select.isNull(1));
+  EXPECT_EQ(select.getText(1), "");
+  EXPECT_FALSE(select.step());
+}
+
+namespace {
+
+template <typename Value, typename = void>
+struct Bindable : std::false_type {};
+
+template <typename Value>
+struct Bindable<Value, std::void_t<decltype(std::declval<Statement &>().bind(
+                           1, std::declval<Value>()))>> : std::true_type {};
+
+}  // namespace
+
+TEST_F(StatementTest, BindsUnsignedIntegersInRange) {
+  Statement select = connection.prepare("SELECT ?, ?, ?");
+  select.bind(1, 7u)
+      .bind(2, std::size_t{1} << 40)
+      .bind(3, std::uint64_t{std::numeric_limits<std::int64_t>::max()});
+  ASSERT_TRUE(select.step());
+  EXPECT_EQ(select.getInt(0), 7);
+  EXPECT_EQ(select.getInt(1), std::int64_t{1} << 40);
+  EXPECT_EQ(select.getInt(2), std::numeric_limits<std::int64_t>::max());
+
+  Statement overflow = connection.prepare("SELECT ?");
+  EXPECT_THROW(overflow.bind(1, std::numeric_limits<std::uint64_t>::max()),
+               std::runtime_error);
+}
+
+TEST_F(StatementTest, CopiesTextThatDoesNotOutliveTheBind) {
+  static_assert(Bindable<const std::string &>::value);
+  static_assert(!Bindable<std::string>::value,
+                "temporary strings must not be bound without copying");
+
+  Statement select = connection.prepare("SELECT ?");
+  select.bindCopy(1, std::string(64, 'x'));
+  ASSERT_TRUE(select.step());
+  EXPECT_EQ(select.getText(0), std::string(64, 'x'));
+}
+
+TEST_F(StatementTest, ReusesCachedStatements) {
+  insert(1, "Ada", 1.0);
+  insert(2, "Grace", 2.0);
+  const Connection::CacheStats &stats = connection.getCacheStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+  EXPECT_GT(stats.prepareTime.count(), 0);
+  EXPECT_EQ(connection.getCacheSize(), 1);
+
+  sqlite3_stmt *first = nullptr;
+  {
+    Statement select =
+        connection.prepare("SELECT name FROM users WHERE id = ?");
+    first = select.get_stmt();
+    select.bind(1, 2);
+    ASSERT_TRUE(select.step());
+    EXPECT_EQ(select.getText(0), "Grace");
+  }
+  // Returned statements come back reset, with no values bound
+  Statement again = connection.prepare("SELECT name FROM users WHERE id = ?");
+  EXPECT_EQ(again.get_stmt(), first);
+  EXPECT_FALSE(again.step());
+}
+
+TEST_F(StatementTest, NestedUseOfTheSameSqlGetsItsOwnStatement) {
+  insert(1, "Ada", 1.0);
+  Statement outer = connection.prepare("SELECT name FROM users");
+  ASSERT_TRUE(outer.step());
+  std::size_t cached = connection.getCacheSize();
+  Statement inner = connection.prepare("SELECT name FROM users");
+  EXPECT_NE(inner.get_stmt(), outer.get_stmt());
+  ASSERT_TRUE(inner.step());
+  EXPECT_EQ(outer.getText(0), "Ada");
+  EXPECT_EQ(connection.getCacheSize(), cached);
+}
+
+TEST_F(StatementTest, EvictsLeastRecentlyUsedStatements) {
+  connection.setCacheCapacity(2);
+  connection.prepare("SELECT 1");
+  connection.prepare("SELECT 2");
+  connection.prepare("SELECT 1");
+  connection.prepare("SELECT 3");
+  EXPECT_EQ(connection.getCacheSize(), 2);
+  EXPECT_EQ(connection.getCacheStats().evictions, 1);
+
+  // SELECT 1 was used more recently than SELECT 2, so it survived
+  std::uint64_t hits = connection.getCacheStats().hits;
+  connection.prepare("SELECT 1");
+  EXPECT_EQ(connection.getCacheStats().hits, hits + 1);
+  connection.prepare("SELECT 2");
+  EXPECT_EQ(connection.getCacheStats().hits, hits + 1);
+}
+
+TEST_F(StatementTest, ReportsErrors) {
+  EXPECT_THROW(connection.prepare("SELECT FROM"), std::runtime_error);
+  EXPECT_THROW(connection.prepare(""), std::runtime_error);
+  EXPECT_THROW(connection.prepare("SELECT ?").bind(2, 1), std::runtime_error);
+
+  insert(1, "Ada", 1.0);
+  EXPECT_THROW(insert(1, "Again", 1.0), std::runtime_error);
+}
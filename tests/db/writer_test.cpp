@@ -0,0 +1,136 @@
+#include "writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "connection.hpp"
+#include "statement.hpp"
+#include "temporary_directory.hpp"
+
+using namespace db;
+
+class WriterTest : public ::testing::Test {
+ protected:
+  // Declared first, so the connection is closed before it is removed
+  TemporaryDirectory directory{"ember-writer"};
+  std::unique_ptr<Connection> connection;
+
+  void SetUp() override {
+    connection =
+        std::make_unique<Connection>(directory.getPath() + "/test.db");
+    connection->execute(
+        "PRAGMA journal_mode=WAL;"
+        "CREATE TABLE events (id INTEGER PRIMARY KEY, name TEXT UNIQUE)");
+  }
+
+  static std::int64_t insertEvent(Connection &connection,
+                                  const std::string &name) {
+    connection.prepare("INSERT INTO events (name) VALUES (?)")
+        .bind(1, name)
+        .execute();
+    return sqlite3_last_insert_rowid(connection.get_db());
+  }
+
+  std::int64_t countEvents() {
+    Statement count = connection->prepare("SELECT COUNT(*) FROM events");
+    count.step();
+    return count.getInt(0);
+  }
+};
+
+TEST_F(WriterTest, CompletesEachFutureWithItsOwnResult) {
+  std::future<std::int64_t> first, second;
+  {
+    Writer writer(*connection);
+    first = writer.submit(
+        [](Connection &connection) { return insertEvent(connection, "a"); });
+    second = writer.submit(
+        [](Connection &connection) { return insertEvent(connection, "b"); });
+    EXPECT_NE(first.get(), second.get());
+  }
+  EXPECT_EQ(countEvents(), 2);
+}
+
+TEST_F(WriterTest, SupportsWritesWithoutResults) {
+  Writer writer(*connection);
+  std::future<void> done = writer.submit(
+      [](Connection &connection) { insertEvent(connection, "a"); });
+  done.get();
+  EXPECT_EQ(countEvents(), 1);
+}
+
+TEST_F(WriterTest, RollsBackOnlyTheFailingWrite) {
+  WriterOptions options;
+  options.maxDelay = std::chrono::milliseconds(50);
+  Writer writer(*connection, options);
+  auto ok = writer.submit(
+      [](Connection &connection) { return insertEvent(connection, "a"); });
+  auto failing = writer.submit([](Connection &connection) {
+    insertEvent(connection, "b");
+    // Violates UNIQUE, after the first insert of this write succeeded
+    return insertEvent(connection, "a");
+  });
+  auto later = writer.submit(
+      [](Connection &connection) { return insertEvent(connection, "c"); });
+
+  EXPECT_GT(ok.get(), 0);
+  EXPECT_THROW(failing.get(), std::runtime_error);
+  EXPECT_GT(later.get(), 0);
+  EXPECT_EQ(writer.getBatchCount(), 1);
+  EXPECT_EQ(countEvents(), 2);
+}
+
+TEST_F(WriterTest, GroupsConcurrentWritesIntoFewTransactions) {
+  WriterOptions options;
+  options.maxDelay = std::chrono::milliseconds(5);
+  Writer writer(*connection, options);
+
+  constexpr int kThreads = 8;
+  constexpr int kWritesPerThread = 25;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&writer, t] {
+      for (int i = 0; i < kWritesPerThread; ++i) {
+        std::string name = std::to_string(t) + "-" + std::to_string(i);
+        writer
+            .submit([name](Connection &connection) {
+              return insertEvent(connection, name);
+            })
+            .get();
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(writer.getWriteCount(), kThreads * kWritesPerThread);
+  EXPECT_LT(writer.getBatchCount(), writer.getWriteCount());
+  EXPECT_EQ(countEvents(), kThreads * kWritesPerThread);
+}
+
+TEST_F(WriterTest, CommitsQueuedWritesOnDestruction) {
+  std::vector<std::future<std::int64_t>> futures;
+  {
+    WriterOptions options;
+    options.maxBatch = 4;
+    Writer writer(*connection, options);
+    for (int i = 0; i < 10; ++i) {
+      futures.push_back(writer.submit([i](Connection &connection) {
+        return insertEvent(connection, std::to_string(i));
+      }));
+    }
+  }
+  for (std::future<std::int64_t> &future : futures) {
+    EXPECT_GT(future.get(), 0);
+  }
+  EXPECT_EQ(countEvents(), 10);
+}
@@ -0,0 +1,140 @@
+#include "file.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "temporary_directory.hpp"
+
+using namespace http;
+
+class FileTest : public ::testing::Test {
+ protected:
+  TemporaryDirectory temporary{"ember-file"};
+  const std::string &directory = temporary.getPath();
+
+  std::string write(const std::string &name, const std::string &content) {
+    std::string path = directory + "/" + name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path;
+  }
+};
+
+TEST_F(FileTest, OpensRegularFiles) {
+  std::string path = write("a.txt", "hello");
+  auto file = File::open(path);
+  ASSERT_NE(file, nullptr);
+  EXPECT_GE(file->getFd(), 0);
+  EXPECT_EQ(file->getSize(), 5);
+  EXPECT_EQ(file->getETag().front(), '"');
+  EXPECT_EQ(file->getETag().back(), '"');
+  EXPECT_NE(file->getLastModified().find(" GMT"), std::string::npos);
+
+  struct stat status;
+  ASSERT_EQ(stat(path.c_str(), &status), 0);
+  EXPECT_TRUE(file->isCurrent(status));
+}
+
+TEST_F(FileTest, RejectsMissingFilesAndDirectories) {
+  EXPECT_EQ(File::open(directory + "/missing"), nullptr);
+  EXPECT_EQ(File::open(directory), nullptr);
+}
+
+TEST_F(FileTest, CacheReusesOpenFiles) {
+  std::string path = write("a.txt", "hello");
+  FileCache cache(4, std::chrono::hours(1));
+
+  auto first = cache.get(path);
+  auto second = cache.get(path);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.getMisses(), 1);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.get(directory + "/missing"), nullptr);
+}
+
+TEST_F(FileTest, CacheEvictsLeastRecentlyUsed) {
+  FileCache cache(2, std::chrono::hours(1));
+  std::string a = write("a", "a");
+  std::string b = write("b", "b");
+  std::string c = write("c", "c");
+
+  auto keep = cache.get(a);
+  cache.get(b);
+  cache.get(a);  // a is now the most recent
+  cache.get(c);  // evicts b
+  EXPECT_EQ(cache.size(), 2);
+
+  std::size_t misses = cache.getMisses();
+  EXPECT_EQ(cache.get(a), keep);
+  EXPECT_EQ(cache.getMisses(), misses);
+  cache.get(b);
+  EXPECT_EQ(cache.getMisses(), misses + 1);
+}
+
+TEST_F(FileTest, CacheRevalidatesChangedFiles) {
+  std::string path = write("a.txt", "hello");
+  FileCache cache(4, std::chrono::milliseconds(0));
+
+  auto before = cache.get(path);
+  EXPECT_EQ(cache.get(path), before);
+
+  write("a.txt", "hello, world");
+  auto after = cache.get(path);
+  ASSERT_NE(after, nullptr);
+  EXPECT_NE(after, before);
+  EXPECT_EQ(after->getSize(), 12);
+  // The old descriptor stays valid for responses still using it
+  EXPECT_EQ(before->getSize(), 5);
+}
+
+TEST_F(FileTest, CacheServesConcurrentLookups) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 32; ++i) {
+    paths.push_back(write(std::to_string(i) + ".txt", std::string(i, 'x')));
+  }
+  // Revalidating on every hit exercises the stat() done outside the locks
+  FileCache cache(256, std::chrono::milliseconds(0));
+
+  std::vector<std::thread> threads;
+  std::atomic<int> wrong(0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 100; ++round) {
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+          auto file = cache.get(paths[i]);
+          if (!file || file->getSize() != i) {
+            ++wrong;
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(wrong, 0);
+  EXPECT_EQ(cache.size(), paths.size());
+  EXPECT_EQ(cache.getHits() + cache.getMisses(), 4 * 100 * paths.size());
+  EXPECT_GE(cache.getMisses(), paths.size());
+}
+
+TEST_F(FileTest, CacheForgetsDeletedFiles) {
+  std::string path = write("a.txt", "hello");
+  FileCache cache(4, std::chrono::milliseconds(0));
+  ASSERT_NE(cache.get(path), nullptr);
+  EXPECT_EQ(cache.size(), 1);
+
+  ASSERT_EQ(unlink(path.c_str()), 0);
+  EXPECT_EQ(cache.get(path), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,185 @@
+#include "headers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+using namespace http;
+
+namespace {
+
+/**
+ * A memory resource that counts the allocations it serves.
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(HeadersTest, DefaultConstructor) {
+  Headers headers;
+  EXPECT_TRUE(headers.empty());
+  EXPECT_EQ(headers.size(), 0);
+  EXPECT_EQ(headers.get("Host"), "");
+  EXPECT_FALSE(headers.has(Headers::Known::Host));
+}
+
+TEST(HeadersTest, LookupIgnoresCase) {
+  Headers headers = {{"Content-Type", "text/html"}, {"X-Request-Id", "abc"}};
+  EXPECT_EQ(headers.get("content-type"), "text/html");
+  EXPECT_EQ(headers.get("CONTENT-TYPE"), "text/html");
+  EXPECT_EQ(headers.get("x-request-id"), "abc");
+  EXPECT_TRUE(headers.has("X-REQUEST-ID"));
+  EXPECT_FALSE(headers.has("X-Request"));
+}
+
+TEST(HeadersTest, KnownHeadersAreIndexed) {
+  Headers headers;
+  headers.set("host", "example.com");
+  headers.set("CONTENT-LENGTH", "12");
+  EXPECT_EQ(headers.get(Headers::Known::Host), "example.com");
+  EXPECT_EQ(headers.get(Headers::Known::ContentLength), "12");
+  EXPECT_FALSE(headers.has(Headers::Known::Connection));
+  EXPECT_EQ(Headers::classify("Transfer-Encoding"),
+            Headers::Known::TransferEncoding);
+  EXPECT_EQ(Headers::classify("X-Custom"), Headers::Known::Count);
+  EXPECT_EQ(Headers::classify(""), Headers::Known::Count);
+}
+
+TEST(HeadersTest, SetReplacesAndKeepsOrder) {
+  Headers headers;
+  headers.set("Host", "a");
+  headers.set("X-One", "1");
+  headers.set("host", "a-much-longer-value");
+  headers.set("x-one", "2");
+
+  ASSERT_EQ(headers.size(), 2);
+  EXPECT_EQ(headers[0].name, "Host");
+  EXPECT_EQ(headers[0].value, "a-much-longer-value");
+  EXPECT_EQ(headers[1].name, "X-One");
+  EXPECT_EQ(headers[1].value, "2");
+}
+
+TEST(HeadersTest, AddKeepsDuplicates) {
+  Headers headers;
+  headers.add("Set-Cookie", "a=1");
+  headers.add("Set-Cookie", "b=2");
+  ASSERT_EQ(headers.size(), 2);
+  EXPECT_EQ(headers.get("set-cookie"), "a=1");
+
+  EXPECT_TRUE(headers.remove("SET-COOKIE"));
+  EXPECT_TRUE(headers.empty());
+  EXPECT_FALSE(headers.remove("Set-Cookie"));
+}
+
+TEST(HeadersTest, KeepsNamesPast64Kib) {
+  std::string name = "X-" + std::string(70 * 1024, 'a');
+  Headers headers;
+  headers.add(name, "1");
+  headers.add("Host", "example.com");
+
+  EXPECT_EQ(headers[0].name.size(), name.size());
+  EXPECT_EQ(headers.get(name), "1");
+  EXPECT_EQ(headers.get(Headers::Known::Host), "example.com");
+  EXPECT_TRUE(headers.remove(name));
+  EXPECT_EQ(headers.size(), 1);
+}
+
+TEST(HeadersTest, RemoveReindexesKnownHeaders) {
+  Headers headers = {{"X-First", "1"}, {"Host", "example.com"}};
+  headers.add("Connection", "close");
+  EXPECT_TRUE(headers.remove("x-first"));
+  EXPECT_EQ(headers.get(Headers::Known::Host), "example.com");
+  EXPECT_EQ(headers.get(Headers::Known::Connection), "close");
+  EXPECT_EQ(headers[0].name, "Host");
+}
+
+TEST(HeadersTest, SpillsPastInlineCapacity) {
+  Headers headers;
+  for (int i = 0; i < 40; ++i) {
+    headers.add("X-Header-" + std::to_string(i), std::to_string(i));
+  }
+  headers.set("Host", "example.com");
+
+  ASSERT_EQ(headers.size(), 41);
+  EXPECT_EQ(headers.get("x-header-0"), "0");
+  EXPECT_EQ(headers.get("x-header-39"), "39");
+  EXPECT_EQ(headers.get(Headers::Known::Host), "example.com");
+
+  EXPECT_TRUE(headers.remove("X-Header-3"));
+  EXPECT_EQ(headers.size(), 40);
+  EXPECT_EQ(headers[3].name, "X-Header-4");
+  EXPECT_EQ(headers.get(Headers::Known::Host), "example.com");
+
+  int visited = 0;
+  for (Headers::Field field : headers) {
+    EXPECT_FALSE(field.name.empty());
+    ++visited;
+  }
+  EXPECT_EQ(visited, 40);
+}
+
+TEST(HeadersTest, CopiesAreIndependent) {
+  Headers original = {{"Host", "example.com"}};
+  Headers copy = original;
+  copy.set("Host", "other.com");
+  EXPECT_EQ(original.get("Host"), "example.com");
+  EXPECT_EQ(copy.get("Host"), "other.com");
+  EXPECT_NE(original, copy);
+}
+
+TEST(HeadersTest, ConstructsFromMap) {
+  std::map<std::string, std::string> fields = {{"Accept", "*/*"},
+                                               {"Host", "example.com"}};
+  Headers headers(fields);
+  EXPECT_EQ(headers.size(), 2);
+  EXPECT_EQ(headers.get(Headers::Known::Accept), "*/*");
+  EXPECT_EQ(headers, Headers({{"Accept", "*/*"}, {"Host", "example.com"}}));
+}
+
+TEST(HeadersTest, ClearKeepsNothing) {
+  Headers headers = {{"Host", "example.com"}, {"X-Test", "1"}};
+  headers.clear();
+  EXPECT_TRUE(headers.empty());
+  EXPECT_FALSE(headers.has(Headers::Known::Host));
+  EXPECT_FALSE(headers.has("X-Test"));
+}
+
+TEST(HeadersTest, AllocatesFromItsResource) {
+  CountingResource resource;
+  Headers headers({{"Host", "example.com"}}, &resource);
+  EXPECT_EQ(headers.getResource(), &resource);
+  for (int i = 0; i < 20; ++i) {
+    headers.add("X-Field-" + std::to_string(i), "a value long enough");
+  }
+  EXPECT_GT(resource.allocations, 0);
+
+  // Moves keep the resource; copies leave it, so they can outlive it
+  std::size_t before = resource.allocations;
+  Headers moved(std::move(headers));
+  EXPECT_EQ(moved.getResource(), &resource);
+  Headers copy(moved);
+  EXPECT_EQ(copy.getResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(resource.allocations, before);
+  EXPECT_EQ(copy, moved);
+  EXPECT_EQ(copy.get("x-field-19"), "a value long enough");
+}
@@ -0,0 +1,39 @@
+#include "method.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace http;
+
+TEST(MethodTest, ParsesMethodsCaseInsensitively) {
+  EXPECT_EQ(parseMethod("GET"), Method::Get);
+  EXPECT_EQ(parseMethod("get"), Method::Get);
+  EXPECT_EQ(parseMethod("Post"), Method::Post);
+  EXPECT_EQ(parseMethod("DELETE"), Method::Delete);
+  EXPECT_EQ(parseMethod("PATCH"), Method::Patch);
+  EXPECT_EQ(parseMethod("PUT"), Method::Put);
+  EXPECT_EQ(parseMethod("OPTIONS"), Method::Options);
+}
+
+TEST(MethodTest, RejectsOtherMethods) {
+  EXPECT_EQ(parseMethod(""), Method::Count);
+  EXPECT_EQ(parseMethod("GETS"), Method::Count);
+  EXPECT_EQ(parseMethod("PURGE"), Method::Count);
+  EXPECT_EQ(parseMethod("PU"), Method::Count);
+}
+
+TEST(MethodTest, NamesRoundTrip) {
+  for (int i = 0; i < static_cast<int>(Method::Count); ++i) {
+    auto method = static_cast<Method>(i);
+    EXPECT_EQ(parseMethod(methodName(method)), method);
+  }
+  EXPECT_EQ(methodName(Method::Count), "");
+}
+
+TEST(MethodTest, FormatsSetsInMethodOrder) {
+  EXPECT_EQ(formatMethods(0), "");
+  EXPECT_EQ(formatMethods(methodBit(Method::Get)), "GET");
+  EXPECT_EQ(formatMethods(methodBit(Method::Delete) | methodBit(Method::Get) |
+                          methodBit(Method::Post)),
+            "GET, POST, DELETE");
+  EXPECT_EQ(methodBit(Method::Count), 0);
+}
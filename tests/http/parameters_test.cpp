@@ -0,0 +1,105 @@
+#include "parameters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+using namespace http;
+
+TEST(ParametersTest, ParsesPairsInOrder) {
+  Parameters parameters;
+  parameters.parse("q=example&lang=en&page=2");
+
+  ASSERT_EQ(parameters.size(), 3);
+  EXPECT_EQ(parameters[0].name, "q");
+  EXPECT_EQ(parameters[0].value, "example");
+  EXPECT_EQ(parameters[2].name, "page");
+  EXPECT_EQ(parameters[2].value, "2");
+  EXPECT_EQ(parameters.get("lang"), "en");
+  EXPECT_TRUE(parameters.has("page"));
+  EXPECT_FALSE(parameters.has("missing"));
+  EXPECT_TRUE(parameters.get("missing").empty());
+}
+
+TEST(ParametersTest, DecodesPercentEscapesAndPlus) {
+  Parameters parameters;
+  parameters.parse("name=John+Smith&city=S%C3%A3o%20Paulo&a%26b=c%3Dd");
+
+  EXPECT_EQ(parameters.get("name"), "John Smith");
+  EXPECT_EQ(parameters.get("city"), "S\xC3\xA3o Paulo");
+  EXPECT_EQ(parameters.get("a&b"), "c=d");
+}
+
+TEST(ParametersTest, KeepsMalformedEscapes) {
+  Parameters parameters;
+  parameters.parse("discount=100%&code=%zz1&tail=%4");
+
+  EXPECT_EQ(parameters.get("discount"), "100%");
+  EXPECT_EQ(parameters.get("code"), "%zz1");
+  EXPECT_EQ(parameters.get("tail"), "%4");
+}
+
+TEST(ParametersTest, KeepsRepeatedNames) {
+  Parameters parameters;
+  parameters.parse("tag=red&size=m&tag=blue&tag=green");
+
+  EXPECT_EQ(parameters.size(), 4);
+  EXPECT_EQ(parameters.getAll("tag"),
+            (std::vector<std::string_view>{"red", "blue", "green"}));
+  // The last value wins for single lookups
+  EXPECT_EQ(parameters.get("tag"), "green");
+  EXPECT_TRUE(parameters.getAll("missing").empty());
+}
+
+TEST(ParametersTest, HandlesEmptyPairsAndValues) {
+  Parameters parameters;
+  parameters.parse("&flag&empty=&=orphan&&x=1&");
+
+  ASSERT_EQ(parameters.size(), 4);
+  EXPECT_TRUE(parameters.has("flag"));
+  EXPECT_EQ(parameters.get("flag"), "");
+  EXPECT_TRUE(parameters.has("empty"));
+  EXPECT_EQ(parameters.get(""), "orphan");
+  EXPECT_EQ(parameters.get("x"), "1");
+}
+
+TEST(ParametersTest, ParseReplacesPreviousPairs) {
+  Parameters parameters;
+  parameters.parse("a=1&b=2");
+  parameters.parse("c=3");
+
+  EXPECT_EQ(parameters.size(), 1);
+  EXPECT_FALSE(parameters.has("a"));
+  EXPECT_EQ(parameters.get("c"), "3");
+
+  parameters.parse("");
+  EXPECT_TRUE(parameters.empty());
+}
+
+TEST(ParametersTest, Iterates) {
+  Parameters parameters;
+  parameters.parse("a=1&b=2&a=3");
+
+  std::vector<std::string_view> seen;
+  for (const auto &field : parameters) {
+    seen.push_back(field.name);
+    seen.push_back(field.value);
+  }
+  EXPECT_EQ(seen,
+            (std::vector<std::string_view>{"a", "1", "b", "2", "a", "3"}));
+}
+
+TEST(ParametersTest, AllocatesFromItsResource) {
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  Parameters parameters(&arena);
+  parameters.parse("name=John+Smith&age=30&tag=a&tag=b");
+  EXPECT_EQ(parameters.get("name"), "John Smith");
+
+  // Copies must not depend on the arena
+  Parameters copy(parameters);
+  EXPECT_EQ(copy.get("age"), "30");
+}
@@ -0,0 +1,211 @@
+#include "parser.hpp"
+
+#include <gtest/gtest.h>
+
+#include "request.hpp"
+
+using namespace http;
+
+TEST(ParserTest, ParsesCompleteRequest) {
+  std::string raw =
+      "GET /index.html?x=1 HTTP/1.1\r\n"
+      "Host: www.example.com\r\n"
+      "Accept:  text/html \r\n"
+      "\r\n";
+
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  EXPECT_EQ(parser.getMethod(), "GET");
+  EXPECT_EQ(parser.getUri(), "/index.html?x=1");
+  EXPECT_EQ(parser.getVersion(), "HTTP/1.1");
+  ASSERT_EQ(parser.getHeaderCount(), 2);
+  EXPECT_EQ(parser.getHeader(0).name, "Host");
+  EXPECT_EQ(parser.getHeader(0).value, "www.example.com");
+  EXPECT_EQ(parser.getHeader(1).value, "text/html");
+  EXPECT_EQ(parser.getBody(), "");
+  EXPECT_EQ(parser.getConsumed(), raw.size());
+  EXPECT_FALSE(parser.hasFraming());
+}
+
+TEST(ParserTest, ViewsPointIntoTheBuffer) {
+  std::string raw = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n";
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  EXPECT_EQ(parser.getUri().data(), raw.data() + 4);
+  EXPECT_EQ(parser.getHeader(0).value.data(), raw.data() + 23);
+}
+
+TEST(ParserTest, ResumesAcrossPartialReads) {
+  std::string raw =
+      "POST /submit HTTP/1.1\r\n"
+      "Content-Length: 11\r\n"
+      "\r\n"
+      "hello world";
+
+  Parser parser;
+  std::string buffer;
+  for (std::size_t i = 0; i + 1 < raw.size(); ++i) {
+    buffer.push_back(raw[i]);
+    ASSERT_EQ(parser.parse(buffer), Parser::Status::Incomplete) << i;
+  }
+  buffer.push_back(raw.back());
+  ASSERT_EQ(parser.parse(buffer), Parser::Status::Complete);
+  EXPECT_EQ(parser.getMethod(), "POST");
+  EXPECT_EQ(parser.getBody(), "hello world");
+}
+
+TEST(ParserTest, HonoursContentLengthExactly) {
+  std::string raw =
+      "POST /a HTTP/1.1\r\nContent-Length: 3\r\n\r\nabcGET /b HTTP/1.1\r\n\r\n";
+
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  EXPECT_EQ(parser.getBody(), "abc");
+  EXPECT_TRUE(parser.hasFraming());
+
+  std::string rest = raw.substr(parser.getConsumed());
+  parser.reset();
+  ASSERT_EQ(parser.parse(rest), Parser::Status::Complete);
+  EXPECT_EQ(parser.getUri(), "/b");
+}
+
+TEST(ParserTest, KeepsBinaryBodies) {
+  std::string body("\r\n\0\xff\n", 5);
+  std::string raw = "PUT /blob HTTP/1.1\r\nContent-Length: 5\r\n\r\n" + body;
+
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  EXPECT_EQ(parser.getBody(), body);
+}
+
+TEST(ParserTest, DecodesChunkedBodies) {
+  std::string raw =
+      "POST /chunked HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n"
+      "5;ext=1\r\nhello\r\n"
+      "6\r\n world\r\n"
+      "0\r\n"
+      "Trailer: value\r\n"
+      "\r\n";
+
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  EXPECT_EQ(parser.getBody(), "hello world");
+  EXPECT_EQ(parser.getConsumed(), raw.size());
+}
+
+TEST(ParserTest, DecodesChunkedBodiesAcrossPartialReads) {
+  std::string raw =
+      "POST /chunked HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n"
+      "A\r\n0123456789\r\n"
+      "0\r\n\r\n";
+
+  Parser parser;
+  std::string buffer;
+  Parser::Status status = Parser::Status::Incomplete;
+  for (char c : raw) {
+    buffer.push_back(c);
+    status = parser.parse(buffer);
+    ASSERT_NE(status, Parser::Status::Error);
+  }
+  ASSERT_EQ(status, Parser::Status::Complete);
+  EXPECT_EQ(parser.getBody(), "0123456789");
+}
+
+TEST(ParserTest, RejectsMalformedRequestLine) {
+  for (const char *raw : {"GET\r\n\r\n", "GET /a\r\n\r\n",
+                          "GET /a HTTP/1.1 extra\r\n\r\n", "G(T /a HTTP/1.1\r\n\r\n",
+                          "GET /a FTP/1.1\r\n\r\n"}) {
+    Parser parser;
+    EXPECT_EQ(parser.parse(raw), Parser::Status::Error) << raw;
+    EXPECT_EQ(parser.getErrorStatus(), 400) << raw;
+  }
+}
+
+TEST(ParserTest, RejectsMalformedHeaders) {
+  for (const char *raw :
+       {"GET /a HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET /a HTTP/1.1\r\nBad Name: x\r\n\r\n",
+        "GET /a HTTP/1.1\r\nHost: a\r\n folded\r\n\r\n",
+        "GET /a HTTP/1.1\r\nContent-Length: -1\r\n\r\n",
+        "GET /a HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+        "GET /a HTTP/1.1\r\nContent-Length: 1\r\n"
+        "Transfer-Encoding: chunked\r\n\r\n"}) {
+    Parser parser;
+    EXPECT_EQ(parser.parse(raw), Parser::Status::Error) << raw;
+    EXPECT_EQ(parser.getErrorStatus(), 400) << raw;
+  }
+}
+
+TEST(ParserTest, RejectsUnsupportedTransferEncoding) {
+  Parser parser;
+  EXPECT_EQ(parser.parse("POST /a HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n"),
+            Parser::Status::Error);
+  EXPECT_EQ(parser.getErrorStatus(), 501);
+}
+
+TEST(ParserTest, RejectsMalformedChunks) {
+  Parser parser;
+  EXPECT_EQ(parser.parse("POST /a HTTP/1.1\r\nTransfer-Encoding: chunked\r\n"
+                         "\r\nzz\r\n"),
+            Parser::Status::Error);
+  EXPECT_EQ(parser.getErrorStatus(), 400);
+
+  parser.reset();
+  EXPECT_EQ(parser.parse("POST /a HTTP/1.1\r\nTransfer-Encoding: chunked\r\n"
+                         "\r\n2\r\nabc\r\n"),
+            Parser::Status::Error);
+}
+
+TEST(ParserTest, EnforcesLimits) {
+  Parser parser(64, 4);
+  EXPECT_EQ(parser.parse("GET /a HTTP/1.1\r\nX: " + std::string(100, 'a')),
+            Parser::Status::Error);
+  EXPECT_EQ(parser.getErrorStatus(), 431);
+
+  parser.reset();
+  EXPECT_EQ(parser.parse("POST /a HTTP/1.1\r\nContent-Length: 5\r\n\r\n"),
+            Parser::Status::Error);
+  EXPECT_EQ(parser.getErrorStatus(), 413);
+
+  parser.reset();
+  EXPECT_EQ(parser.parse("POST /a HTTP/1.1\r\nTransfer-Encoding: chunked\r\n"
+                         "\r\n5\r\n"),
+            Parser::Status::Error);
+  EXPECT_EQ(parser.getErrorStatus(), 413);
+}
+
+TEST(ParserTest, ToRequest) {
+  std::string raw =
+      "POST /submit HTTP/1.1\r\nHost: example.com\r\nContent-Length: 4\r\n"
+      "\r\nbody";
+
+  Parser parser;
+  ASSERT_EQ(parser.parse(raw), Parser::Status::Complete);
+  Request request;
+  parser.toRequest(request);
+  EXPECT_EQ(request.getMethod(), "POST");
+  EXPECT_EQ(request.getUri(), "/submit");
+  EXPECT_EQ(request.getVersion(), "HTTP/1.1");
+  EXPECT_EQ(request.getHeader("Host"), "example.com");
+  EXPECT_EQ(request.getBody(), "body");
+}
+
+TEST(ParserTest, ToRequestKeepsRepeatedHeaders) {
+  Parser parser;
+  ASSERT_EQ(parser.parse("GET / HTTP/1.1\r\nCookie: a=1\r\nHost: x\r\n"
+                         "Cookie: b=2\r\n\r\n"),
+            Parser::Status::Complete);
+  Request request;
+  parser.toRequest(request);
+
+  const Headers &headers = request.getHeaders();
+  ASSERT_EQ(headers.size(), 3);
+  EXPECT_EQ(headers[0].name, "Cookie");
+  EXPECT_EQ(headers[0].value, "a=1");
+  EXPECT_EQ(headers[2].name, "Cookie");
+  EXPECT_EQ(headers[2].value, "b=2");
+}
@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
 TEST(RequestTest, DefaultConstructor) {
   http::Request request;
   EXPECT_EQ(request.getMethod(), "");
@@ -80,6 +86,45 @@ TEST(RequestTest, GetInputParameter) {
   EXPECT_TRUE(request.getInputParameter("nonexistent").empty());
 }
 
+TEST(RequestTest, InternsMethod) {
+  http::Request request("post", "/submit", "HTTP/1.1", "", {});
+  EXPECT_EQ(request.getMethodId(), http::Method::Post);
+
+  request.setMethod("PURGE");
+  EXPECT_EQ(request.getMethodId(), http::Method::Count);
+  request.parseRequest("DELETE /users/1 HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(request.getMethodId(), http::Method::Delete);
+  EXPECT_EQ(http::Request().getMethodId(), http::Method::Count);
+}
+
+TEST(RequestTest, ParsesQueryAndInputOnceAndCachesThem) {
+  http::Request request("POST", "/search?q=a+b&tag=x&tag=y", "HTTP/1.1",
+                        "name=J%C3%BCrgen&age=30", {});
+
+  const http::Parameters &query = request.getQuery();
+  EXPECT_EQ(&query, &request.getQuery());
+  EXPECT_EQ(query.get("q"), "a b");
+  EXPECT_EQ(query.getAll("tag"), (std::vector<std::string_view>{"x", "y"}));
+  EXPECT_EQ(request.getQueryParameter("tag"), "y");
+  EXPECT_EQ(request.getInput().get("name"), "J\xC3\xBCrgen");
+  EXPECT_EQ(request.getInputParameter("age"), "30");
+}
+
+TEST(RequestTest, ChangingUriOrBodyRefreshesParameters) {
+  http::Request request("POST", "/search?q=old", "HTTP/1.1", "a=1", {});
+  EXPECT_EQ(request.getQueryParameter("q"), "old");
+  EXPECT_EQ(request.getInputParameter("a"), "1");
+
+  request.setUri("/search?q=new");
+  request.setBody("a=2");
+  EXPECT_EQ(request.getQueryParameter("q"), "new");
+  EXPECT_EQ(request.getInputParameter("a"), "2");
+
+  request.parseRequest("GET /plain HTTP/1.1\r\n\r\n");
+  EXPECT_TRUE(request.getQuery().empty());
+  EXPECT_TRUE(request.getInput().empty());
+}
+
 TEST(RequestTest, ParseRequest) {
   std::string rawRequest =
       "GET /index.html HTTP/1.1\r\n"
@@ -96,7 +141,54 @@ TEST(RequestTest, ParseRequest) {
   EXPECT_EQ(request.getVersion(), "HTTP/1.1");
   EXPECT_EQ(request.getHeader("Host"), "www.example.com");
   EXPECT_EQ(request.getHeader("Connection"), "keep-alive");
-  EXPECT_EQ(request.getBody(), "body_content\n");
+  EXPECT_EQ(request.getBody(), "body_content");
+}
+
+TEST(RequestTest, ParseRequestKeepsBinaryBodyIntact) {
+  std::string body("line1\r\nline2\n\0tail", 19);
+  std::string rawRequest =
+      "POST /upload HTTP/1.1\r\n"
+      "Content-Length: 19\r\n"
+      "\r\n" +
+      body + "next request";
+
+  http::Request request;
+  request.parseRequest(rawRequest);
+
+  EXPECT_EQ(request.getMethod(), "POST");
+  EXPECT_EQ(request.getBody(), body);
+}
+
+TEST(RequestTest, ParseRequestKeepsRepeatedHeaders) {
+  http::Request request;
+  request.parseRequest(
+      "GET / HTTP/1.1\r\nVia: 1.1 a\r\nCache-Control: no-cache\r\n"
+      "Via: 1.1 b\r\nCache-Control: max-age=0\r\n\r\n");
+
+  const http::Headers &headers = request.getHeaders();
+  ASSERT_EQ(headers.size(), 4);
+  EXPECT_EQ(headers[0].value, "1.1 a");
+  EXPECT_EQ(headers[1].value, "no-cache");
+  EXPECT_EQ(headers[2].value, "1.1 b");
+  EXPECT_EQ(headers[3].value, "max-age=0");
+  EXPECT_EQ(request.getHeader("Via"), "1.1 a");
+
+  // Parsing again replaces the headers rather than appending to them
+  request.parseRequest("GET / HTTP/1.1\r\nVia: 1.1 c\r\n\r\n");
+  ASSERT_EQ(request.getHeaders().size(), 1);
+  EXPECT_EQ(request.getHeader("Via"), "1.1 c");
+}
+
+TEST(RequestTest, HeaderLookupIgnoresCase) {
+  http::Request request;
+  request.parseRequest(
+      "GET / HTTP/1.1\r\nhost: example.com\r\nX-Trace-Id: 7\r\n\r\n");
+
+  EXPECT_EQ(request.getHeader("Host"), "example.com");
+  EXPECT_EQ(request.getHeader("x-trace-id"), "7");
+  EXPECT_EQ(request.getHeaders().get(http::Headers::Known::Host),
+            "example.com");
+  EXPECT_EQ(request.getHeaders().size(), 2);
 }
 
 TEST(RequestTest, ToString) {
@@ -114,3 +206,110 @@ TEST(RequestTest, ToString) {
             std::string::npos);
   EXPECT_NE(requestString.find("\r\nbody_content"), std::string::npos);
 }
+
+TEST(RequestTest, RouteParameters) {
+  http::Request request("GET", "/users/42/posts/7", "HTTP/1.1", "", {});
+  std::vector<std::string> names = {"userId", "postId"};
+  std::string_view uri = request.getUri();
+  request.setParameters(names, {uri.substr(7, 2), uri.substr(16, 1)});
+
+  EXPECT_TRUE(request.hasParameter("userId"));
+  EXPECT_EQ(request.getParameter("userId"), "42");
+  EXPECT_EQ(request.getParameter("postId"), "7");
+  EXPECT_FALSE(request.hasParameter("missing"));
+  EXPECT_TRUE(request.getParameter("missing").empty());
+
+  // Parameters refer to the copy's own URI
+  http::Request copy = request;
+  EXPECT_EQ(copy.getParameter("userId"), "42");
+  EXPECT_EQ(copy.getParameter("userId").data(), copy.getUri().data() + 7);
+
+  request.setUri("/other");
+  EXPECT_FALSE(request.hasParameter("userId"));
+}
+
+TEST(RequestTest, GettersReturnReferences) {
+  http::Request request("GET", "/users/42?tab=posts", "HTTP/1.1", "body", {});
+
+  EXPECT_EQ(&request.getMethod(), &request.getMethod());
+  EXPECT_EQ(&request.getBody(), &request.getBody());
+  EXPECT_EQ(request.getPathView(), "/users/42");
+  EXPECT_EQ(request.getPathView().data(), request.getUri().data());
+  EXPECT_EQ(request.getPath(), "/users/42");
+}
+
+TEST(RequestTest, SettersMoveTheirArguments) {
+  std::string body(1024, 'x');
+  const char *data = body.data();
+
+  http::Request request;
+  request.setBody(std::move(body));
+  EXPECT_EQ(request.getBody().data(), data);
+
+  std::string uri(256, '/');
+  data = uri.data();
+  http::Request constructed("GET", std::move(uri), "HTTP/1.1", "", {});
+  EXPECT_EQ(constructed.getUri().data(), data);
+}
+
+TEST(RequestTest, IsKeepAliveFollowsVersionAndConnectionHeader) {
+  EXPECT_TRUE(http::Request("GET", "/", "HTTP/1.1", "", {}).isKeepAlive());
+  EXPECT_FALSE(http::Request("GET", "/", "HTTP/1.0", "", {}).isKeepAlive());
+  EXPECT_FALSE(http::Request("GET", "/", "HTTP/1.1", "",
+                             {{"Connection", "Close"}})
+                   .isKeepAlive());
+  EXPECT_TRUE(http::Request("GET", "/", "HTTP/1.0", "",
+                            {{"Connection", "Keep-Alive"}})
+                  .isKeepAlive());
+  EXPECT_FALSE(http::Request("GET", "/", "HTTP/1.1", "",
+                             {{"connection", "upgrade, close"}})
+                   .isKeepAlive());
+  EXPECT_TRUE(http::Request("GET", "/", "HTTP/1.1", "",
+                            {{"Connection", "Upgrade"}})
+                  .isKeepAlive());
+}
+
+TEST(RequestTest, AllocatesFromItsResource) {
+  // Anything not served from the buffer would throw std::bad_alloc
+  alignas(std::max_align_t) char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  http::Request request(&arena);
+  EXPECT_EQ(request.getResource(), &arena);
+  request.setUri("/users/42/posts/7");
+  for (int i = 0; i < 20; ++i) {
+    request.setHeader("X-Field-" + std::to_string(i), "some header value");
+  }
+  std::vector<std::string> names = {"userId", "postId"};
+  std::string_view uri = request.getUri();
+  request.setParameters(names, {uri.substr(7, 2), uri.substr(16, 1)});
+  EXPECT_EQ(request.getParameter("postId"), "7");
+
+  // A copy lives outside the arena
+  http::Request copy = request;
+  EXPECT_EQ(copy.getResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(copy.getHeader("x-field-7"), "some header value");
+  EXPECT_EQ(copy.getParameter("userId"), "42");
+}
+
+TEST(RequestTest, ClearedRequestReusesItsStrings) {
+  std::pmr::monotonic_buffer_resource arena;
+  http::Request request(&arena);
+  std::string uri = "/users/42/settings?return=%2Fusers%2F42&tab=appearance";
+  std::string body(512, 'x');
+  request.assign("POST", uri, "HTTP/1.1", body);
+  request.setHeader("Content-Type", "application/x-www-form-urlencoded");
+  const char *uriData = request.getUri().data();
+  const char *bodyData = request.getBody().data();
+
+  request.clear();
+  EXPECT_EQ(request.getUri(), "");
+  EXPECT_EQ(request.getHeaders().size(), 0);
+  EXPECT_EQ(request.getResource(), &arena);
+
+  request.assign("GET", uri.substr(0, 20), "HTTP/1.1", body);
+  EXPECT_EQ(request.getMethodId(), http::Method::Get);
+  EXPECT_EQ(request.getUri(), uri.substr(0, 20));
+  EXPECT_EQ(request.getUri().data(), uriData);
+  EXPECT_EQ(request.getBody().data(), bodyData);
+}
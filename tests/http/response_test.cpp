@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <memory_resource>
+
 TEST(ResponseTest, DefaultConstructor) {
   http::Response response;
   EXPECT_EQ(response.getStatusCode(), 200);
@@ -10,6 +13,22 @@ TEST(ResponseTest, DefaultConstructor) {
   EXPECT_TRUE(response.getHeaders().empty());
 }
 
+TEST(ResponseTest, ResourceConstructor) {
+  alignas(std::max_align_t) char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  http::Response response(&arena);
+  response.setHeader("Content-Type", "application/json");
+  response.setHeader("Cache-Control", "no-store");
+  EXPECT_EQ(response.getResource(), &arena);
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getHeader("content-type"), "application/json");
+
+  http::Response copy = response;
+  EXPECT_EQ(copy.getResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(copy.getHeader("Cache-Control"), "no-store");
+}
+
 TEST(ResponseTest, ParameterizedConstructor) {
   std::map<std::string, std::string> headers = {
       {"Content-Type", "application/json"}, {"Connection", "keep-alive"}};
@@ -53,6 +72,25 @@ TEST(ResponseTest, ParseResponse) {
   EXPECT_EQ(response.getBody(), "body_content\n");
 }
 
+TEST(ResponseTest, ParseResponseKeepsRepeatedHeaders) {
+  http::Response response;
+  response.parseResponse(
+      "HTTP/1.1 200 OK\r\nSet-Cookie: session=abc; HttpOnly\r\n"
+      "Content-Type: text/html\r\nSet-Cookie: theme=dark\r\n\r\n");
+
+  const http::Headers &headers = response.getHeaders();
+  ASSERT_EQ(headers.size(), 3);
+  EXPECT_EQ(headers[0].name, "Set-Cookie");
+  EXPECT_EQ(headers[0].value, "session=abc; HttpOnly");
+  EXPECT_EQ(headers[2].name, "Set-Cookie");
+  EXPECT_EQ(headers[2].value, "theme=dark");
+
+  // Parsing again replaces the headers rather than appending to them
+  response.parseResponse("HTTP/1.1 204 No Content\r\nSet-Cookie: a=1\r\n\r\n");
+  ASSERT_EQ(response.getHeaders().size(), 1);
+  EXPECT_EQ(response.getHeader("Set-Cookie"), "a=1");
+}
+
 TEST(ResponseTest, ToString) {
   std::map<std::string, std::string> headers = {
       {"Content-Type", "application/json"}, {"Connection", "keep-alive"}};
@@ -72,3 +110,71 @@ TEST(ResponseTest, ToString) {
   // Check body
   EXPECT_NE(responseString.find("\r\nresponse_body"), std::string::npos);
 }
+
+TEST(ResponseTest, ParseResponseWithLargeHeaderBlock) {
+  std::string cookie(3000, 'c');
+  std::string rawResponse =
+      "HTTP/1.1 200 OK\r\n"
+      "Set-Cookie: session=" +
+      cookie +
+      "\r\n"
+      "Content-Type: text/plain\r\n"
+      "\r\n"
+      "line one\nline two";
+
+  http::Response response;
+  response.parseResponse(rawResponse);
+
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getStatusMessage(), "OK");
+  EXPECT_EQ(response.getHeader("Set-Cookie"), "session=" + cookie);
+  EXPECT_EQ(response.getHeader("Content-Type"), "text/plain");
+  EXPECT_EQ(response.getBody(), "line one\nline two\n");
+}
+
+TEST(ResponseTest, SettersMoveTheirArguments) {
+  std::string body(1024, 'x');
+  const char *data = body.data();
+
+  http::Response response;
+  response.setBody(std::move(body));
+  EXPECT_EQ(response.getBody().data(), data);
+  EXPECT_EQ(&response.getBody(), &response.getBody());
+
+  std::string payload(1024, 'y');
+  data = payload.data();
+  http::Response constructed(200, "OK", std::move(payload), {});
+  EXPECT_EQ(constructed.getBody().data(), data);
+}
+
+TEST(ResponseTest, SerializeHeadKeepsInsertionOrder) {
+  http::Response response(201, "Created", "ignored",
+                          {{"Location", "/users/7"}, {"Content-Type", "a/b"}});
+
+  std::string head;
+  response.serializeHead(head);
+  EXPECT_EQ(head,
+            "HTTP/1.1 201 Created\r\n"
+            "Location: /users/7\r\n"
+            "Content-Type: a/b\r\n"
+            "\r\n");
+
+  response.serializeHead(head, true);
+  EXPECT_EQ(head,
+            "HTTP/1.1 201 Created\r\n"
+            "Content-Type: a/b\r\n"
+            "Location: /users/7\r\n"
+            "\r\n");
+  EXPECT_EQ(response.toString(), head + "ignored");
+}
+
+TEST(ResponseTest, SerializeHeadReusesTheBuffer) {
+  http::Response response(200, "OK", "", {{"Connection", "close"}});
+
+  std::string head(256, 'x');
+  head.clear();
+  const char *data = head.data();
+  response.serializeHead(head);
+  EXPECT_EQ(head, "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n");
+  EXPECT_EQ(head.data(), data);
+}
@@ -0,0 +1,47 @@
+#include "scan.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+using namespace http;
+
+TEST(ScanTest, FindsFirstOccurrence) {
+  std::string text = "Host: example.com\r\nAccept: */*\r\n\r\n";
+  EXPECT_EQ(scan::find(text, ':'), 4);
+  EXPECT_EQ(scan::findLineEnd(text), 18);
+  EXPECT_EQ(scan::findLineEnd(text, 19), 31);
+  EXPECT_EQ(scan::find(text, '#'), std::string_view::npos);
+  EXPECT_EQ(scan::find(text, ':', text.size()), std::string_view::npos);
+  EXPECT_EQ(scan::find("", '\n'), std::string_view::npos);
+}
+
+TEST(ScanTest, AgreesWithFindAtEveryOffsetAndLength) {
+  // Cover positions before, inside and after each vector-sized block
+  for (std::size_t size = 0; size < 100; ++size) {
+    for (std::size_t target = 0; target <= size; ++target) {
+      std::string text(size, 'a');
+      if (target < size) {
+        text[target] = '\n';
+      }
+      for (std::size_t from = 0; from <= size; from += 7) {
+        std::size_t expected = std::string_view(text).find('\n', from);
+        EXPECT_EQ(scan::find(text, '\n', from), expected)
+            << "size=" << size << " target=" << target << " from=" << from;
+      }
+    }
+  }
+}
+
+TEST(ScanTest, DoesNotReadPastTheView) {
+  std::string text = "abcdefghijklmnopqrstuvwxyzabcdefghij\n";
+  std::string_view prefix(text.data(), text.size() - 1);
+  EXPECT_EQ(scan::find(prefix, '\n'), std::string_view::npos);
+}
+
+TEST(ScanTest, MatchesHighBytes) {
+  std::string text(40, 'x');
+  text[33] = '\xff';
+  EXPECT_EQ(scan::find(text, '\xff'), 33);
+}
@@ -0,0 +1,165 @@
+#include "static.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <string>
+
+#include "temporary_directory.hpp"
+
+using namespace http;
+
+class StaticFilesTest : public ::testing::Test {
+ protected:
+  TemporaryDirectory temporary{"ember-static"};
+  const std::string &directory = temporary.getPath();
+  std::unique_ptr<StaticFiles> files;
+
+  void SetUp() override {
+    ASSERT_EQ(mkdir((directory + "/css").c_str(), 0755), 0);
+    std::ofstream(directory + "/index.html") << "<h1>Hello</h1>";
+    std::ofstream(directory + "/css/site.css") << "body { color: red; }";
+    std::ofstream(directory + "/my file.txt") << "0123456789";
+    files = std::make_unique<StaticFiles>(directory);
+  }
+
+  static Request get(const std::map<std::string, std::string> &headers = {}) {
+    return Request("GET", "/", "HTTP/1.1", "", headers);
+  }
+};
+
+TEST_F(StaticFilesTest, ServesFileAsSendfileBody) {
+  Response response = files->serve(get(), "css/site.css");
+
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getHeader("Content-Type"), "text/css; charset=utf-8");
+  EXPECT_EQ(response.getHeader("Accept-Ranges"), "bytes");
+  EXPECT_FALSE(response.getHeader("ETag").empty());
+  EXPECT_FALSE(response.getHeader("Last-Modified").empty());
+  ASSERT_NE(response.getFile(), nullptr);
+  EXPECT_TRUE(response.getBody().empty());
+  EXPECT_EQ(response.getFileOffset(), 0);
+  EXPECT_EQ(response.getContentLength(), 20);
+  EXPECT_NE(response.toString().find("\r\n\r\nbody { color: red; }"),
+            std::string::npos);
+}
+
+TEST_F(StaticFilesTest, AnswersHeadWithoutBody) {
+  Request head("HEAD", "/", "HTTP/1.1", "", {});
+  Response response = files->serve(head, "css/site.css");
+
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getHeader("Content-Type"), "text/css; charset=utf-8");
+  EXPECT_FALSE(response.getHeader("ETag").empty());
+  EXPECT_EQ(response.getHeader("Content-Length"), "20");
+  EXPECT_EQ(response.getFile(), nullptr);
+  EXPECT_EQ(response.getContentLength(), 0);
+
+  Request range("HEAD", "/", "HTTP/1.1", "", {{"Range", "bytes=2-5"}});
+  response = files->serve(range, "css/site.css");
+  EXPECT_EQ(response.getStatusCode(), 206);
+  EXPECT_EQ(response.getHeader("Content-Range"), "bytes 2-5/20");
+  EXPECT_EQ(response.getHeader("Content-Length"), "4");
+  EXPECT_EQ(response.getFile(), nullptr);
+}
+
+TEST_F(StaticFilesTest, DecodesPathAndIgnoresQuery) {
+  Response response = files->serve(get(), "my%20file.txt?v=3");
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getContentLength(), 10);
+}
+
+TEST_F(StaticFilesTest, RejectsMissingFilesAndTraversal) {
+  for (const char *path :
+       {"missing.txt", "css", "../etc/passwd", "css/../index.html",
+        "%2e%2e/etc/passwd", "css//site.css", "bad%zz", "nul%00.txt"}) {
+    EXPECT_EQ(files->serve(get(), path).getStatusCode(), 404) << path;
+  }
+}
+
+TEST_F(StaticFilesTest, AnswersConditionalRequests) {
+  Response full = files->serve(get(), "index.html");
+  std::string etag = full.getHeader("ETag");
+  std::string lastModified = full.getHeader("Last-Modified");
+
+  Response cached = files->serve(get({{"If-None-Match", etag}}), "index.html");
+  EXPECT_EQ(cached.getStatusCode(), 304);
+  EXPECT_EQ(cached.getFile(), nullptr);
+  EXPECT_EQ(cached.getHeader("ETag"), etag);
+
+  EXPECT_EQ(files->serve(get({{"If-None-Match", "\"a\", W/" + etag}}),
+                         "index.html")
+                .getStatusCode(),
+            304);
+  EXPECT_EQ(
+      files->serve(get({{"If-None-Match", "\"other\""}}), "index.html")
+          .getStatusCode(),
+      200);
+  EXPECT_EQ(files->serve(get({{"If-Modified-Since", lastModified}}),
+                         "index.html")
+                .getStatusCode(),
+            304);
+  EXPECT_EQ(files->serve(get({{"If-Modified-Since",
+                               "Thu, 01 Jan 1970 00:00:00 GMT"}}),
+                         "index.html")
+                .getStatusCode(),
+            200);
+}
+
+TEST_F(StaticFilesTest, AnswersRangeRequests) {
+  Response partial =
+      files->serve(get({{"Range", "bytes=2-5"}}), "my file.txt");
+  EXPECT_EQ(partial.getStatusCode(), 206);
+  EXPECT_EQ(partial.getHeader("Content-Range"), "bytes 2-5/10");
+  EXPECT_EQ(partial.getFileOffset(), 2);
+  EXPECT_EQ(partial.getFileLength(), 4);
+  EXPECT_NE(partial.toString().find("\r\n\r\n2345"), std::string::npos);
+
+  Response suffix = files->serve(get({{"Range", "bytes=-3"}}), "my file.txt");
+  EXPECT_EQ(suffix.getHeader("Content-Range"), "bytes 7-9/10");
+
+  Response open = files->serve(get({{"Range", "bytes=8-"}}), "my file.txt");
+  EXPECT_EQ(open.getHeader("Content-Range"), "bytes 8-9/10");
+
+  Response clamped =
+      files->serve(get({{"Range", "bytes=5-100"}}), "my file.txt");
+  EXPECT_EQ(clamped.getHeader("Content-Range"), "bytes 5-9/10");
+
+  Response unsatisfiable =
+      files->serve(get({{"Range", "bytes=10-"}}), "my file.txt");
+  EXPECT_EQ(unsatisfiable.getStatusCode(), 416);
+  EXPECT_EQ(unsatisfiable.getHeader("Content-Range"), "bytes */10");
+
+  // Multiple and malformed ranges fall back to the whole file
+  EXPECT_EQ(files->serve(get({{"Range", "bytes=0-1,4-5"}}), "my file.txt")
+                .getStatusCode(),
+            200);
+  EXPECT_EQ(files->serve(get({{"Range", "lines=1-2"}}), "my file.txt")
+                .getStatusCode(),
+            200);
+
+  // A stale If-Range validator also serves the whole file
+  EXPECT_EQ(files->serve(get({{"Range", "bytes=0-1"}, {"If-Range", "\"x\""}}),
+                         "my file.txt")
+                .getStatusCode(),
+            200);
+}
+
+TEST_F(StaticFilesTest, SharesCacheBetweenCopies) {
+  StaticFiles copy = *files;
+  files->serve(get(), "index.html");
+  copy.serve(get(), "index.html");
+  EXPECT_EQ(files->getCache().getHits(), 1);
+  EXPECT_EQ(files->getCache().getMisses(), 1);
+}
+
+TEST(StaticFilesContentTypeTest, GuessesFromExtension) {
+  EXPECT_EQ(StaticFiles::contentType("a/b/app.JS"),
+            "text/javascript; charset=utf-8");
+  EXPECT_EQ(StaticFiles::contentType("logo.png"), "image/png");
+  EXPECT_EQ(StaticFiles::contentType("v1.2/README"),
+            "application/octet-stream");
+  EXPECT_EQ(StaticFiles::contentType("archive.unknown"),
+            "application/octet-stream");
+}
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "request.hpp"
 #include "response.hpp"
 
@@ -12,7 +14,7 @@ class CollectionTest : public ::testing::Test {
  protected:
   Collection collection;
 
-  static Response sampleHandler(const Request &request) {
+  static Response sampleHandler(const Request &) {
     return Response(200, "OK", "Sample response",
                     {{"Content-Type", "text/plain"}});
   }
@@ -66,6 +68,25 @@ TEST_F(CollectionTest, HandleRequestWithPathParameters) {
   EXPECT_EQ(response.getStatusMessage(), "OK");
 }
 
+TEST_F(CollectionTest, NestedCollectionKeepsOuterParameters) {
+  Collection inner;
+  inner.addRoute("GET", "/posts/:post", [](const Request &request) {
+    return Response(200, "OK", std::string(request.getParameter("post")),
+                    {{"Content-Type", "text/plain"}});
+  });
+  collection.addRoute("GET", "/users/:user", [&inner](const Request &request) {
+    Request nested("GET", "/posts/9", "HTTP/1.1", "", {});
+    Response response = inner.handleRequest(nested);
+    return Response(200, "OK",
+                    std::string(request.getParameter("user")) + "/" +
+                        response.getBody(),
+                    {{"Content-Type", "text/plain"}});
+  });
+
+  Request request("GET", "/users/7", "HTTP/1.1", "", {});
+  EXPECT_EQ(collection.handleRequest(request).getBody(), "7/9");
+}
+
 TEST_F(CollectionTest, HandleRequestWithQueryParameters) {
   Request request("GET", "/sample?query=test", "HTTP/1.1", "", {});
   auto response = collection.handleRequest(request);
@@ -89,3 +110,16 @@ TEST_F(CollectionTest, RemoveRoute) {
   EXPECT_EQ(response.getStatusCode(), 404);
   EXPECT_EQ(response.getStatusMessage(), "Not Found");
 }
+
+TEST_F(CollectionTest, RemoveRouteKeepsOtherRoutes) {
+  collection.addRoute("GET", "/other", [](const Request &) {
+    return Response(200, "OK", "Other response",
+                    {{"Content-Type", "text/plain"}});
+  });
+  collection.removeRoute("GET", "/sample");
+
+  Request request("GET", "/other", "HTTP/1.1", "", {});
+  auto response = collection.handleRequest(request);
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getBody(), "Other response");
+}
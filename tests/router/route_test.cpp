@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <stdexcept>
+#include <string>
+
 #include "request.hpp"
 #include "response.hpp"
 
@@ -10,7 +14,7 @@ using namespace router;
 
 class RouteTest : public ::testing::Test {
  protected:
-  static Response sampleHandler(const Request &request) {
+  static Response sampleHandler(const Request &) {
     return Response(200, "OK", "Sample response",
                     {{"Content-Type", "text/plain"}});
   }
@@ -68,3 +72,96 @@ TEST_F(RouteTest, InvalidMethod) {
   EXPECT_EQ(response.getStatusCode(), 405);
   EXPECT_EQ(response.getStatusMessage(), "Method Not Allowed");
 }
+
+TEST_F(RouteTest, InvalidMethodNamesAllowedMethod) {
+  Request request("delete", "/sample", "HTTP/1.1", "", {});
+  auto response = route.handle(request);
+  EXPECT_EQ(response.getStatusCode(), 405);
+  EXPECT_EQ(response.getHeader("Allow"), "GET");
+}
+
+TEST_F(RouteTest, RejectsUnsupportedMethod) {
+  EXPECT_THROW(Route("PURGE", "/cache", sampleHandler), std::runtime_error);
+  EXPECT_EQ(Route("patch", "/sample", sampleHandler).getMethodId(),
+            Method::Patch);
+}
+
+TEST_F(RouteTest, MatchesPathWithoutQueryString) {
+  EXPECT_TRUE(route.matches(Request("GET", "/sample?x=1", "HTTP/1.1", "", {})));
+  EXPECT_TRUE(
+      route.matches(Request("get", "/sample/?x=1&y=2", "HTTP/1.1", "", {})));
+  EXPECT_FALSE(
+      route.matches(Request("GET", "/samples?x=1", "HTTP/1.1", "", {})));
+}
+
+TEST_F(RouteTest, MatchesStaticPath) {
+  EXPECT_TRUE(route.matches(Request("GET", "/sample", "HTTP/1.1", "", {})));
+  EXPECT_TRUE(route.matches(Request("GET", "/sample/", "HTTP/1.1", "", {})));
+  EXPECT_FALSE(route.matches(Request("GET", "/samples", "HTTP/1.1", "", {})));
+  EXPECT_FALSE(
+      route.matches(Request("GET", "/sample/extra", "HTTP/1.1", "", {})));
+  EXPECT_FALSE(route.matches(Request("POST", "/sample", "HTTP/1.1", "", {})));
+}
+
+TEST_F(RouteTest, MatchesRootPath) {
+  Route rootRoute("GET", "/", sampleHandler);
+  EXPECT_TRUE(rootRoute.matchPath("/"));
+  EXPECT_FALSE(rootRoute.matchPath("/sample"));
+  EXPECT_FALSE(rootRoute.matchPath(""));
+}
+
+TEST_F(RouteTest, MatchCapturesPathParameters) {
+  Route paramRoute("GET", "/users/:userId/posts/:postId", sampleHandler);
+  std::vector<std::string_view> captures;
+
+  EXPECT_TRUE(paramRoute.matchPath("/users/42/posts/7", &captures));
+  ASSERT_EQ(captures.size(), 2);
+  EXPECT_EQ(captures[0], "42");
+  EXPECT_EQ(captures[1], "7");
+
+  EXPECT_FALSE(paramRoute.matchPath("/users/42/posts", &captures));
+  EXPECT_FALSE(paramRoute.matchPath("/users//posts/7", &captures));
+
+  ASSERT_EQ(paramRoute.getParameterNames().size(), 2);
+  EXPECT_EQ(paramRoute.getParameterNames()[0], "userId");
+  EXPECT_EQ(paramRoute.getParameterNames()[1], "postId");
+}
+
+TEST_F(RouteTest, LiteralSegmentsAreNotPatterns) {
+  Route dotRoute("GET", "/files/index.html", sampleHandler);
+  EXPECT_TRUE(dotRoute.matchPath("/files/index.html"));
+  EXPECT_FALSE(dotRoute.matchPath("/files/indexXhtml"));
+}
+
+TEST_F(RouteTest, WildcardCapturesRestOfPath) {
+  Route wildcardRoute("GET", "/assets/*path", sampleHandler);
+  std::vector<std::string_view> captures;
+
+  EXPECT_TRUE(wildcardRoute.matchPath("/assets/css/site.css", &captures));
+  ASSERT_EQ(captures.size(), 1);
+  EXPECT_EQ(captures[0], "css/site.css");
+
+  EXPECT_TRUE(wildcardRoute.matchPath("/assets/logo.png/", &captures));
+  EXPECT_EQ(captures[0], "logo.png");
+
+  EXPECT_FALSE(wildcardRoute.matchPath("/assets", &captures));
+  EXPECT_FALSE(wildcardRoute.matchPath("/assets/", &captures));
+  EXPECT_FALSE(wildcardRoute.matchPath("/other/logo.png", &captures));
+
+  ASSERT_EQ(wildcardRoute.getParameterNames().size(), 1);
+  EXPECT_EQ(wildcardRoute.getParameterNames()[0], "path");
+}
+
+TEST_F(RouteTest, WildcardMustBeLastSegment) {
+  EXPECT_THROW(Route("GET", "/assets/*path/edit", sampleHandler),
+               std::runtime_error);
+}
+
+TEST_F(RouteTest, AcceptsMoveOnlyHandlers) {
+  auto body = std::make_unique<std::string>("Owned");
+  Route route("GET", "/owned", [body = std::move(body)](const Request &) {
+    return Response(200, "OK", *body, {});
+  });
+  Request request("GET", "/owned", "HTTP/1.1", "", {});
+  EXPECT_EQ(route.handle(request).getBody(), "Owned");
+}
@@ -10,12 +10,12 @@ using namespace router;
 
 class RouterTest : public ::testing::Test {
  protected:
-  static Response sampleHandler(const Request &request) {
+  static Response sampleHandler(const Request &) {
     return Response(200, "OK", "GET response",
                     {{"Content-Type", "text/plain"}});
   }
 
-  static Response postHandler(const Request &request) {
+  static Response postHandler(const Request &) {
     return Response(200, "OK", "POST response",
                     {{"Content-Type", "text/plain"}});
   }
@@ -89,6 +89,31 @@ TEST_F(RouterTest, CaseInsensitiveMethod) {
   EXPECT_EQ(response.getBody(), "GET response");
 }
 
+TEST_F(RouterTest, MatchesPathWithoutQueryString) {
+  router.addRoute("GET", "/users/:id", sampleHandler);
+  Request request("GET", "/users/42?fields=name&sort=asc", "HTTP/1.1", "", {});
+  auto response = router.handle(request);
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(request.getParameter("id"), "42");
+}
+
+TEST_F(RouterTest, AnswersMethodNotAllowedWithAllowHeader) {
+  router.addRoute("GET", "/sample", sampleHandler);
+  router.addRoute("POST", "/sample", postHandler);
+  Request request("DELETE", "/sample?x=1", "HTTP/1.1", "", {});
+  auto response = router.handle(request);
+  EXPECT_EQ(response.getStatusCode(), 405);
+  EXPECT_EQ(response.getStatusMessage(), "Method Not Allowed");
+  EXPECT_EQ(response.getHeader("Allow"), "GET, POST");
+
+  // Unknown methods are not allowed either
+  Request purge("PURGE", "/sample", "HTTP/1.1", "", {});
+  EXPECT_EQ(router.handle(purge).getStatusCode(), 405);
+
+  Request missing("DELETE", "/other", "HTTP/1.1", "", {});
+  EXPECT_EQ(router.handle(missing).getStatusCode(), 404);
+}
+
 TEST_F(RouterTest, TrailingSlash) {
   router.addRoute("GET", "/sample", sampleHandler);
   Request request("GET", "/sample/", "HTTP/1.1", "", {});
@@ -97,3 +122,20 @@ TEST_F(RouterTest, TrailingSlash) {
   EXPECT_EQ(response.getStatusMessage(), "OK");
   EXPECT_EQ(response.getBody(), "GET response");
 }
+
+TEST_F(RouterTest, HandlerReceivesRouteParameters) {
+  router.addRoute("GET", "/users/:userId/posts/:postId",
+                  [](const Request &request) {
+                    std::string body(request.getParameter("userId"));
+                    body += ":";
+                    body += request.getParameter("postId");
+                    return Response(200, "OK", body,
+                                    {{"Content-Type", "text/plain"}});
+                  });
+
+  Request request("GET", "/users/42/posts/7", "HTTP/1.1", "", {});
+  auto response = router.handle(request);
+  EXPECT_EQ(response.getStatusCode(), 200);
+  EXPECT_EQ(response.getBody(), "42:7");
+  EXPECT_EQ(request.getParameter("userId").data(), request.getUri().data() + 7);
+}
@@ -0,0 +1,148 @@
+#include "tree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace router;
+
+class TreeTest : public ::testing::Test {
+ protected:
+  Tree tree;
+
+  void SetUp() override {
+    tree.insert("GET", "/", 0);
+    tree.insert("GET", "/users", 1);
+    tree.insert("POST", "/users", 2);
+    tree.insert("GET", "/users/:userId", 3);
+    tree.insert("GET", "/users/:userId/posts/:postId", 4);
+    tree.insert("GET", "/users/me", 5);
+    tree.insert("GET", "/api/v1/status", 6);
+    tree.insert("GET", "/api/v1/health", 7);
+  }
+};
+
+TEST_F(TreeTest, FindStaticRoutes) {
+  EXPECT_EQ(tree.find("GET", "/"), 0);
+  EXPECT_EQ(tree.find("GET", "/users"), 1);
+  EXPECT_EQ(tree.find("POST", "/users"), 2);
+  EXPECT_EQ(tree.find("GET", "/api/v1/status"), 6);
+  EXPECT_EQ(tree.find("GET", "/api/v1/health"), 7);
+}
+
+TEST_F(TreeTest, FindMissingRoutes) {
+  EXPECT_EQ(tree.find("GET", "/unknown"), Tree::npos);
+  EXPECT_EQ(tree.find("GET", "/api/v1"), Tree::npos);
+  EXPECT_EQ(tree.find("GET", "/api/v1/status/extra"), Tree::npos);
+  EXPECT_EQ(tree.find("DELETE", "/users"), Tree::npos);
+  EXPECT_EQ(tree.find("GET", ""), Tree::npos);
+}
+
+TEST_F(TreeTest, FindCapturesParameters) {
+  std::vector<std::string_view> captures;
+  EXPECT_EQ(tree.find("GET", "/users/42/posts/7", &captures), 4);
+  ASSERT_EQ(captures.size(), 2);
+  EXPECT_EQ(captures[0], "42");
+  EXPECT_EQ(captures[1], "7");
+
+  EXPECT_EQ(tree.find("GET", "/users/42", &captures), 3);
+  ASSERT_EQ(captures.size(), 1);
+  EXPECT_EQ(captures[0], "42");
+}
+
+TEST_F(TreeTest, StaticSegmentsTakePrecedence) {
+  std::vector<std::string_view> captures;
+  EXPECT_EQ(tree.find("GET", "/users/me", &captures), 5);
+  EXPECT_TRUE(captures.empty());
+}
+
+TEST_F(TreeTest, BacktracksFromStaticToParameter) {
+  std::vector<std::string_view> captures;
+  EXPECT_EQ(tree.find("GET", "/users/me/posts/1", &captures), 4);
+  ASSERT_EQ(captures.size(), 2);
+  EXPECT_EQ(captures[0], "me");
+  EXPECT_EQ(captures[1], "1");
+}
+
+TEST_F(TreeTest, TrailingSlashAndCaseInsensitiveMethod) {
+  EXPECT_EQ(tree.find("get", "/users/"), 1);
+  EXPECT_EQ(tree.find("GET", "/api/v1/status/"), 6);
+  EXPECT_EQ(tree.find("GET", "/users//"), Tree::npos);
+}
+
+TEST_F(TreeTest, SplitsCompressedEdges) {
+  tree.insert("GET", "/api/v2/status", 8);
+  tree.insert("GET", "/api", 9);
+
+  EXPECT_EQ(tree.find("GET", "/api/v1/status"), 6);
+  EXPECT_EQ(tree.find("GET", "/api/v2/status"), 8);
+  EXPECT_EQ(tree.find("GET", "/api"), 9);
+  EXPECT_EQ(tree.find("GET", "/api/v2"), Tree::npos);
+}
+
+TEST_F(TreeTest, ReportsMethodsAllowedForPath) {
+  tree.insert("DELETE", "/users/:userId", 8);
+
+  http::MethodSet allowed = 0;
+  EXPECT_EQ(tree.find(http::Method::Put, "/users", nullptr, &allowed),
+            Tree::npos);
+  EXPECT_EQ(allowed,
+            http::methodBit(http::Method::Get) |
+                http::methodBit(http::Method::Post));
+
+  // Every pattern matching the path contributes, static or not
+  allowed = 0;
+  EXPECT_EQ(tree.find(http::Method::Post, "/users/me", nullptr, &allowed),
+            Tree::npos);
+  EXPECT_EQ(allowed,
+            http::methodBit(http::Method::Get) |
+                http::methodBit(http::Method::Delete));
+
+  allowed = 0;
+  EXPECT_EQ(tree.find(http::Method::Get, "/missing", nullptr, &allowed),
+            Tree::npos);
+  EXPECT_EQ(allowed, 0);
+}
+
+TEST_F(TreeTest, RejectsUnsupportedMethods) {
+  EXPECT_THROW(tree.insert("PURGE", "/cache", 8), std::runtime_error);
+  EXPECT_EQ(tree.find("PURGE", "/users"), Tree::npos);
+}
+
+TEST_F(TreeTest, FirstRegisteredRouteWins) {
+  tree.insert("GET", "/users", 10);
+  EXPECT_EQ(tree.find("GET", "/users"), 1);
+}
+
+TEST_F(TreeTest, Clear) {
+  tree.clear();
+  EXPECT_EQ(tree.find("GET", "/"), Tree::npos);
+  EXPECT_EQ(tree.find("GET", "/users"), Tree::npos);
+}
+
+TEST(TreeWildcardTest, FindCapturesRestOfPath) {
+  Tree tree;
+  tree.insert("GET", "/assets/*path", 0);
+  tree.insert("GET", "/assets/manifest.json", 1);
+  tree.insert("GET", "/files/:bucket/*path", 2);
+
+  std::vector<std::string_view> captures;
+  EXPECT_EQ(tree.find("GET", "/assets/css/site.css", &captures), 0);
+  ASSERT_EQ(captures.size(), 1);
+  EXPECT_EQ(captures[0], "css/site.css");
+
+  // Static routes win over the wildcard
+  EXPECT_EQ(tree.find("GET", "/assets/manifest.json", &captures), 1);
+  EXPECT_TRUE(captures.empty());
+  EXPECT_EQ(tree.find("GET", "/assets/manifest.json/x", &captures), 0);
+  EXPECT_EQ(captures[0], "manifest.json/x");
+
+  EXPECT_EQ(tree.find("GET", "/files/public/a/b.txt", &captures), 2);
+  ASSERT_EQ(captures.size(), 2);
+  EXPECT_EQ(captures[0], "public");
+  EXPECT_EQ(captures[1], "a/b.txt");
+
+  EXPECT_EQ(tree.find("GET", "/assets", &captures), Tree::npos);
+  EXPECT_EQ(tree.find("GET", "/assets/", &captures), Tree::npos);
+  EXPECT_EQ(tree.find("POST", "/assets/a.css", &captures), Tree::npos);
+}
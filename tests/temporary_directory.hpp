@@ -0,0 +1,55 @@
+#ifndef TEMPORARY_DIRECTORY_HPP
+#define TEMPORARY_DIRECTORY_HPP
+
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+/**
+ * @class TemporaryDirectory
+ * @brief A fresh, uniquely named directory for a test, removed together with
+ * everything in it when the object is destroyed.
+ */
+class TemporaryDirectory {
+ public:
+  /**
+   * @brief Creates the directory in the system's temporary directory.
+   *
+   * @param prefix The start of the directory name, to tell tests apart.
+   * @throws std::runtime_error if the directory cannot be created.
+   */
+  explicit TemporaryDirectory(const std::string &prefix = "ember") {
+    std::string pattern =
+        (std::filesystem::temp_directory_path() / (prefix + "-XXXXXX"))
+            .string();
+    if (!mkdtemp(pattern.data())) {
+      throw std::runtime_error("Cannot create a temporary directory");
+    }
+    path = pattern;
+  }
+
+  /**
+   * @brief Removes the directory and its contents, ignoring errors.
+   */
+  ~TemporaryDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(path, error);
+  }
+
+  TemporaryDirectory(const TemporaryDirectory &) = delete;
+  TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+  /**
+   * @brief Gets the path of the directory.
+   *
+   * @return The absolute path, without a trailing slash.
+   */
+  const std::string &getPath() const { return path; }
+
+ private:
+  std::string path;  ///< The directory; never empty once constructed.
+};
+
+#endif  // TEMPORARY_DIRECTORY_HPP